@@ -0,0 +1,180 @@
+#include "harness.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+
+namespace bench
+{
+std::vector<benchmark>& registry()
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+std::mt19937& rng()
+{
+    static std::mt19937 engine{0x4b4c4e};
+    return engine;
+}
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    // Repeatedly invokes the kernel with argument n until at least min_time_s
+    // has elapsed, doubling the repetition count between timed attempts.
+    // Returns the elapsed time and the number of repetitions.
+    std::pair<double, size_t> time_kernel(kernel const& k,
+                                          size_t n,
+                                          double min_time_s)
+    {
+        // Warm up caches and branch predictors
+        k(n);
+
+        size_t reps = 1;
+        while (true)
+        {
+            auto start = clock::now();
+            for (size_t i = 0; i != reps; ++i)
+            {
+                k(n);
+            }
+            double elapsed
+                = std::chrono::duration<double>(clock::now() - start).count();
+            if (elapsed >= min_time_s || reps >= (size_t{1} << 40))
+            {
+                return {elapsed, reps};
+            }
+            // Aim slightly past the minimum to avoid another round
+            double scale = elapsed > 0.0 ? 1.4 * min_time_s / elapsed : 16.0;
+            scale        = std::min(std::max(scale, 2.0), 16.0);
+            reps = static_cast<size_t>(static_cast<double>(reps) * scale);
+        }
+    }
+
+    char const* mode_name(mode m)
+    {
+        return m == mode::throughput ? "throughput" : "latency";
+    }
+
+    // JSON has no representation for infinities or NaN, so non-finite
+    // measurements are written as null
+    struct json_number
+    {
+        double value;
+    };
+
+    std::ostream& operator<<(std::ostream& os, json_number n)
+    {
+        if (!std::isfinite(n.value))
+        {
+            return os << "null";
+        }
+        return os << n.value;
+    }
+} // namespace
+
+std::vector<result> run(options const& opts)
+{
+    std::vector<result> results;
+    for (benchmark const& b : registry())
+    {
+        std::string full = b.group + "/" + b.name;
+        if (!opts.filter.empty() && full.find(opts.filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        if (b.kind == mode::latency)
+        {
+            kernel k = b.setup(1);
+            auto t   = time_kernel(k, opts.latency_chain, opts.min_time_s);
+            double items = static_cast<double>(t.second)
+                           * static_cast<double>(opts.latency_chain);
+            results.push_back({b.name,
+                               b.group,
+                               b.kind,
+                               1,
+                               t.second,
+                               t.first * 1e9 / items,
+                               items / t.first});
+            continue;
+        }
+
+        for (size_t n : opts.batches)
+        {
+            if (n * b.bytes_per_item > opts.max_bytes)
+            {
+                continue;
+            }
+            kernel k = b.setup(n);
+            auto t   = time_kernel(k, n, opts.min_time_s);
+            double items
+                = static_cast<double>(t.second) * static_cast<double>(n);
+            results.push_back({b.name,
+                               b.group,
+                               b.kind,
+                               n,
+                               t.second,
+                               t.first * 1e9 / items,
+                               items / t.first});
+        }
+    }
+    return results;
+}
+
+std::string to_json(std::vector<result> const& results)
+{
+    std::ostringstream out;
+    out.precision(6);
+    out << "{\n";
+    out << "  \"isa\": \"" << isa_name() << "\",\n";
+#if defined(__clang__)
+    out << "  \"compiler\": \"clang " << __clang_major__ << '.'
+        << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+    out << "  \"compiler\": \"gcc " << __GNUC__ << '.' << __GNUC_MINOR__
+        << "\",\n";
+#elif defined(_MSC_VER)
+    out << "  \"compiler\": \"msvc " << _MSC_VER << "\",\n";
+#endif
+    out << "  \"results\": [";
+    for (size_t i = 0; i != results.size(); ++i)
+    {
+        result const& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"group\": \"" << r.group << "\", \"name\": \"" << r.name
+            << "\", \"mode\": \"" << mode_name(r.kind)
+            << "\", \"batch\": " << r.batch
+            << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_item\": " << json_number{r.ns_per_item}
+            << ", \"items_per_second\": "
+            << json_number{r.items_per_second} << '}';
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+void print_table(std::vector<result> const& results)
+{
+    std::printf("isa: %s\n", isa_name());
+    std::printf("%-36s %-10s %10s %12s %14s\n",
+                "benchmark",
+                "mode",
+                "batch",
+                "ns/item",
+                "Mitems/s");
+    for (result const& r : results)
+    {
+        std::string full = r.group + "/" + r.name;
+        std::printf("%-36s %-10s %10zu %12.3f %14.2f\n",
+                    full.c_str(),
+                    mode_name(r.kind),
+                    r.batch,
+                    r.ns_per_item,
+                    r.items_per_second * 1e-6);
+    }
+}
+} // namespace bench
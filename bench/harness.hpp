@@ -0,0 +1,123 @@
+// File: harness.hpp
+// Purpose: Minimal self-contained timing harness for the offline benchmark
+// suite (no external dependencies or network access needed).
+//
+// Notes:
+// Each benchmark is registered with a setup function that receives a batch
+// size and returns a kernel processing that many items once. The harness
+// times repeated invocations of the kernel until a minimum duration elapses
+// and reports the time per item. Latency benchmarks instead run a single
+// dependent chain where each result feeds the next input.
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+// Prevents the compiler from eliding computation whose result is otherwise
+// unused
+template <typename T>
+inline void do_not_optimize(T const& value) noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    static_cast<void>(*const_cast<T volatile*>(&value));
+    _ReadWriteBarrier();
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+// Processes one batch. Latency kernels ignore the batch size and instead run
+// a chain of the requested number of dependent operations.
+using kernel = std::function<void(size_t)>;
+
+enum class mode
+{
+    throughput,
+    latency,
+};
+
+struct benchmark
+{
+    std::string name;
+    std::string group;
+    mode kind;
+    // Bytes read and written per item, used to skip batch sizes whose working
+    // set exceeds the configured memory budget
+    size_t bytes_per_item;
+    // Allocates and initializes inputs for the given batch size
+    std::function<kernel(size_t)> setup;
+};
+
+struct result
+{
+    std::string name;
+    std::string group;
+    mode kind;
+    size_t batch;
+    size_t iterations;
+    double ns_per_item;
+    double items_per_second;
+};
+
+struct options
+{
+    std::vector<size_t> batches
+        = {1, 16, 256, 4096, 65536, 1048576, 10485760};
+    double min_time_s      = 0.05;
+    size_t max_bytes       = size_t{2} << 30;
+    size_t latency_chain   = 1 << 16;
+    std::string filter;
+};
+
+std::vector<benchmark>& registry();
+
+// Registers a throughput benchmark. Setup receives a batch size and returns
+// a callable invoked with the same batch size for each timed repetition.
+template <typename Setup>
+void add(char const* group,
+         char const* name,
+         size_t bytes_per_item,
+         Setup setup)
+{
+    registry().push_back(
+        {name, group, mode::throughput, bytes_per_item, [setup](size_t n) {
+             return kernel{setup(n)};
+         }});
+}
+
+// Registers a latency benchmark. The returned kernel receives the length of
+// the dependent chain to evaluate.
+template <typename Setup>
+void add_latency(char const* group, char const* name, Setup setup)
+{
+    registry().push_back({name, group, mode::latency, 0, [setup](size_t) {
+                              return kernel{setup()};
+                          }});
+}
+
+// Deterministic random source shared by all input generators
+std::mt19937& rng();
+
+inline float uniform(float lo, float hi)
+{
+    return std::uniform_real_distribution<float>{lo, hi}(rng());
+}
+
+std::vector<result> run(options const& opts);
+
+std::string to_json(std::vector<result> const& results);
+
+void print_table(std::vector<result> const& results);
+
+// Instruction set the benchmark binary was compiled for (defined alongside
+// the benchmarks, which are compiled once per instruction set target)
+char const* isa_name() noexcept;
+} // namespace bench
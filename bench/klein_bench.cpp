@@ -0,0 +1,451 @@
+// File: klein_bench.cpp
+// Purpose: Register benchmarks for the public Klein operations.
+//
+// Notes:
+// Throughput benchmarks apply an operation to arrays of random inputs of
+// each configured batch size, so the sweep crosses the L1, L2, L3 and DRAM
+// regimes. Latency benchmarks feed each result back as the next input.
+
+#include "harness.hpp"
+
+#include <klein/klein.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace
+{
+using namespace kln;
+using bench::uniform;
+
+template <typename T>
+T make();
+
+template <>
+point make<point>()
+{
+    return {uniform(-10.f, 10.f), uniform(-10.f, 10.f), uniform(-10.f, 10.f)};
+}
+
+template <>
+direction make<direction>()
+{
+    return {uniform(-1.f, 1.f), uniform(-1.f, 1.f), uniform(0.1f, 1.f)};
+}
+
+template <>
+plane make<plane>()
+{
+    return plane{uniform(-1.f, 1.f),
+                 uniform(-1.f, 1.f),
+                 uniform(0.1f, 1.f),
+                 uniform(-10.f, 10.f)}
+        .normalized();
+}
+
+template <>
+rotor make<rotor>()
+{
+    return {uniform(-3.f, 3.f),
+            uniform(-1.f, 1.f),
+            uniform(-1.f, 1.f),
+            uniform(0.1f, 1.f)};
+}
+
+template <>
+translator make<translator>()
+{
+    return {uniform(0.f, 10.f),
+            uniform(-1.f, 1.f),
+            uniform(-1.f, 1.f),
+            uniform(0.1f, 1.f)};
+}
+
+template <>
+motor make<motor>()
+{
+    return make<rotor>() * make<translator>();
+}
+
+template <>
+line make<line>()
+{
+    return log(make<motor>());
+}
+
+template <>
+branch make<branch>()
+{
+    return log(make<rotor>());
+}
+
+template <typename T>
+std::shared_ptr<std::vector<T>> random_array(size_t n)
+{
+    auto out = std::make_shared<std::vector<T>>(n);
+    for (T& t : *out)
+    {
+        t = make<T>();
+    }
+    return out;
+}
+
+// out[i] = op(a[i])
+template <typename A, typename Op>
+void unary(char const* group, char const* name, Op op)
+{
+    using R = decltype(op(std::declval<A>()));
+    bench::add(group, name, sizeof(A) + sizeof(R), [op](size_t n) {
+        auto a   = random_array<A>(n);
+        auto out = std::make_shared<std::vector<R>>(n);
+        return [a, out, op](size_t count) {
+            A const* in = a->data();
+            R* r        = out->data();
+            for (size_t i = 0; i != count; ++i)
+            {
+                r[i] = op(in[i]);
+            }
+            bench::do_not_optimize(r);
+        };
+    });
+}
+
+// out[i] = op(a[i], b[i])
+template <typename A, typename B, typename Op>
+void binary(char const* group, char const* name, Op op)
+{
+    using R = decltype(op(std::declval<A>(), std::declval<B>()));
+    size_t bytes = sizeof(A) + sizeof(B) + sizeof(R);
+    bench::add(group, name, bytes, [op](size_t n) {
+        auto a   = random_array<A>(n);
+        auto b   = random_array<B>(n);
+        auto out = std::make_shared<std::vector<R>>(n);
+        return [a, b, out, op](size_t count) {
+            A const* in1 = a->data();
+            B const* in2 = b->data();
+            R* r         = out->data();
+            for (size_t i = 0; i != count; ++i)
+            {
+                r[i] = op(in1[i], in2[i]);
+            }
+            bench::do_not_optimize(r);
+        };
+    });
+}
+
+// op(A const* in, R* out, size_t count) for the array entry points
+template <typename A, typename R, typename Op>
+void array(char const* group, char const* name, Op op)
+{
+    bench::add(group, name, sizeof(A) + sizeof(R), [op](size_t n) {
+        auto a   = random_array<A>(n);
+        auto out = std::make_shared<std::vector<R>>(n);
+        return [a, out, op](size_t count) {
+            op(a->data(), out->data(), count);
+            bench::do_not_optimize(out->data());
+        };
+    });
+}
+
+// x = op(x) repeated, measuring the latency of op
+template <typename A, typename Op>
+void chain(char const* group, char const* name, Op op)
+{
+    bench::add_latency(group, name, [op]() {
+        auto x = std::make_shared<A>(make<A>());
+        return [x, op](size_t count) {
+            A v = *x;
+            for (size_t i = 0; i != count; ++i)
+            {
+                v = op(v);
+            }
+            bench::do_not_optimize(v);
+        };
+    });
+}
+
+void register_products()
+{
+    binary<motor, motor>(
+        "gp", "motor*motor", [](motor a, motor b) { return a * b; });
+    binary<rotor, rotor>(
+        "gp", "rotor*rotor", [](rotor a, rotor b) { return a * b; });
+    binary<rotor, translator>(
+        "gp", "rotor*translator", [](rotor a, translator b) { return a * b; });
+    binary<motor, translator>(
+        "gp", "motor*translator", [](motor a, translator b) { return a * b; });
+    binary<plane, plane>(
+        "gp", "plane*plane", [](plane a, plane b) { return a * b; });
+    binary<point, point>(
+        "gp", "point*point", [](point a, point b) { return a * b; });
+    binary<line, line>(
+        "gp", "line*line", [](line a, line b) { return a * b; });
+
+    bench::add("gp", "multiply(motor[])", 3 * sizeof(motor), [](size_t n) {
+        auto a   = random_array<motor>(n);
+        auto b   = random_array<motor>(n);
+        auto out = std::make_shared<std::vector<motor>>(n);
+        return [a, b, out](size_t count) {
+            multiply(a->data(), b->data(), out->data(), count);
+            bench::do_not_optimize(out->data());
+        };
+    });
+
+    motor c = make<motor>();
+    chain<motor>("gp", "motor*motor", [c](motor m) { return m * c; });
+    rotor r = make<rotor>();
+    chain<rotor>("gp", "rotor*rotor", [r](rotor m) { return m * r; });
+}
+
+void register_sandwiches()
+{
+    binary<motor, point>(
+        "sandwich", "motor(point)", [](motor m, point p) { return m(p); });
+    binary<motor, plane>(
+        "sandwich", "motor(plane)", [](motor m, plane p) { return m(p); });
+    binary<motor, line>(
+        "sandwich", "motor(line)", [](motor m, line l) { return m(l); });
+    binary<motor, direction>("sandwich",
+                             "motor(direction)",
+                             [](motor m, direction d) { return m(d); });
+    binary<rotor, point>(
+        "sandwich", "rotor(point)", [](rotor r, point p) { return r(p); });
+    binary<rotor, plane>(
+        "sandwich", "rotor(plane)", [](rotor r, plane p) { return r(p); });
+    binary<translator, point>("sandwich",
+                              "translator(point)",
+                              [](translator t, point p) { return t(p); });
+
+    // One motor applied to an array (the variadic kernels)
+    motor m = make<motor>();
+    array<point, point>("sandwich",
+                      "motor(point[])",
+                      [m](point const* in, point* out, size_t n) {
+                          m(const_cast<point*>(in), out, n);
+                      });
+    array<plane, plane>("sandwich",
+                      "motor(plane[])",
+                      [m](plane const* in, plane* out, size_t n) {
+                          m(const_cast<plane*>(in), out, n);
+                      });
+    array<line, line>("sandwich",
+                      "motor(line[])",
+                      [m](line const* in, line* out, size_t n) {
+                          m(const_cast<line*>(in), out, n);
+                      });
+
+    // Eight motors applied to eight points per bundle
+    bench::add("sandwich",
+               "motor_x8(point_x8)",
+               sizeof(motor) + 2 * sizeof(point),
+               [](size_t n) {
+                   auto ms  = random_array<motor>(n);
+                   auto ps  = random_array<point>(n);
+                   auto out = std::make_shared<std::vector<point>>(n);
+                   return [ms, ps, out](size_t count) {
+                       for (size_t i = 0; i < count; i += 8)
+                       {
+                           size_t k = count - i < 8 ? count - i : 8;
+                           motor_x8 mx;
+                           point_x8 px;
+                           mx.load(ms->data() + i, k);
+                           px.load(ps->data() + i, k);
+                           mx(px).store(out->data() + i, k);
+                       }
+                       bench::do_not_optimize(out->data());
+                   };
+               });
+
+    // A motor per point, directly and through an index into a small palette
+    bench::add("sandwich",
+               "apply(motor[], point[])",
+               sizeof(motor) + 2 * sizeof(point),
+               [](size_t n) {
+                   auto ms  = random_array<motor>(n);
+                   auto ps  = random_array<point>(n);
+                   auto out = std::make_shared<std::vector<point>>(n);
+                   return [ms, ps, out](size_t count) {
+                       apply(ms->data(), ps->data(), out->data(), count);
+                       bench::do_not_optimize(out->data());
+                   };
+               });
+    bench::add("sandwich",
+               "apply(motor[idx[]], point[])",
+               sizeof(uint32_t) + 2 * sizeof(point),
+               [](size_t n) {
+                   auto ms  = random_array<motor>(64);
+                   auto ps  = random_array<point>(n);
+                   auto idx = std::make_shared<std::vector<uint32_t>>(n);
+                   auto out = std::make_shared<std::vector<point>>(n);
+                   for (size_t i = 0; i != n; ++i)
+                   {
+                       (*idx)[i] = static_cast<uint32_t>(
+                           uniform(0.f, 63.99f));
+                   }
+                   return [ms, ps, idx, out](size_t count) {
+                       apply(ms->data(),
+                             idx->data(),
+                             ps->data(),
+                             out->data(),
+                             count);
+                       bench::do_not_optimize(out->data());
+                   };
+               });
+
+    chain<point>("sandwich", "motor(point)", [m](point p) { return m(p); });
+}
+
+void register_exp_log()
+{
+    unary<motor>("exp_log", "log(motor)", [](motor m) { return log(m); });
+    unary<line>("exp_log", "exp(line)", [](line l) { return exp(l); });
+    unary<rotor>("exp_log", "log(rotor)", [](rotor r) { return log(r); });
+    unary<branch>("exp_log", "exp(branch)", [](branch b) { return exp(b); });
+    unary<motor>("exp_log", "sqrt(motor)", [](motor m) { return sqrt(m); });
+
+    array<motor, line>("exp_log",
+                       "log(motor[])",
+                       [](motor const* in, line* out, size_t n) {
+                           log(in, out, n);
+                       });
+    array<line, motor>("exp_log",
+                       "exp(line[])",
+                       [](line const* in, motor* out, size_t n) {
+                           exp(in, out, n);
+                       });
+
+    binary<motor, motor>("exp_log", "sclerp", [](motor a, motor b) {
+        return sclerp(a, b, 0.3f);
+    });
+    binary<motor, motor>("exp_log", "nlerp(motor)", [](motor a, motor b) {
+        return nlerp(a, b, 0.3f);
+    });
+
+    chain<motor>("exp_log", "exp(log(motor))", [](motor m) {
+        return exp(log(m));
+    });
+}
+
+void register_matrix()
+{
+    unary<motor>(
+        "matrix", "motor::as_mat3x4", [](motor m) { return m.as_mat3x4(); });
+    unary<motor>(
+        "matrix", "motor::as_mat4x4", [](motor m) { return m.as_mat4x4(); });
+    unary<rotor>(
+        "matrix", "rotor::as_mat3x4", [](rotor r) { return r.as_mat3x4(); });
+    unary<rotor>(
+        "matrix", "rotor::as_mat4x4", [](rotor r) { return r.as_mat4x4(); });
+
+    array<motor, mat3x4>("matrix",
+                         "to_mat3x4(motor[])",
+                         [](motor const* in, mat3x4* out, size_t n) {
+                             to_mat3x4(in, out, n);
+                         });
+    array<motor, mat3x4>("matrix",
+                         "stream_mat3x4(motor[])",
+                         [](motor const* in, mat3x4* out, size_t n) {
+                             stream_mat3x4(in, out, n);
+                         });
+    array<rotor, mat3x4>("matrix",
+                         "to_mat3x4(rotor[])",
+                         [](rotor const* in, mat3x4* out, size_t n) {
+                             to_mat3x4(in, out, n);
+                         });
+}
+
+void register_meet_join()
+{
+    binary<plane, plane>(
+        "meet_join", "plane^plane", [](plane a, plane b) { return a ^ b; });
+    binary<plane, line>(
+        "meet_join", "plane^line", [](plane a, line b) { return a ^ b; });
+    binary<point, point>(
+        "meet_join", "point&point", [](point a, point b) { return a & b; });
+    binary<point, line>(
+        "meet_join", "point&line", [](point a, line b) { return a & b; });
+    binary<plane, plane>(
+        "meet_join", "plane|plane", [](plane a, plane b) { return a | b; });
+    binary<plane, point>(
+        "meet_join", "plane|point", [](plane a, point b) { return a | b; });
+}
+
+void register_projection()
+{
+    binary<point, plane>("projection",
+                         "project(point, plane)",
+                         [](point a, plane b) { return project(a, b); });
+    binary<point, line>("projection",
+                        "project(point, line)",
+                        [](point a, line b) { return project(a, b); });
+    binary<line, plane>("projection",
+                        "project(line, plane)",
+                        [](line a, plane b) { return project(a, b); });
+    binary<plane, point>("projection",
+                         "project(plane, point)",
+                         [](plane a, point b) { return project(a, b); });
+}
+
+// Each pair times an eager expression against its kln::lazy counterpart
+void register_expr()
+{
+    motor m = make<motor>();
+    binary<motor, point>("expr",
+                         "(motor * motor)(point)",
+                         [m](motor a, point p) { return (m * a)(p); });
+    binary<motor, point>("expr",
+                         "(lazy(motor) * motor)(point)",
+                         [m](motor a, point p) { return (lazy(m) * a)(p); });
+
+    translator t = make<translator>();
+    binary<rotor, point>("expr",
+                         "(translator * rotor)(point)",
+                         [t](rotor r, point p) { return (t * r)(p); });
+    binary<rotor, point>("expr",
+                         "(lazy(translator) * rotor)(point)",
+                         [t](rotor r, point p) { return (lazy(t) * r)(p); });
+
+    plane b = make<plane>();
+    binary<point, plane>("expr",
+                         "project(point, plane ^ plane)",
+                         [b](point p, plane a) { return project(p, a ^ b); });
+    binary<point, plane>(
+        "expr", "project(point, lazy(plane) ^ plane)", [b](point p, plane a) {
+            return project(p, lazy(a) ^ b);
+        });
+}
+
+void register_normalize()
+{
+    unary<motor>(
+        "normalize", "motor", [](motor m) { return m.normalized(); });
+    unary<rotor>(
+        "normalize", "rotor", [](rotor r) { return r.normalized(); });
+    unary<line>("normalize", "line", [](line l) { return l.normalized(); });
+    unary<plane>(
+        "normalize", "plane", [](plane p) { return p.normalized(); });
+}
+} // namespace
+
+char const* bench::isa_name() noexcept
+{
+#if defined(KLEIN_AVX2)
+    return "avx2";
+#elif defined(KLEIN_SSE_4_1)
+    return "sse4.1";
+#else
+    return "sse3";
+#endif
+}
+
+void register_benchmarks()
+{
+    register_products();
+    register_sandwiches();
+    register_exp_log();
+    register_matrix();
+    register_meet_join();
+    register_projection();
+    register_expr();
+    register_normalize();
+}
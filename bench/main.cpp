@@ -0,0 +1,219 @@
+#include "harness.hpp"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+void register_benchmarks();
+
+namespace
+{
+void usage()
+{
+    std::printf(
+        "Usage: klein_bench [options]\n"
+        "  --filter STR     Run only benchmarks whose group/name contains STR\n"
+        "  --batches LIST   Comma-separated batch sizes (default "
+        "1,16,256,4096,65536,1048576,10485760)\n"
+        "  --max-batch N    Drop batch sizes larger than N\n"
+        "  --max-mb N       Skip batches whose working set exceeds N MiB "
+        "(default 2048)\n"
+        "  --min-time S     Minimum seconds timed per measurement (default "
+        "0.05)\n"
+        "  --chain N        Dependent operations per latency measurement "
+        "(default 65536)\n"
+        "  --json PATH      Write results as JSON to PATH (\"-\" for stdout)\n"
+        "  --list           List benchmarks and exit\n");
+}
+
+// Parses a positive integer spanning [arg, stop). std::strtoull skips leading
+// whitespace and negates a leading minus sign, so the count must start with
+// a digit.
+bool parse_count(char const* arg, char const* stop, size_t& out)
+{
+    if (arg == stop || *arg < '0' || *arg > '9')
+    {
+        return false;
+    }
+    errno                = 0;
+    char* end            = nullptr;
+    unsigned long long n = std::strtoull(arg, &end, 10);
+    if (end != stop || errno == ERANGE || n == 0 || n > SIZE_MAX)
+    {
+        return false;
+    }
+    out = static_cast<size_t>(n);
+    return true;
+}
+
+bool parse_count(char const* arg, size_t& out)
+{
+    return parse_count(arg, arg + std::strlen(arg), out);
+}
+
+// Parses a comma-separated list of positive integers
+bool parse_list(char const* arg, std::vector<size_t>& out)
+{
+    out.clear();
+    for (char const* p = arg;; ++p)
+    {
+        char const* stop = std::strchr(p, ',');
+        if (stop == nullptr)
+        {
+            stop = p + std::strlen(p);
+        }
+        size_t n;
+        if (!parse_count(p, stop, n))
+        {
+            return false;
+        }
+        out.push_back(n);
+        if (*stop == '\0')
+        {
+            return true;
+        }
+        p = stop;
+    }
+}
+
+// Parses a positive, finite number of seconds
+bool parse_seconds(char const* arg, double& out)
+{
+    if ((*arg < '0' || *arg > '9') && *arg != '.')
+    {
+        return false;
+    }
+    char* end = nullptr;
+    double s  = std::strtod(arg, &end);
+    if (*end != '\0' || !std::isfinite(s) || s <= 0.0)
+    {
+        return false;
+    }
+    out = s;
+    return true;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    register_benchmarks();
+
+    bench::options opts;
+    std::string json_path;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        bool has_value  = i + 1 < argc;
+        if (arg == "--filter" && has_value)
+        {
+            opts.filter = argv[++i];
+        }
+        else if (arg == "--batches" && has_value)
+        {
+            if (!parse_list(argv[++i], opts.batches))
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (arg == "--max-batch" && has_value)
+        {
+            size_t max;
+            if (!parse_count(argv[++i], max))
+            {
+                usage();
+                return 1;
+            }
+            std::vector<size_t> kept;
+            for (size_t n : opts.batches)
+            {
+                if (n <= max)
+                {
+                    kept.push_back(n);
+                }
+            }
+            opts.batches = kept;
+        }
+        else if (arg == "--max-mb" && has_value)
+        {
+            size_t mb;
+            if (!parse_count(argv[++i], mb) || mb > (SIZE_MAX >> 20))
+            {
+                usage();
+                return 1;
+            }
+            opts.max_bytes = mb << 20;
+        }
+        else if (arg == "--min-time" && has_value)
+        {
+            if (!parse_seconds(argv[++i], opts.min_time_s))
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (arg == "--chain" && has_value)
+        {
+            if (!parse_count(argv[++i], opts.latency_chain))
+            {
+                usage();
+                return 1;
+            }
+        }
+        else if (arg == "--json" && has_value)
+        {
+            json_path = argv[++i];
+        }
+        else if (arg == "--list")
+        {
+            list = true;
+        }
+        else
+        {
+            usage();
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+    }
+
+    if (list)
+    {
+        for (bench::benchmark const& b : bench::registry())
+        {
+            std::printf("%s/%s (%s)\n",
+                        b.group.c_str(),
+                        b.name.c_str(),
+                        b.kind == bench::mode::throughput ? "throughput"
+                                                          : "latency");
+        }
+        return 0;
+    }
+
+    std::vector<bench::result> results = bench::run(opts);
+
+    if (json_path == "-")
+    {
+        std::cout << bench::to_json(results);
+        return 0;
+    }
+
+    bench::print_table(results);
+    if (!json_path.empty())
+    {
+        std::ofstream out{json_path};
+        if (!out)
+        {
+            std::fprintf(stderr, "Unable to open %s\n", json_path.c_str());
+            return 1;
+        }
+        out << bench::to_json(results);
+    }
+    return 0;
+}
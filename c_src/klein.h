@@ -3,11 +3,39 @@
 
 #pragma once
 
+/// Linkage of the functions declared in this header. By default they are
+/// resolved against the static klein_c library. Define `KLEIN_C_SHARED` when
+/// linking the klein_c shared library (the CMake target does this for its
+/// consumers). C++ translation units may instead define `KLEIN_C_INLINE` to
+/// compile every function as `static inline` from klein_c.inl, letting the
+/// optimizer inline the Klein routines into the caller. The definitions are
+/// written in C++, so this mode is not available to C translation units, which
+/// always call into one of the libraries.
+#ifndef KLN_C_API
+#    if defined(KLEIN_C_INLINE)
+#        define KLN_C_API static inline
+#    elif defined(KLEIN_C_SHARED)
+#        if defined(_WIN32)
+#            if defined(klein_c_EXPORTS)
+#                define KLN_C_API __declspec(dllexport)
+#            else
+#                define KLN_C_API __declspec(dllimport)
+#            endif
+#        else
+#            define KLN_C_API __attribute__((visibility("default")))
+#        endif
+#    else
+#        define KLN_C_API
+#    endif
+#endif
+
 #if __cplusplus
 extern "C"
 {
 #endif
 
+#include <stddef.h>
+#include <stdint.h>
 #include <xmmintrin.h>
 
     typedef struct
@@ -66,11 +94,28 @@ extern "C"
         __m128 p2;
     } kln_motor;
 
+    /// 3x4 column-major matrix. The storage is identical to `kln_mat4x4` and
+    /// the last row is unused.
+    typedef struct
+    {
+        __m128 cols[4];
+    } kln_mat3x4;
+
+    /// 4x4 column-major matrix
+    typedef struct
+    {
+        __m128 cols[4];
+    } kln_mat4x4;
+
     // INITIALIZATION ROUTINES
 
     /// Initialize a given plane to the quantity $a\mathbf{e}_1 + b\mathbf{e}_2 +\
     /// c\mathbf{e}_3 + d\mathbf{e}_0$.
-    void kln_plane_init(kln_plane* plane, float a, float b, float c, float d);
+    KLN_C_API void kln_plane_init(kln_plane* plane,
+                                  float a,
+                                  float b,
+                                  float c,
+                                  float d);
 
     /// A line is specifed by 6 coordinates which correspond to the line's
     /// [Plücker
@@ -80,89 +125,229 @@ extern "C"
     ///
     /// $$a\mathbf{e}_{01} + b\mathbf{e}_{02} + c\mathbf{e}_{03} +\
     /// d\mathbf{e}_{12} + e\mathbf{e}_{31} + f\mathbf{e}_{23}$$
-    void kln_line_init(kln_line* line,
-                       float a,
-                       float b,
-                       float c,
-                       float d,
-                       float e,
-                       float f);
+    KLN_C_API void kln_line_init(kln_line* line,
+                                 float a,
+                                 float b,
+                                 float c,
+                                 float d,
+                                 float e,
+                                 float f);
 
     /// Initialize a given point to the quantity $\mathbf{e}_{123} + x\mathbf{e}_{023} +\
     /// y\mathbf{e}_{031} + z\mathbf{e}_{012}$.
-    void kln_point_init(kln_point* point, float x, float y, float z);
+    KLN_C_API void kln_point_init(kln_point* point, float x, float y, float z);
 
     // VARIOUS GROUP ACTIONS
 
     /// Reflect point through plane
-    kln_point kln_reflect_point(kln_plane const* plane, kln_point const* point);
+    KLN_C_API kln_point kln_reflect_point(kln_plane const* plane,
+                                          kln_point const* point);
 
     /// Reflect line through plane
-    kln_line kln_reflect_line(kln_plane const* plane, kln_line const* line);
+    KLN_C_API kln_line kln_reflect_line(kln_plane const* plane,
+                                        kln_line const* line);
 
     /// Reflect plane2 through plane1
-    kln_plane kln_reflect_plane(kln_plane const* plane1, kln_plane const* plane2);
+    KLN_C_API kln_plane kln_reflect_plane(kln_plane const* plane1,
+                                          kln_plane const* plane2);
 
     /// Apply rotor to point
-    kln_point kln_rotate_point(kln_rotor const* rotor, kln_point const* point);
+    KLN_C_API kln_point kln_rotate_point(kln_rotor const* rotor,
+                                         kln_point const* point);
 
     /// Apply rotor to line
-    kln_line kln_rotate_line(kln_rotor const* rotor, kln_line const* line);
+    KLN_C_API kln_line kln_rotate_line(kln_rotor const* rotor,
+                                       kln_line const* line);
 
     /// Apply rotor to plane
-    kln_plane kln_rotate_plane(kln_rotor const* rotor, kln_plane const* line);
+    KLN_C_API kln_plane kln_rotate_plane(kln_rotor const* rotor,
+                                         kln_plane const* line);
 
     /// Apply a translator to a point
-    kln_point kln_translate_point(kln_translator const* translator,
-                                  kln_point const* point);
+    KLN_C_API kln_point kln_translate_point(kln_translator const* translator,
+                                            kln_point const* point);
 
     /// Apply a translator to a line
-    kln_line
-    kln_translate_line(kln_translator const* translator, kln_line const* line);
+    KLN_C_API kln_line kln_translate_line(kln_translator const* translator,
+                                          kln_line const* line);
 
     /// Apply a translator to a plane
-    kln_plane kln_translate_plane(kln_translator const* translator,
-                                  kln_plane const* plane);
+    KLN_C_API kln_plane kln_translate_plane(kln_translator const* translator,
+                                            kln_plane const* plane);
 
     /// Apply motor to point
-    kln_point kln_motor_point(kln_motor const* motor, kln_point const* point);
+    KLN_C_API kln_point kln_motor_point(kln_motor const* motor,
+                                        kln_point const* point);
 
     /// Apply motor to line
-    kln_line kln_motor_line(kln_motor const* motor, kln_line const* line);
+    KLN_C_API kln_line kln_motor_line(kln_motor const* motor,
+                                      kln_line const* line);
 
     /// Apply motor to plane
-    kln_plane kln_motor_plane(kln_motor const* motor, kln_plane const* plane);
+    KLN_C_API kln_plane kln_motor_plane(kln_motor const* motor,
+                                        kln_plane const* plane);
 
     // GROUP ACTION COMPOSITION
 
     /// Compose two rotors (rotor2 * rotor1)
-    kln_rotor
-    kln_compose_rotors(kln_rotor const* rotor1, kln_rotor const* rotor2);
+    KLN_C_API kln_rotor kln_compose_rotors(kln_rotor const* rotor1,
+                                           kln_rotor const* rotor2);
 
     /// Compose two translators (translator2 * translator1)
-    kln_translator kln_compose_translators(kln_translator const* translator1,
-                                           kln_translator const* translator2);
+    KLN_C_API kln_translator
+    kln_compose_translators(kln_translator const* translator1,
+                            kln_translator const* translator2);
 
     /// Compose a rotor and a translator to create a motor (translator * rotor)
-    kln_motor kln_compose_rotor_translator(kln_rotor const* rotor,
-                                           kln_translator const* translator);
+    KLN_C_API kln_motor
+    kln_compose_rotor_translator(kln_rotor const* rotor,
+                                 kln_translator const* translator);
 
     /// Compose a translator and a rotor to create a motor (translator * rotor)
-    kln_motor kln_compose_translator_rotor(kln_translator const* translator,
-                                           kln_rotor const* rotor);
+    KLN_C_API kln_motor
+    kln_compose_translator_rotor(kln_translator const* translator,
+                                 kln_rotor const* rotor);
 
     /// Compose two motors (motor2 * motor1)
-    kln_motor
-    kln_compose_motors(kln_motor const* motor1, kln_motor const* motor2);
+    KLN_C_API kln_motor kln_compose_motors(kln_motor const* motor1,
+                                           kln_motor const* motor2);
 
     // MISCELLANEOUS
 
     /// Motor logarithm
-    kln_line motor_log(kln_motor const* motor);
+    KLN_C_API kln_line motor_log(kln_motor const* motor);
 
     /// Bivector exponential
-    kln_motor line_exp(kln_line const* line);
+    KLN_C_API kln_motor line_exp(kln_line const* line);
+
+    // BATCHED ROUTINES
+    //
+    // Each routine below processes `count` tightly packed elements per call so
+    // that callers binding through an FFI pay the call overhead once per array
+    // rather than once per element. Unless noted otherwise, `in` and `out` may
+    // be the same array but may not otherwise overlap.
+
+    /// Apply motor to each point, `out[i] = motor(in[i])`
+    KLN_C_API void kln_motor_points(kln_motor const* motor,
+                                    kln_point const* in,
+                                    kln_point* out,
+                                    size_t count);
+
+    /// Apply motor to each line, `out[i] = motor(in[i])`
+    KLN_C_API void kln_motor_lines(kln_motor const* motor,
+                                   kln_line const* in,
+                                   kln_line* out,
+                                   size_t count);
+
+    /// Apply motor to each plane, `out[i] = motor(in[i])`
+    KLN_C_API void kln_motor_planes(kln_motor const* motor,
+                                    kln_plane const* in,
+                                    kln_plane* out,
+                                    size_t count);
+
+    /// Apply motor to each direction, `out[i] = motor(in[i])`. Only the
+    /// rotational part of the motor has an effect.
+    KLN_C_API void kln_motor_directions(kln_motor const* motor,
+                                        kln_direction const* in,
+                                        kln_direction* out,
+                                        size_t count);
+
+    /// Apply rotor to each point, `out[i] = rotor(in[i])`
+    KLN_C_API void kln_rotate_points(kln_rotor const* rotor,
+                                     kln_point const* in,
+                                     kln_point* out,
+                                     size_t count);
+
+    /// Apply rotor to each line, `out[i] = rotor(in[i])`
+    KLN_C_API void kln_rotate_lines(kln_rotor const* rotor,
+                                    kln_line const* in,
+                                    kln_line* out,
+                                    size_t count);
+
+    /// Apply rotor to each plane, `out[i] = rotor(in[i])`
+    KLN_C_API void kln_rotate_planes(kln_rotor const* rotor,
+                                     kln_plane const* in,
+                                     kln_plane* out,
+                                     size_t count);
+
+    /// Apply each motor to its own point, `out[i] = motors[i](in[i])`
+    KLN_C_API void kln_motor_points_each(kln_motor const* motors,
+                                         kln_point const* in,
+                                         kln_point* out,
+                                         size_t count);
+
+    /// Apply each motor to its own line, `out[i] = motors[i](in[i])`
+    KLN_C_API void kln_motor_lines_each(kln_motor const* motors,
+                                        kln_line const* in,
+                                        kln_line* out,
+                                        size_t count);
+
+    /// Apply each motor to its own plane, `out[i] = motors[i](in[i])`
+    KLN_C_API void kln_motor_planes_each(kln_motor const* motors,
+                                         kln_plane const* in,
+                                         kln_plane* out,
+                                         size_t count);
+
+    /// Apply an indexed motor to each point,
+    /// `out[i] = motors[indices[i]](in[i])`
+    KLN_C_API void kln_motor_points_indexed(kln_motor const* motors,
+                                            uint32_t const* indices,
+                                            kln_point const* in,
+                                            kln_point* out,
+                                            size_t count);
+
+    /// Compose pairs of motors, `out[i] = motors2[i] * motors1[i]`. Any of
+    /// the arrays may alias.
+    KLN_C_API void kln_compose_motors_each(kln_motor const* motors1,
+                                           kln_motor const* motors2,
+                                           kln_motor* out,
+                                           size_t count);
+
+    /// Compose a motor with each motor in an array,
+    /// `out[i] = motor2 * motors1[i]`. `motors1` and `out` may alias.
+    KLN_C_API void kln_compose_motors_with(kln_motor const* motor2,
+                                           kln_motor const* motors1,
+                                           kln_motor* out,
+                                           size_t count);
+
+    /// Motor logarithm of each motor
+    KLN_C_API void kln_motor_logs(kln_motor const* in,
+                                  kln_line* out,
+                                  size_t count);
+
+    /// Bivector exponential of each line
+    KLN_C_API void kln_line_exps(kln_line const* in,
+                                 kln_motor* out,
+                                 size_t count);
+
+    /// Convert normalized rotors to 3x4 column-major matrices
+    KLN_C_API void kln_rotors_to_mat3x4(kln_rotor const* in,
+                                        kln_mat3x4* out,
+                                        size_t count);
+
+    /// Convert normalized rotors to 4x4 column-major matrices
+    KLN_C_API void kln_rotors_to_mat4x4(kln_rotor const* in,
+                                        kln_mat4x4* out,
+                                        size_t count);
+
+    /// Convert normalized motors to 3x4 column-major matrices
+    KLN_C_API void kln_motors_to_mat3x4(kln_motor const* in,
+                                        kln_mat3x4* out,
+                                        size_t count);
+
+    /// Convert normalized motors to 4x4 column-major matrices
+    KLN_C_API void kln_motors_to_mat4x4(kln_motor const* in,
+                                        kln_mat4x4* out,
+                                        size_t count);
 
 #if __cplusplus
 }
+#endif
+
+#if defined(KLEIN_C_INLINE)
+#    if __cplusplus
+#        include "klein_c.inl"
+#    else
+#        error "KLEIN_C_INLINE needs C++; link klein_c or klein_c_static"
+#    endif
 #endif
\ No newline at end of file
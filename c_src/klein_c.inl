@@ -0,0 +1,433 @@
+// File: klein_c.inl
+// Purpose: Definitions of the Klein C interface. These are compiled into the
+// klein_c libraries by klein_c.cpp, or included by klein.h as static inline
+// functions when KLEIN_C_INLINE is defined.
+
+#pragma once
+
+#include "klein.h"
+
+#include <klein/klein.hpp>
+
+static_assert(sizeof(kln_plane) == sizeof(kln::plane), "plane layout mismatch");
+static_assert(sizeof(kln_line) == sizeof(kln::line), "line layout mismatch");
+static_assert(sizeof(kln_point) == sizeof(kln::point), "point layout mismatch");
+static_assert(sizeof(kln_direction) == sizeof(kln::direction),
+              "direction layout mismatch");
+static_assert(sizeof(kln_rotor) == sizeof(kln::rotor), "rotor layout mismatch");
+static_assert(sizeof(kln_motor) == sizeof(kln::motor), "motor layout mismatch");
+static_assert(sizeof(kln_mat3x4) == sizeof(kln::mat3x4),
+              "mat3x4 layout mismatch");
+static_assert(sizeof(kln_mat4x4) == sizeof(kln::mat4x4),
+              "mat4x4 layout mismatch");
+
+namespace kln_c
+{
+    // Reinterpret an array of C entities as the equivalent Klein entities. The
+    // array sandwiches take a mutable input pointer to permit in place
+    // application, but never write through it.
+    template <typename T, typename U>
+    inline T* convert_array(U const* in)
+    {
+        return reinterpret_cast<T*>(const_cast<U*>(in));
+    }
+
+    template <typename T, typename U>
+    inline T* convert_array(U* in)
+    {
+        return reinterpret_cast<T*>(in);
+    }
+
+    inline kln::plane const& convert(kln_plane const& plane)
+    {
+        return reinterpret_cast<kln::plane const&>(plane);
+    }
+
+    inline kln_plane const& convert(kln::plane const& plane)
+    {
+        return reinterpret_cast<kln_plane const&>(plane);
+    }
+
+    inline kln::line const& convert(kln_line const& line)
+    {
+        return reinterpret_cast<kln::line const&>(line);
+    }
+
+    inline kln_line const& convert(kln::line const& line)
+    {
+        return reinterpret_cast<kln_line const&>(line);
+    }
+
+    inline kln::point const& convert(kln_point const& point)
+    {
+        return reinterpret_cast<kln::point const&>(point);
+    }
+
+    inline kln_point const& convert(kln::point const& point)
+    {
+        return reinterpret_cast<kln_point const&>(point);
+    }
+
+    inline kln::rotor const& convert(kln_rotor const& rotor)
+    {
+        return reinterpret_cast<kln::rotor const&>(rotor);
+    }
+
+    inline kln_rotor const& convert(kln::rotor const& rotor)
+    {
+        return reinterpret_cast<kln_rotor const&>(rotor);
+    }
+
+    inline kln::translator const& convert(kln_translator const& translator)
+    {
+        return reinterpret_cast<kln::translator const&>(translator);
+    }
+
+    inline kln_translator const& convert(kln::translator const& translator)
+    {
+        return reinterpret_cast<kln_translator const&>(translator);
+    }
+
+    inline kln::motor const& convert(kln_motor const& motor)
+    {
+        return reinterpret_cast<kln::motor const&>(motor);
+    }
+
+    inline kln_motor const& convert(kln::motor const& motor)
+    {
+        return reinterpret_cast<kln_motor const&>(motor);
+    }
+} // namespace kln_c
+
+KLN_C_API void kln_plane_init(kln_plane* plane,
+                              float a,
+                              float b,
+                              float c,
+                              float d)
+{
+    plane->p0 = kln::plane{a, b, c, d}.p0_;
+}
+
+KLN_C_API void kln_line_init(kln_line* line,
+                             float a,
+                             float b,
+                             float c,
+                             float d,
+                             float e,
+                             float f)
+{
+    kln::line tmp{a, b, c, d, e, f};
+    line->p1 = tmp.p1_;
+    line->p2 = tmp.p2_;
+}
+
+KLN_C_API void kln_point_init(kln_point* point, float x, float y, float z)
+{
+    point->p3 = kln::point{x, y, z}.p3_;
+}
+
+KLN_C_API kln_point kln_reflect_point(kln_plane const* plane,
+                                      kln_point const* point)
+{
+    return kln_c::convert(kln_c::convert(*plane)(kln_c::convert(*point)));
+}
+
+KLN_C_API kln_line kln_reflect_line(kln_plane const* plane,
+                                    kln_line const* line)
+{
+    return kln_c::convert(kln_c::convert(*plane)(kln_c::convert(*line)));
+}
+
+KLN_C_API kln_plane kln_reflect_plane(kln_plane const* plane1,
+                                      kln_plane const* plane2)
+{
+    return kln_c::convert(kln_c::convert(*plane1)(kln_c::convert(*plane2)));
+}
+
+KLN_C_API kln_point kln_rotate_point(kln_rotor const* rotor,
+                                     kln_point const* point)
+{
+    return kln_c::convert(kln_c::convert(*rotor)(kln_c::convert(*point)));
+}
+
+KLN_C_API kln_line kln_rotate_line(kln_rotor const* rotor, kln_line const* line)
+{
+    return kln_c::convert(kln_c::convert(*rotor)(kln_c::convert(*line)));
+}
+
+KLN_C_API kln_plane kln_rotate_plane(kln_rotor const* rotor,
+                                     kln_plane const* plane)
+{
+    return kln_c::convert(kln_c::convert(*rotor)(kln_c::convert(*plane)));
+}
+
+KLN_C_API kln_point
+kln_translate_point(kln_translator const* translator, kln_point const* point)
+{
+    return kln_c::convert(kln_c::convert(*translator)(kln_c::convert(*point)));
+}
+
+KLN_C_API kln_line kln_translate_line(kln_translator const* translator,
+                                      kln_line const* line)
+{
+    return kln_c::convert(kln_c::convert(*translator)(kln_c::convert(*line)));
+}
+
+KLN_C_API kln_plane
+kln_translate_plane(kln_translator const* translator, kln_plane const* plane)
+{
+    return kln_c::convert(kln_c::convert(*translator)(kln_c::convert(*plane)));
+}
+
+KLN_C_API kln_point kln_motor_point(kln_motor const* motor,
+                                    kln_point const* point)
+{
+    return kln_c::convert(kln_c::convert(*motor)(kln_c::convert(*point)));
+}
+
+KLN_C_API kln_line kln_motor_line(kln_motor const* motor, kln_line const* line)
+{
+    return kln_c::convert(kln_c::convert(*motor)(kln_c::convert(*line)));
+}
+
+KLN_C_API kln_plane kln_motor_plane(kln_motor const* motor,
+                                    kln_plane const* plane)
+{
+    return kln_c::convert(kln_c::convert(*motor)(kln_c::convert(*plane)));
+}
+
+KLN_C_API kln_rotor kln_compose_rotors(kln_rotor const* rotor1,
+                                       kln_rotor const* rotor2)
+{
+    return kln_c::convert(
+        kln::rotor{kln_c::convert(*rotor2) * kln_c::convert(*rotor1)});
+}
+
+KLN_C_API kln_translator
+kln_compose_translators(kln_translator const* translator1,
+                        kln_translator const* translator2)
+{
+    return kln_c::convert(kln::translator{kln_c::convert(*translator2)
+                                          * kln_c::convert(*translator1)});
+}
+
+KLN_C_API kln_motor
+kln_compose_rotor_translator(kln_rotor const* rotor,
+                             kln_translator const* translator)
+{
+    return kln_c::convert(
+        kln::motor{kln_c::convert(*translator) * kln_c::convert(*rotor)});
+}
+
+KLN_C_API kln_motor
+kln_compose_translator_rotor(kln_translator const* translator,
+                             kln_rotor const* rotor)
+{
+    return kln_c::convert(
+        kln::motor{kln_c::convert(*rotor) * kln_c::convert(*translator)});
+}
+
+KLN_C_API kln_motor kln_compose_motors(kln_motor const* motor1,
+                                       kln_motor const* motor2)
+{
+    return kln_c::convert(
+        kln::motor{kln_c::convert(*motor2) * kln_c::convert(*motor1)});
+}
+
+KLN_C_API kln_line motor_log(kln_motor const* motor)
+{
+    return kln_c::convert(kln::line{log(kln_c::convert(*motor))});
+}
+
+KLN_C_API kln_motor line_exp(kln_line const* line)
+{
+    return kln_c::convert(kln::motor{exp(kln_c::convert(*line))});
+}
+
+KLN_C_API void kln_motor_points(kln_motor const* motor,
+                                kln_point const* in,
+                                kln_point* out,
+                                size_t count)
+{
+    kln_c::convert(*motor)(kln_c::convert_array<kln::point>(in),
+                           kln_c::convert_array<kln::point>(out),
+                           count);
+}
+
+KLN_C_API void kln_motor_lines(kln_motor const* motor,
+                               kln_line const* in,
+                               kln_line* out,
+                               size_t count)
+{
+    kln_c::convert(*motor)(kln_c::convert_array<kln::line>(in),
+                           kln_c::convert_array<kln::line>(out),
+                           count);
+}
+
+KLN_C_API void kln_motor_planes(kln_motor const* motor,
+                                kln_plane const* in,
+                                kln_plane* out,
+                                size_t count)
+{
+    kln_c::convert(*motor)(kln_c::convert_array<kln::plane>(in),
+                           kln_c::convert_array<kln::plane>(out),
+                           count);
+}
+
+KLN_C_API void kln_motor_directions(kln_motor const* motor,
+                                    kln_direction const* in,
+                                    kln_direction* out,
+                                    size_t count)
+{
+    kln_c::convert(*motor)(kln_c::convert_array<kln::direction>(in),
+                           kln_c::convert_array<kln::direction>(out),
+                           count);
+}
+
+KLN_C_API void kln_rotate_points(kln_rotor const* rotor,
+                                 kln_point const* in,
+                                 kln_point* out,
+                                 size_t count)
+{
+    kln_c::convert(*rotor)(kln_c::convert_array<kln::point>(in),
+                           kln_c::convert_array<kln::point>(out),
+                           count);
+}
+
+KLN_C_API void kln_rotate_lines(kln_rotor const* rotor,
+                                kln_line const* in,
+                                kln_line* out,
+                                size_t count)
+{
+    kln_c::convert(*rotor)(kln_c::convert_array<kln::line>(in),
+                           kln_c::convert_array<kln::line>(out),
+                           count);
+}
+
+KLN_C_API void kln_rotate_planes(kln_rotor const* rotor,
+                                 kln_plane const* in,
+                                 kln_plane* out,
+                                 size_t count)
+{
+    kln_c::convert(*rotor)(kln_c::convert_array<kln::plane>(in),
+                           kln_c::convert_array<kln::plane>(out),
+                           count);
+}
+
+KLN_C_API void kln_motor_points_each(kln_motor const* motors,
+                                     kln_point const* in,
+                                     kln_point* out,
+                                     size_t count)
+{
+    kln::apply(kln_c::convert_array<kln::motor const>(motors),
+               kln_c::convert_array<kln::point const>(in),
+               kln_c::convert_array<kln::point>(out),
+               count);
+}
+
+KLN_C_API void kln_motor_lines_each(kln_motor const* motors,
+                                    kln_line const* in,
+                                    kln_line* out,
+                                    size_t count)
+{
+    kln::apply(kln_c::convert_array<kln::motor const>(motors),
+               kln_c::convert_array<kln::line const>(in),
+               kln_c::convert_array<kln::line>(out),
+               count);
+}
+
+KLN_C_API void kln_motor_planes_each(kln_motor const* motors,
+                                     kln_plane const* in,
+                                     kln_plane* out,
+                                     size_t count)
+{
+    kln::apply(kln_c::convert_array<kln::motor const>(motors),
+               kln_c::convert_array<kln::plane const>(in),
+               kln_c::convert_array<kln::plane>(out),
+               count);
+}
+
+KLN_C_API void kln_motor_points_indexed(kln_motor const* motors,
+                                        uint32_t const* indices,
+                                        kln_point const* in,
+                                        kln_point* out,
+                                        size_t count)
+{
+    kln::apply(kln_c::convert_array<kln::motor const>(motors),
+               indices,
+               kln_c::convert_array<kln::point const>(in),
+               kln_c::convert_array<kln::point>(out),
+               count);
+}
+
+KLN_C_API void kln_compose_motors_each(kln_motor const* motors1,
+                                       kln_motor const* motors2,
+                                       kln_motor* out,
+                                       size_t count)
+{
+    kln::multiply(kln_c::convert_array<kln::motor const>(motors2),
+                  kln_c::convert_array<kln::motor const>(motors1),
+                  kln_c::convert_array<kln::motor>(out),
+                  count);
+}
+
+KLN_C_API void kln_compose_motors_with(kln_motor const* motor2,
+                                       kln_motor const* motors1,
+                                       kln_motor* out,
+                                       size_t count)
+{
+    kln::multiply(kln_c::convert(*motor2),
+                  kln_c::convert_array<kln::motor const>(motors1),
+                  kln_c::convert_array<kln::motor>(out),
+                  count);
+}
+
+KLN_C_API void kln_motor_logs(kln_motor const* in, kln_line* out, size_t count)
+{
+    kln::log(kln_c::convert_array<kln::motor const>(in),
+             kln_c::convert_array<kln::line>(out),
+             count);
+}
+
+KLN_C_API void kln_line_exps(kln_line const* in, kln_motor* out, size_t count)
+{
+    kln::exp(kln_c::convert_array<kln::line const>(in),
+             kln_c::convert_array<kln::motor>(out),
+             count);
+}
+
+KLN_C_API void kln_rotors_to_mat3x4(kln_rotor const* in,
+                                    kln_mat3x4* out,
+                                    size_t count)
+{
+    kln::to_mat3x4(kln_c::convert_array<kln::rotor const>(in),
+                   kln_c::convert_array<kln::mat3x4>(out),
+                   count);
+}
+
+KLN_C_API void kln_rotors_to_mat4x4(kln_rotor const* in,
+                                    kln_mat4x4* out,
+                                    size_t count)
+{
+    kln::to_mat4x4(kln_c::convert_array<kln::rotor const>(in),
+                   kln_c::convert_array<kln::mat4x4>(out),
+                   count);
+}
+
+KLN_C_API void kln_motors_to_mat3x4(kln_motor const* in,
+                                    kln_mat3x4* out,
+                                    size_t count)
+{
+    kln::to_mat3x4(kln_c::convert_array<kln::motor const>(in),
+                   kln_c::convert_array<kln::mat3x4>(out),
+                   count);
+}
+
+KLN_C_API void kln_motors_to_mat4x4(kln_motor const* in,
+                                    kln_mat4x4* out,
+                                    size_t count)
+{
+    kln::to_mat4x4(kln_c::convert_array<kln::motor const>(in),
+                   kln_c::convert_array<kln::mat4x4>(out),
+                   count);
+}
@@ -0,0 +1,131 @@
+#include <klein/dispatch.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#    include <intrin.h>
+#else
+#    include <cpuid.h>
+#endif
+
+namespace kln
+{
+namespace dispatch
+{
+    namespace
+    {
+        void cpuid(unsigned leaf,
+                   unsigned subleaf,
+                   unsigned (&regs)[4]) noexcept
+        {
+#ifdef _MSC_VER
+            int out[4];
+            __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+            for (int i = 0; i != 4; ++i)
+            {
+                regs[i] = static_cast<unsigned>(out[i]);
+            }
+#else
+            __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+        }
+
+        // Read XCR0 to confirm the OS saves YMM state on context switches
+        uint64_t xcr0() noexcept
+        {
+#ifdef _MSC_VER
+            return _xgetbv(0);
+#else
+            uint32_t eax;
+            uint32_t edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+        }
+
+        isa query() noexcept
+        {
+            unsigned regs[4];
+            cpuid(0, 0, regs);
+            unsigned max_leaf = regs[0];
+
+            cpuid(1, 0, regs);
+            bool sse4_1  = (regs[2] & (1u << 19)) != 0;
+            bool fma     = (regs[2] & (1u << 12)) != 0;
+            bool osxsave = (regs[2] & (1u << 27)) != 0;
+            bool avx     = (regs[2] & (1u << 28)) != 0;
+
+            bool avx2 = false;
+            if (max_leaf >= 7)
+            {
+                cpuid(7, 0, regs);
+                avx2 = (regs[1] & (1u << 5)) != 0;
+            }
+
+            // XMM (bit 1) and YMM (bit 2) state must both be enabled
+            bool ymm_state = osxsave && (xcr0() & 0x6) == 0x6;
+
+            if (avx && avx2 && fma && ymm_state)
+            {
+                return isa::avx2;
+            }
+            if (sse4_1)
+            {
+                return isa::sse4_1;
+            }
+            return isa::sse3;
+        }
+
+        std::atomic<kernel_table const*> active_table{nullptr};
+    } // namespace
+
+    isa detect() noexcept
+    {
+        static isa const level = query();
+        return level;
+    }
+
+    kernel_table const* table(isa level) noexcept
+    {
+        if (static_cast<int>(level) > static_cast<int>(detect()))
+        {
+            return nullptr;
+        }
+
+        switch (level)
+        {
+            case isa::avx2:
+                return &detail::dispatch_avx2;
+            case isa::sse4_1:
+                return &detail::dispatch_sse4_1;
+            default:
+                return &detail::dispatch_sse3;
+        }
+    }
+
+    kernel_table const& active() noexcept
+    {
+        kernel_table const* out = active_table.load(std::memory_order_acquire);
+        if (out == nullptr)
+        {
+            // Concurrent first calls all compute the same table, so a plain
+            // store suffices
+            out = table(detect());
+            active_table.store(out, std::memory_order_release);
+        }
+        return *out;
+    }
+
+    bool bind(isa level) noexcept
+    {
+        kernel_table const* t = table(level);
+        if (t == nullptr)
+        {
+            return false;
+        }
+        active_table.store(t, std::memory_order_release);
+        return true;
+    }
+} // namespace dispatch
+} // namespace kln
@@ -0,0 +1,7 @@
+// AVX2 and FMA kernels (256-bit variadic sandwiches). See CMakeLists.txt for
+// the flags applied to this file.
+#define KLEIN_AVX2
+#define KLN_DISPATCH_TABLE dispatch_avx2
+#define KLN_DISPATCH_ISA isa::avx2
+
+#include "klein_dispatch_kernels.inl"
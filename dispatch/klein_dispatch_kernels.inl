@@ -0,0 +1,103 @@
+// File: klein_dispatch_kernels.inl
+// Purpose: Batch kernel definitions compiled once per instruction set.
+//
+// Notes:
+// This file is included by each klein_dispatch_<isa>.cpp translation unit
+// after it has defined the feature macros for its instruction set and
+// KLN_DISPATCH_TABLE, the name of the table to define.
+//
+// Everything here has internal linkage and calls only the KLN_INLINE kernels
+// from the detail headers. This is deliberate: an ordinary inline function
+// (e.g. a member of kln::motor) instantiated in the AVX2 translation unit
+// would be VEX-encoded, and the linker is free to keep that copy for every
+// other caller as well. Keeping the public types out of these translation
+// units ensures no code for a wider instruction set leaks into the SSE3
+// path.
+
+#include <klein/detail/dispatch_table.hpp>
+#include <klein/detail/geometric_product.hpp>
+#include <klein/detail/matrix.hpp>
+#include <klein/detail/sandwich.hpp>
+
+namespace
+{
+using kln::dispatch::isa;
+using kln::dispatch::kernel_table;
+
+void motor_planes(__m128 const* m,
+                  __m128 const* in,
+                  __m128* out,
+                  size_t count) noexcept
+{
+    kln::detail::sw012<true, true>(in, m[0], m + 1, out, count);
+}
+
+void motor_lines(__m128 const* m,
+                 __m128 const* in,
+                 __m128* out,
+                 size_t count) noexcept
+{
+    kln::detail::swMM<true, true, true>(in, m[0], m + 1, out, count);
+}
+
+void motor_points(__m128 const* m,
+                  __m128 const* in,
+                  __m128* out,
+                  size_t count) noexcept
+{
+    kln::detail::sw312<true, true>(in, m[0], m + 1, out, count);
+}
+
+// Conjugation of a plane and point with a rotor is identical, so this kernel
+// backs both rotor_planes and rotor_points.
+void rotor_planes(__m128 const* r,
+                  __m128 const* in,
+                  __m128* out,
+                  size_t count) noexcept
+{
+    kln::detail::sw012<true, false>(in, r[0], nullptr, out, count);
+}
+
+void rotor_lines(__m128 const* r,
+                 __m128 const* in,
+                 __m128* out,
+                 size_t count) noexcept
+{
+    kln::detail::swMM<true, false, true>(in, r[0], nullptr, out, count);
+}
+
+void motor_products(__m128 const* a,
+                    __m128 const* b,
+                    __m128* out,
+                    size_t count) noexcept
+{
+    kln::detail::gpMM<false>(a, b, out, count);
+}
+
+void motor_mat3x4(__m128 const* m, __m128* out, size_t count) noexcept
+{
+    kln::mat4x4_12<true, true, false>(m, out, count);
+}
+
+void motor_mat4x4(__m128 const* m, __m128* out, size_t count) noexcept
+{
+    kln::mat4x4_12<true, false, false>(m, out, count);
+}
+} // namespace
+
+namespace kln
+{
+namespace detail
+{
+    dispatch::kernel_table const KLN_DISPATCH_TABLE = {KLN_DISPATCH_ISA,
+                                                       motor_planes,
+                                                       motor_lines,
+                                                       motor_points,
+                                                       rotor_planes,
+                                                       rotor_lines,
+                                                       rotor_planes,
+                                                       motor_products,
+                                                       motor_mat3x4,
+                                                       motor_mat4x4};
+} // namespace detail
+} // namespace kln
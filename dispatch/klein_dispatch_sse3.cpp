@@ -0,0 +1,5 @@
+// Baseline kernels. Built with the same flags as the klein target.
+#define KLN_DISPATCH_TABLE dispatch_sse3
+#define KLN_DISPATCH_ISA isa::sse3
+
+#include "klein_dispatch_kernels.inl"
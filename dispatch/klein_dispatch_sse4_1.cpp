@@ -0,0 +1,7 @@
+// SSE4.1 kernels (dpps and blendps). See CMakeLists.txt for the flags applied
+// to this file.
+#define KLEIN_SSE_4_1
+#define KLN_DISPATCH_TABLE dispatch_sse4_1
+#define KLN_DISPATCH_ISA isa::sse4_1
+
+#include "klein_dispatch_kernels.inl"
@@ -25,6 +25,41 @@ kln::motor motor_composition(kln::motor const& a, kln::motor const& b)
     return out;
 }
 
+// Composition of many motor pairs as a loop over operator* versus the batched
+// entry point. Compare per-iteration throughput between the two reports.
+void motor_composition_loop(kln::motor const* a,
+                            kln::motor const* b,
+                            kln::motor* out,
+                            size_t count)
+{
+    MC_MEASURE_BEGIN(motor_composition_loop);
+    for (size_t i = 0; i != count; ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+    MC_MEASURE_END();
+}
+
+void motor_composition_batch(kln::motor const* a,
+                             kln::motor const* b,
+                             kln::motor* out,
+                             size_t count)
+{
+    MC_MEASURE_BEGIN(motor_composition_batch);
+    kln::multiply(a, b, out, count);
+    MC_MEASURE_END();
+}
+
+void motor_composition_broadcast(kln::motor const& a,
+                                 kln::motor const* b,
+                                 kln::motor* out,
+                                 size_t count)
+{
+    MC_MEASURE_BEGIN(motor_composition_broadcast);
+    kln::multiply(a, b, out, count);
+    MC_MEASURE_END();
+}
+
 kln::point motor_application(kln::motor const& m, kln::point const& p)
 {
     MC_MEASURE_BEGIN(motor_application);
@@ -47,4 +82,40 @@ kln::mat4x4 motor_to_mat4x4(kln::motor const& m)
     auto out = m.as_mat4x4();
     MC_MEASURE_END();
     return out;
-}
\ No newline at end of file
+}
+
+// Logarithm and exponential of many motors as a loop over the single-entity
+// routines versus the vectorized array entry points.
+void motor_log_loop(kln::motor const* in, kln::line* out, size_t count)
+{
+    MC_MEASURE_BEGIN(motor_log_loop);
+    for (size_t i = 0; i != count; ++i)
+    {
+        out[i] = kln::log(in[i]);
+    }
+    MC_MEASURE_END();
+}
+
+void motor_log_batch(kln::motor const* in, kln::line* out, size_t count)
+{
+    MC_MEASURE_BEGIN(motor_log_batch);
+    kln::log(in, out, count);
+    MC_MEASURE_END();
+}
+
+void line_exp_loop(kln::line const* in, kln::motor* out, size_t count)
+{
+    MC_MEASURE_BEGIN(line_exp_loop);
+    for (size_t i = 0; i != count; ++i)
+    {
+        out[i] = kln::exp(in[i]);
+    }
+    MC_MEASURE_END();
+}
+
+void line_exp_batch(kln::line const* in, kln::motor* out, size_t count)
+{
+    MC_MEASURE_BEGIN(line_exp_batch);
+    kln::exp(in, out, count);
+    MC_MEASURE_END();
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include "bundle.hpp"
+#include "exp_log.hpp"
+#include "geometric_product.hpp"
+#include "motor.hpp"
+#include "rotor.hpp"
+
+#include <cmath>
+
+namespace kln
+{
+/// \defgroup blend Interpolation and Blending
+///
+/// Interpolating between two rigid transforms can be done at several points
+/// along the accuracy/throughput curve.
+///
+/// - `sclerp` (screw linear interpolation) moves along the unique screw
+///   motion that takes one motor to the other. Velocity is constant, and the
+///   path is independent of the choice of origin. It costs a `log` and an
+///   `exp` per call.
+/// - `slerp` is the rotor-only equivalent, moving at constant angular
+///   velocity along the shortest arc.
+/// - `nlerp` and `blend` linearly combine the components and renormalize.
+///   This is not constant velocity, but it is cheap, commutative in the
+///   weights, and close to `sclerp` for the small per-frame deltas typical
+///   of animation. It is the method of choice for skinning and layered
+///   blending.
+///
+/// All routines presume their inputs are normalized and select the shortest
+/// path. The sign of the second argument is flipped when needed, since $m$
+/// and $-m$ encode the same transform.
+///
+/// ```cpp
+///     kln::motor a = ...;
+///     kln::motor b = ...;
+///     kln::motor m = kln::sclerp(a, b, 0.25f);
+///
+///     // Blend an array of joint transforms in one pass
+///     kln::blend(pose_a, pose_b, weights, out, joint_count);
+/// ```
+
+/// \addtogroup blend
+/// @{
+
+/// Screw linear interpolation between two normalized motors. Returns `a` at
+/// `t = 0` and `b` at `t = 1`.
+[[nodiscard]] inline motor KLN_VEC_CALL sclerp(motor a,
+                                               motor b,
+                                               float t) noexcept
+{
+    motor delta = b * ~a;
+    delta.constrain();
+    return exp(log(delta) * t) * a;
+}
+
+/// Spherical linear interpolation between two normalized rotors along the
+/// shortest arc. Returns `a` at `t = 0` and `b` at `t = 1`.
+[[nodiscard]] inline rotor KLN_VEC_CALL slerp(rotor a,
+                                              rotor b,
+                                              float t) noexcept
+{
+    float cos_ang;
+    _mm_store_ss(&cos_ang, detail::dp(a.p1_, b.p1_));
+    if (cos_ang < 0.f)
+    {
+        b       = -b;
+        cos_ang = -cos_ang;
+    }
+
+    float wa = 1.f - t;
+    float wb = t;
+    // Beyond this point, sin(ang) loses too much precision to divide by and
+    // linear interpolation is indistinguishable from the true arc.
+    if (cos_ang < 0.9995f)
+    {
+        float ang     = std::acos(cos_ang);
+        float inv_sin = 1.f / std::sin(ang);
+        wa            = std::sin(wa * ang) * inv_sin;
+        wb            = std::sin(wb * ang) * inv_sin;
+    }
+    rotor out = a * wa + b * wb;
+    out.normalize();
+    return out;
+}
+
+/// Normalized linear interpolation between two rotors along the shortest arc.
+[[nodiscard]] inline rotor KLN_VEC_CALL nlerp(rotor a,
+                                              rotor b,
+                                              float t) noexcept
+{
+    // Flip the sign of b's weight if the rotors lie in opposite hemispheres
+    __m128 sign = _mm_and_ps(detail::dp_bc(a.p1_, b.p1_), _mm_set1_ps(-0.f));
+    rotor out;
+    out.p1_ = _mm_add_ps(
+        _mm_mul_ps(a.p1_, _mm_set1_ps(1.f - t)),
+        _mm_mul_ps(b.p1_, _mm_xor_ps(_mm_set1_ps(t), sign)));
+    out.normalize();
+    return out;
+}
+
+/// Normalized linear interpolation between two motors along the shortest arc
+/// (also known as dual quaternion linear blending).
+[[nodiscard]] inline motor KLN_VEC_CALL nlerp(motor a,
+                                              motor b,
+                                              float t) noexcept
+{
+    __m128 sign = _mm_and_ps(detail::dp_bc(a.p1_, b.p1_), _mm_set1_ps(-0.f));
+    __m128 wa   = _mm_set1_ps(1.f - t);
+    __m128 wb   = _mm_xor_ps(_mm_set1_ps(t), sign);
+    motor out;
+    out.p1_ = _mm_add_ps(_mm_mul_ps(a.p1_, wa), _mm_mul_ps(b.p1_, wb));
+    out.p2_ = _mm_add_ps(_mm_mul_ps(a.p2_, wa), _mm_mul_ps(b.p2_, wb));
+    out.normalize();
+    return out;
+}
+
+/// Weighted blend of `count` motors, normalized once at the end. Each motor
+/// is aligned to the hemisphere of `motors[0]` before accumulation. The
+/// weights need not sum to one. Blending zero motors gives the identity.
+[[nodiscard]] inline motor blend(motor const* motors,
+                                 float const* weights,
+                                 size_t count) noexcept
+{
+    if (count == 0)
+    {
+        return motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+    }
+    __m128 ref = motors[0].p1_;
+    __m128 w   = _mm_set1_ps(weights[0]);
+    motor out;
+    out.p1_ = _mm_mul_ps(ref, w);
+    out.p2_ = _mm_mul_ps(motors[0].p2_, w);
+    for (size_t i = 1; i < count; ++i)
+    {
+        __m128 sign = _mm_and_ps(
+            detail::dp_bc(ref, motors[i].p1_), _mm_set1_ps(-0.f));
+        w       = _mm_xor_ps(_mm_set1_ps(weights[i]), sign);
+        out.p1_ = _mm_add_ps(out.p1_, _mm_mul_ps(motors[i].p1_, w));
+        out.p2_ = _mm_add_ps(out.p2_, _mm_mul_ps(motors[i].p2_, w));
+    }
+    out.normalize();
+    return out;
+}
+
+namespace detail
+{
+    // Loads up to eight floats, zero-filling the remaining lanes
+    KLN_INLINE float_x8 load_partial(float const* in, size_t count) noexcept
+    {
+        if (count == 8)
+        {
+            float_x8 out;
+            out.load(in);
+            return out;
+        }
+        float buf[8] = {};
+        for (size_t i = 0; i != count; ++i)
+        {
+            buf[i] = in[i];
+        }
+        float_x8 out;
+        out.load(buf);
+        return out;
+    }
+
+    // Sign mask (-0.f or 0.f per lane) of the dot product of the rotational
+    // parts of two motor bundles
+    KLN_INLINE float_x8 hemisphere(motor_x8 const& a,
+                                   motor_x8 const& b) noexcept
+    {
+        float_x8 d = a.scalar * b.scalar + a.e23 * b.e23 + a.e31 * b.e31
+                     + a.e12 * b.e12;
+        return and_x8(d, float_x8{-0.f});
+    }
+} // namespace detail
+
+/// Compute `out[i] = nlerp(a[i], b[i], t[i])` for `count` motors.
+///
+/// Motors are processed eight at a time in SoA form, so each group of eight
+/// shares a single vectorized reciprocal square root for normalization.
+/// `out` may alias `a` or `b`.
+inline void blend(motor const* a,
+                  motor const* b,
+                  float const* t,
+                  motor* out,
+                  size_t count) noexcept
+{
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        motor_x8 ma;
+        motor_x8 mb;
+        ma.load(a + i, n);
+        mb.load(b + i, n);
+        float_x8 wb = detail::load_partial(t + i, n);
+        float_x8 wa = float_x8{1.f} - wb;
+        wb          = detail::xor_x8(wb, detail::hemisphere(ma, mb));
+
+        motor_x8 m = ma * wa + mb * wb;
+        m.normalize();
+        m.store(out + i, n);
+    }
+}
+
+/// Weighted blend of `layer_count` arrays of `count` motors each (e.g. the
+/// joint transforms of several animation layers), where
+/// `out[i] = blend({layers[0][i], layers[1][i], ...}, weights, layer_count)`.
+///
+/// Every layer is accumulated before a single normalization per motor.
+/// `out` may alias any of the layers. With no layers, every output is the
+/// identity.
+inline void blend(motor const* const* layers,
+                  float const* weights,
+                  size_t layer_count,
+                  motor* out,
+                  size_t count) noexcept
+{
+    if (layer_count == 0)
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i] = motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+        }
+        return;
+    }
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        motor_x8 ref;
+        ref.load(layers[0] + i, n);
+        motor_x8 acc = ref * float_x8{weights[0]};
+        for (size_t j = 1; j < layer_count; ++j)
+        {
+            motor_x8 m;
+            m.load(layers[j] + i, n);
+            float_x8 w = detail::xor_x8(
+                float_x8{weights[j]}, detail::hemisphere(ref, m));
+            acc = acc + m * w;
+        }
+        acc.normalize();
+        acc.store(out + i, n);
+    }
+}
+/// @}
+} // namespace kln
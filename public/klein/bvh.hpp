@@ -0,0 +1,600 @@
+#pragma once
+
+#include "line.hpp"
+#include "motor.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace kln
+{
+/// \defgroup bvh Bounding Volume Hierarchies
+///
+/// A `kln::bvh` is a bounding volume hierarchy over axis-aligned boxes (or
+/// points) given in the local space of an object. Nodes are stored depth
+/// first in a flat array of 32-byte `kln::bvh_node`s, so the first child of
+/// an interior node immediately follows it and every box test is a pair of
+/// unaligned loads. Like `kln::skeleton`, a `kln::bvh` does not own memory.
+/// The caller provides the node and index arrays to `bvh::build` and keeps
+/// them alive for as long as the hierarchy is queried.
+///
+/// Queries are expressed as Klein entities: rays and lines as `kln::line`s,
+/// distance queries as `kln::point`s and splits as `kln::plane`s. Each has
+/// an overload accepting the normalized motor that places the object in
+/// the world. That overload moves the query into the object's local space
+/// with the reverse motor's sandwich, rather than transforming the geometry
+/// (or computing a matrix inverse). Parameters and distances are preserved
+/// by rigid motions, so results need no transformation back.
+///
+/// Primitives are reported to a callback along with the query in local
+/// space, so the callback can test its own geometry exactly.
+///
+/// ```cpp
+///     // Offline, or when the mesh changes
+///     std::vector<kln::bvh_node> nodes(kln::bvh::max_nodes(tri_count));
+///     std::vector<uint32_t> indices(tri_count);
+///     size_t node_count = kln::bvh::build(
+///         tri_min, tri_max, tri_count, nodes.data(), indices.data());
+///     kln::bvh tree{nodes.data(), node_count, indices.data()};
+///
+///     // Per query, for each instance of the mesh
+///     float t = tree.raycast(
+///         instance_motor,
+///         eye,
+///         eye & target,
+///         [&](uint32_t tri, kln::point const& o, kln::line const& ray) {
+///             return intersect_triangle(tri, o, ray); // Or infinity
+///         });
+/// ```
+///
+/// The direction of a line is its $(\mathbf{e}_{23}, \mathbf{e}_{31},
+/// \mathbf{e}_{12})$ part $\mathbf{d}$, and parameters are measured as in
+/// the \ref ray group: a point $O + t\mathbf{d}$ on the line has parameter
+/// $t$ from $O$.
+
+/// \addtogroup bvh
+/// @{
+
+/// A node of a `kln::bvh`, holding the bounds of its subtree
+struct bvh_node
+{
+    float min[3];
+
+    /// Index of the second child of an interior node (the first child is the
+    /// next node), or of the first entry of a leaf in the index array
+    uint32_t offset;
+
+    float max[3];
+
+    /// Number of primitives in a leaf, or zero for an interior node
+    uint32_t count;
+};
+
+static_assert(sizeof(bvh_node) == 32, "bvh_node must be 32 bytes");
+
+namespace detail
+{
+    KLN_INLINE float coord(point const& p, int axis) noexcept
+    {
+        return axis == 0 ? p.x() : axis == 1 ? p.y() : p.z();
+    }
+
+    // (x, y, z, 0) of a normalized point, or of the direction of a line
+    KLN_INLINE __m128 KLN_VEC_CALL xyz(point const& p) noexcept
+    {
+        return _mm_set_ps(0.f, p.z(), p.y(), p.x());
+    }
+
+    // Maximum and minimum of lanes 0 to 2
+    KLN_INLINE float KLN_VEC_CALL hmax3(__m128 a) noexcept
+    {
+        __m128 m = _mm_max_ps(a, KLN_SWIZZLE(a, 0, 0, 0, 1));
+        return _mm_cvtss_f32(_mm_max_ss(m, KLN_SWIZZLE(a, 0, 0, 0, 2)));
+    }
+
+    KLN_INLINE float KLN_VEC_CALL hmin3(__m128 a) noexcept
+    {
+        __m128 m = _mm_min_ps(a, KLN_SWIZZLE(a, 0, 0, 0, 1));
+        return _mm_cvtss_f32(_mm_min_ss(m, KLN_SWIZZLE(a, 0, 0, 0, 2)));
+    }
+
+    // Slab test of the line o + t d (with inv_d = 1 / d) against the box of
+    // a node. The parameter interval inside the box is [t_near, t_far],
+    // which is empty if t_near > t_far. A line parallel to an axis that lies
+    // exactly on a face of the box produces 0 * inf = NaN in that lane. Such
+    // lanes are widened to the unbounded interval, so lines grazing a face
+    // (or lying in a flat box) are treated as passing through it.
+    KLN_INLINE void KLN_VEC_CALL slab(bvh_node const& n,
+                                      __m128 o,
+                                      __m128 inv_d,
+                                      float& t_near,
+                                      float& t_far) noexcept
+    {
+        __m128 a    = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(n.min), o), inv_d);
+        __m128 b    = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(n.max), o), inv_d);
+        __m128 nan  = _mm_cmpunord_ps(a, b);
+        __m128 inf  = _mm_set1_ps(std::numeric_limits<float>::infinity());
+        __m128 ninf = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+        __m128 lo   = _mm_or_ps(_mm_andnot_ps(nan, _mm_min_ps(a, b)),
+                               _mm_and_ps(nan, ninf));
+        __m128 hi   = _mm_or_ps(_mm_andnot_ps(nan, _mm_max_ps(a, b)),
+                               _mm_and_ps(nan, inf));
+        t_near      = hmax3(lo);
+        t_far       = hmin3(hi);
+    }
+
+    // Squared distance from p to the box of a node (zero inside)
+    KLN_INLINE float KLN_VEC_CALL box_distance2(bvh_node const& n,
+                                                __m128 p) noexcept
+    {
+        __m128 v = _mm_max_ps(_mm_sub_ps(_mm_loadu_ps(n.min), p),
+                              _mm_sub_ps(p, _mm_loadu_ps(n.max)));
+        v        = _mm_max_ps(v, _mm_setzero_ps());
+        v        = _mm_mul_ps(v, v);
+        return _mm_cvtss_f32(v) + _mm_cvtss_f32(KLN_SWIZZLE(v, 1, 1, 1, 1))
+               + _mm_cvtss_f32(KLN_SWIZZLE(v, 2, 2, 2, 2));
+    }
+
+    // Origin and direction of a line, with the origin at the point of the
+    // line nearest the world origin, d x m / |d|^2
+    KLN_INLINE void KLN_VEC_CALL line_frame(line const& l,
+                                            __m128& o,
+                                            __m128& d) noexcept
+    {
+        float dx  = l.e23();
+        float dy  = l.e31();
+        float dz  = l.e12();
+        float mx  = l.e01();
+        float my  = l.e02();
+        float mz  = l.e03();
+        float inv = 1.f / (dx * dx + dy * dy + dz * dz);
+        o         = _mm_set_ps(0.f,
+                       (dx * my - dy * mx) * inv,
+                       (dz * mx - dx * mz) * inv,
+                       (dy * mz - dz * my) * inv);
+        d         = _mm_set_ps(0.f, dz, dy, dx);
+    }
+
+    KLN_INLINE __m128 KLN_VEC_CALL inverse_direction(__m128 d) noexcept
+    {
+        // Lane 3 becomes 1 / 1 so the unused lane stays finite
+        d = _mm_add_ps(d, _mm_set_ps(1.f, 0.f, 0.f, 0.f));
+        return _mm_div_ps(_mm_set1_ps(1.f), d);
+    }
+
+    // Depth of the traversal stack. Median splits bound the depth of a
+    // hierarchy of n primitives by log2(n) + 1.
+    constexpr size_t bvh_stack_size = 64;
+} // namespace detail
+
+/// Non-owning view of a bounding volume hierarchy
+class bvh final
+{
+public:
+    bvh() noexcept = default;
+
+    /// View the `node_count` nodes and the index array written by `build`
+    bvh(bvh_node const* nodes,
+        size_t node_count,
+        uint32_t const* indices) noexcept
+        : nodes_{nodes}
+        , node_count_{node_count}
+        , indices_{indices}
+    {}
+
+    /// Capacity of the node array needed to build a hierarchy over `count`
+    /// primitives
+    [[nodiscard]] static size_t max_nodes(size_t count) noexcept
+    {
+        return count == 0 ? 0 : 2 * count - 1;
+    }
+
+    /// Build a hierarchy over `count` boxes, the `i`-th spanning `min[i]`
+    /// to `max[i]`, by splitting at the median centroid along the longest
+    /// axis until at most `leaf_size` boxes remain. `nodes` must hold
+    /// `max_nodes(count)` entries and `indices` must hold `count`. Returns
+    /// the number of nodes written.
+    static size_t build(point const* min,
+                        point const* max,
+                        size_t count,
+                        bvh_node* nodes,
+                        uint32_t* indices,
+                        size_t leaf_size = 4) noexcept
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+        for (size_t i = 0; i != count; ++i)
+        {
+            indices[i] = static_cast<uint32_t>(i);
+        }
+        size_t node_count = 0;
+        build_node(min,
+                   max,
+                   indices,
+                   0,
+                   count,
+                   leaf_size < 1 ? 1 : leaf_size,
+                   nodes,
+                   node_count);
+        return node_count;
+    }
+
+    /// Build a hierarchy over `count` points. See the overload for boxes.
+    static size_t build(point const* points,
+                        size_t count,
+                        bvh_node* nodes,
+                        uint32_t* indices,
+                        size_t leaf_size = 4) noexcept
+    {
+        return build(points, points, count, nodes, indices, leaf_size);
+    }
+
+    /// Number of nodes
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return node_count_;
+    }
+
+    [[nodiscard]] bvh_node const* nodes() const noexcept
+    {
+        return nodes_;
+    }
+
+    /// Call `f(primitive, l)` for each primitive whose box the line `l`
+    /// passes through. Lines that only graze a face of a box (including
+    /// lines lying in a flat box) count as passing through it.
+    template <typename F>
+    void intersect(line const& l, F&& f) const
+    {
+        if (node_count_ == 0)
+        {
+            return;
+        }
+        __m128 o;
+        __m128 d;
+        detail::line_frame(l, o, d);
+        __m128 inv_d = detail::inverse_direction(d);
+
+        uint32_t stack[detail::bvh_stack_size];
+        size_t top   = 0;
+        stack[top++] = 0;
+        while (top != 0)
+        {
+            bvh_node const& n = nodes_[stack[--top]];
+            float t_near;
+            float t_far;
+            detail::slab(n, o, inv_d, t_near, t_far);
+            if (t_near > t_far)
+            {
+                continue;
+            }
+            if (n.count == 0)
+            {
+                stack[top++] = n.offset;
+                stack[top++] = static_cast<uint32_t>(&n - nodes_) + 1;
+            }
+            else
+            {
+                for (uint32_t i = 0; i != n.count; ++i)
+                {
+                    f(indices_[n.offset + i], l);
+                }
+            }
+        }
+    }
+
+    /// As `intersect(l, f)` for the line `l` in world space, where `instance`
+    /// places the hierarchy in the world. `f` receives the line in local
+    /// space.
+    template <typename F>
+    void intersect(motor const& instance, line const& l, F&& f) const
+    {
+        intersect((~instance)(l), f);
+    }
+
+    /// Find the closest hit of the ray from `origin` along the line `ray`.
+    /// `f(primitive, origin, ray)` returns the parameter of the hit with the
+    /// primitive, or infinity for a miss, and is only called for primitives
+    /// whose box is entered before the closest hit found so far. Children
+    /// are visited nearest first. Returns the parameter of the closest hit,
+    /// or infinity.
+    template <typename F>
+    float raycast(point const& origin, line const& ray, F&& f) const
+    {
+        float best = std::numeric_limits<float>::infinity();
+        if (node_count_ == 0)
+        {
+            return best;
+        }
+        __m128 o     = detail::xyz(origin);
+        __m128 inv_d = detail::inverse_direction(
+            _mm_set_ps(0.f, ray.e12(), ray.e31(), ray.e23()));
+
+        // Nodes are pushed with the parameter at which the ray enters them
+        uint32_t stack[detail::bvh_stack_size];
+        float entry[detail::bvh_stack_size];
+        size_t top = 0;
+        float t_near;
+        float t_far;
+        detail::slab(nodes_[0], o, inv_d, t_near, t_far);
+        if (t_near > t_far || t_far < 0.f)
+        {
+            return best;
+        }
+        stack[top]   = 0;
+        entry[top++] = t_near;
+        while (top != 0)
+        {
+            --top;
+            if (entry[top] > best)
+            {
+                continue;
+            }
+            bvh_node const& n = nodes_[stack[top]];
+            if (n.count != 0)
+            {
+                for (uint32_t i = 0; i != n.count; ++i)
+                {
+                    float t = f(indices_[n.offset + i], origin, ray);
+                    best    = t < best ? t : best;
+                }
+                continue;
+            }
+
+            uint32_t child[2] = {static_cast<uint32_t>(&n - nodes_) + 1,
+                                 n.offset};
+            float child_near[2];
+            bool hit[2];
+            for (size_t i = 0; i != 2; ++i)
+            {
+                detail::slab(nodes_[child[i]], o, inv_d, t_near, t_far);
+                child_near[i] = t_near < 0.f ? 0.f : t_near;
+                hit[i]        = t_near <= t_far && t_far >= 0.f
+                         && child_near[i] <= best;
+            }
+            // Push the farther child first so the nearer one is popped next
+            size_t first = child_near[1] < child_near[0] ? 1 : 0;
+            for (size_t i = 0; i != 2; ++i)
+            {
+                size_t c = i == 0 ? 1 - first : first;
+                if (hit[c])
+                {
+                    stack[top]   = child[c];
+                    entry[top++] = child_near[c];
+                }
+            }
+        }
+        return best;
+    }
+
+    /// As `raycast(origin, ray, f)` for a ray in world space, where
+    /// `instance` places the hierarchy in the world. `f` receives the ray in
+    /// local space, and the returned parameter is the same in both spaces.
+    template <typename F>
+    float raycast(motor const& instance,
+                  point const& origin,
+                  line const& ray,
+                  F&& f) const
+    {
+        motor to_local = ~instance;
+        return raycast(to_local(origin), to_local(ray), f);
+    }
+
+    /// Find the primitive nearest to `p` within `max_distance`.
+    /// `f(primitive, p)` returns the distance from `p` to the primitive, and
+    /// is only called for primitives whose box is closer than the nearest
+    /// primitive found so far. Returns the smallest distance found, or
+    /// `max_distance` if there is none closer.
+    template <typename F>
+    float nearest(point const& p, float max_distance, F&& f) const
+    {
+        float best = max_distance;
+        if (node_count_ == 0)
+        {
+            return best;
+        }
+        __m128 q = detail::xyz(p);
+
+        uint32_t stack[detail::bvh_stack_size];
+        float entry[detail::bvh_stack_size];
+        size_t top   = 0;
+        stack[top]   = 0;
+        entry[top++] = detail::box_distance2(nodes_[0], q);
+        while (top != 0)
+        {
+            --top;
+            if (entry[top] >= best * best)
+            {
+                continue;
+            }
+            bvh_node const& n = nodes_[stack[top]];
+            if (n.count != 0)
+            {
+                for (uint32_t i = 0; i != n.count; ++i)
+                {
+                    float dist = f(indices_[n.offset + i], p);
+                    best       = dist < best ? dist : best;
+                }
+                continue;
+            }
+
+            uint32_t child[2] = {static_cast<uint32_t>(&n - nodes_) + 1,
+                                 n.offset};
+            float d2[2]       = {detail::box_distance2(nodes_[child[0]], q),
+                           detail::box_distance2(nodes_[child[1]], q)};
+            size_t first      = d2[1] < d2[0] ? 1 : 0;
+            stack[top]        = child[1 - first];
+            entry[top++]      = d2[1 - first];
+            stack[top]        = child[first];
+            entry[top++]      = d2[first];
+        }
+        return best;
+    }
+
+    /// As `nearest(p, max_distance, f)` for a point in world space, where
+    /// `instance` places the hierarchy in the world
+    template <typename F>
+    float nearest(motor const& instance,
+                  point const& p,
+                  float max_distance,
+                  F&& f) const
+    {
+        return nearest((~instance)(p), max_distance, f);
+    }
+
+    /// Classify every primitive against the plane `p`, calling
+    /// `f(primitive, side, p)` where `side` is `1` or `-1` if the primitive's
+    /// bounds lie entirely on the positive or negative side of the plane
+    /// (where `p ^ point` is positive or negative), and `0` if they may
+    /// straddle it. Whole subtrees on one side are reported without further
+    /// box tests. The plane need not be normalized.
+    template <typename F>
+    void split(plane const& p, F&& f) const
+    {
+        if (node_count_ == 0)
+        {
+            return;
+        }
+        __m128 n  = _mm_set_ps(0.f, p.z(), p.y(), p.x());
+        __m128 an = _mm_andnot_ps(_mm_set1_ps(-0.f), n);
+        float d   = p.d();
+
+        // Each entry carries the side of its subtree if already known
+        uint32_t stack[detail::bvh_stack_size];
+        int side[detail::bvh_stack_size];
+        size_t top = 0;
+        stack[top] = 0;
+        side[top++] = 0;
+        while (top != 0)
+        {
+            --top;
+            bvh_node const& node = nodes_[stack[top]];
+            int s                = side[top];
+            if (s == 0)
+            {
+                __m128 lo     = _mm_loadu_ps(node.min);
+                __m128 hi     = _mm_loadu_ps(node.max);
+                __m128 half   = _mm_set1_ps(0.5f);
+                __m128 center = _mm_mul_ps(_mm_add_ps(lo, hi), half);
+                __m128 extent = _mm_mul_ps(_mm_sub_ps(hi, lo), half);
+                float dist    = dot3(n, center) + d;
+                float reach   = dot3(an, extent);
+                s             = dist > reach ? 1 : dist < -reach ? -1 : 0;
+            }
+            if (node.count != 0)
+            {
+                for (uint32_t i = 0; i != node.count; ++i)
+                {
+                    f(indices_[node.offset + i], s, p);
+                }
+                continue;
+            }
+            stack[top]  = node.offset;
+            side[top++] = s;
+            stack[top]  = static_cast<uint32_t>(&node - nodes_) + 1;
+            side[top++] = s;
+        }
+    }
+
+    /// As `split(p, f)` for a plane in world space, where `instance` places
+    /// the hierarchy in the world. `f` receives the plane in local space.
+    template <typename F>
+    void split(motor const& instance, plane const& p, F&& f) const
+    {
+        split((~instance)(p), f);
+    }
+
+private:
+    static float KLN_VEC_CALL dot3(__m128 a, __m128 b) noexcept
+    {
+        __m128 v = _mm_mul_ps(a, b);
+        return _mm_cvtss_f32(v) + _mm_cvtss_f32(KLN_SWIZZLE(v, 1, 1, 1, 1))
+               + _mm_cvtss_f32(KLN_SWIZZLE(v, 2, 2, 2, 2));
+    }
+
+    static void build_node(point const* min,
+                           point const* max,
+                           uint32_t* indices,
+                           size_t first,
+                           size_t last,
+                           size_t leaf_size,
+                           bvh_node* nodes,
+                           size_t& node_count) noexcept
+    {
+        bvh_node& n = nodes[node_count++];
+
+        // Bounds of the boxes and of their centroids
+        float lo[3];
+        float hi[3];
+        float clo[3];
+        float chi[3];
+        for (int a = 0; a != 3; ++a)
+        {
+            lo[a]  = std::numeric_limits<float>::infinity();
+            hi[a]  = -lo[a];
+            clo[a] = lo[a];
+            chi[a] = hi[a];
+        }
+        for (size_t i = first; i != last; ++i)
+        {
+            for (int a = 0; a != 3; ++a)
+            {
+                float l = detail::coord(min[indices[i]], a);
+                float h = detail::coord(max[indices[i]], a);
+                lo[a]   = std::min(lo[a], l);
+                hi[a]   = std::max(hi[a], h);
+                clo[a]  = std::min(clo[a], l + h);
+                chi[a]  = std::max(chi[a], l + h);
+            }
+        }
+        for (int a = 0; a != 3; ++a)
+        {
+            n.min[a] = lo[a];
+            n.max[a] = hi[a];
+        }
+
+        size_t count = last - first;
+        if (count <= leaf_size)
+        {
+            n.offset = static_cast<uint32_t>(first);
+            n.count  = static_cast<uint32_t>(count);
+            return;
+        }
+
+        int axis = 0;
+        for (int a = 1; a != 3; ++a)
+        {
+            if (chi[a] - clo[a] > chi[axis] - clo[axis])
+            {
+                axis = a;
+            }
+        }
+        size_t mid = first + count / 2;
+        std::nth_element(indices + first,
+                         indices + mid,
+                         indices + last,
+                         [&](uint32_t a, uint32_t b) {
+                             return detail::coord(min[a], axis)
+                                        + detail::coord(max[a], axis)
+                                    < detail::coord(min[b], axis)
+                                          + detail::coord(max[b], axis);
+                         });
+
+        build_node(min, max, indices, first, mid, leaf_size, nodes, node_count);
+        n.offset = static_cast<uint32_t>(node_count);
+        n.count  = 0;
+        build_node(min, max, indices, mid, last, leaf_size, nodes, node_count);
+    }
+
+    bvh_node const* nodes_ = nullptr;
+    size_t node_count_     = 0;
+    uint32_t const* indices_ = nullptr;
+};
+/// @}
+} // namespace kln
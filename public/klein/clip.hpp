@@ -0,0 +1,447 @@
+#pragma once
+
+#include "exp_log.hpp"
+#include "geometric_product.hpp"
+#include "motor.hpp"
+#include "packed.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace kln
+{
+/// \defgroup clip Animation Clips
+///
+/// A `kln::clip` is a non-owning view of an animation clip serialized in a
+/// flat, versioned binary format. Every section of the format is 16-byte
+/// aligned relative to the start of the clip and is read in place, so a clip
+/// file can be memory mapped and sampled immediately without parsing or
+/// copying its keys to the heap. Opening a clip only validates the header
+/// and track table.
+///
+/// A clip holds one track per joint. Each track has its own sorted key times
+/// (in seconds) and a key per time, stored either as full `kln::motor`s or as
+/// 12-byte `kln::packed_motor`s (see \ref packed). The layout is, with
+/// offsets relative to the start of the clip:
+///
+/// | Section | Contents                                              |
+/// |---------|-------------------------------------------------------|
+/// | Header  | `kln::clip_header`                                    |
+/// | Tracks  | `kln::clip_track_info[track_count]`                   |
+/// | Times   | `float[key_count]`, grouped by track                  |
+/// | Keys    | `motor[key_count]` or `packed_motor[key_count]`       |
+///
+/// All values are little-endian.
+///
+/// ```cpp
+///     // Offline: serialize tracks of key times and motors
+///     size_t size = kln::clip::size(tracks, joint_count, encoding);
+///     kln::clip::write(buffer, tracks, joint_count, encoding);
+///
+///     // At load: map the file and view it
+///     void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+///     kln::clip c{data, size};
+///     if (!c.valid()) { ... }
+///
+///     // Per frame: sample straight into the local motors of a pose
+///     c.sample(time, pose.local());
+///     pose.evaluate();
+/// ```
+
+/// \addtogroup clip
+/// @{
+
+/// Encoding of the keys of a clip
+enum class clip_encoding : uint16_t
+{
+    /// 32 bytes per key
+    motor = 0,
+    /// 12 bytes per key, see `kln::packed_motor`
+    packed = 1
+};
+
+/// Serialized clip header
+struct clip_header
+{
+    /// "KLNC"
+    uint32_t magic;
+    uint16_t version;
+    /// A `kln::clip_encoding`
+    uint16_t encoding;
+    uint32_t track_count;
+    /// Total number of keys over all tracks
+    uint32_t key_count;
+    /// Time of the last key of the longest track
+    float duration;
+    /// Byte offsets of the sections from the start of the clip
+    uint32_t tracks_offset;
+    uint32_t times_offset;
+    uint32_t keys_offset;
+    /// Total size of the clip in bytes
+    uint64_t size;
+    /// Translation range of packed keys as (min x, min y, min z, max x,
+    /// max y, max z). Unused for full motors.
+    float range[6];
+};
+
+static_assert(sizeof(clip_header) == 64, "clip_header must be 64 bytes");
+
+/// Serialized per-track entry of the track table
+struct clip_track_info
+{
+    /// Index of the first key (and time) of the track
+    uint32_t first_key;
+    /// Number of keys, at least one
+    uint32_t key_count;
+};
+
+/// Input to `kln::clip::write` describing a single track
+struct clip_track
+{
+    /// `key_count` sorted key times
+    float const* times;
+    /// `key_count` normalized motors
+    motor const* keys;
+    uint32_t key_count;
+};
+
+/// Non-owning view of a serialized animation clip.
+class clip final
+{
+public:
+    /// Tag at the start of every clip, "KLNC" in little-endian byte order
+    static constexpr uint32_t magic = 0x434e4c4b;
+    /// Format version written by `kln::clip::write`
+    static constexpr uint16_t version = 1;
+
+    clip() noexcept = default;
+
+    /// View the `byte_count` bytes at `data`, which must be 16-byte aligned
+    /// (as a memory mapping is) and outlive the view. The view is invalid if
+    /// the header or track table is malformed or does not fit in the given
+    /// bytes.
+    clip(void const* data, size_t byte_count) noexcept
+    {
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        if (bytes == nullptr || byte_count < sizeof(clip_header)
+            || reinterpret_cast<uintptr_t>(bytes) % 16 != 0)
+        {
+            return;
+        }
+
+        clip_header const* h = reinterpret_cast<clip_header const*>(bytes);
+        uint64_t key_size    = key_stride(h->encoding);
+        if (h->magic != magic || h->version != version || key_size == 0
+            || h->size > byte_count
+            || !fits(h->tracks_offset,
+                     uint64_t{h->track_count} * sizeof(clip_track_info),
+                     h->size)
+            || !fits(h->times_offset,
+                     uint64_t{h->key_count} * sizeof(float),
+                     h->size)
+            || !fits(h->keys_offset,
+                     uint64_t{h->key_count} * key_size,
+                     h->size))
+        {
+            return;
+        }
+
+        auto const* tracks = reinterpret_cast<clip_track_info const*>(
+            bytes + h->tracks_offset);
+        for (uint32_t i = 0; i != h->track_count; ++i)
+        {
+            if (tracks[i].key_count == 0
+                || uint64_t{tracks[i].first_key} + tracks[i].key_count
+                       > h->key_count)
+            {
+                return;
+            }
+        }
+
+        header_ = h;
+        tracks_ = tracks;
+        times_  = reinterpret_cast<float const*>(bytes + h->times_offset);
+        keys_   = bytes + h->keys_offset;
+        if (encoding() == clip_encoding::packed)
+        {
+            range_ = packed_range{h->range[0],
+                                  h->range[1],
+                                  h->range[2],
+                                  h->range[3],
+                                  h->range[4],
+                                  h->range[5]};
+        }
+    }
+
+    /// Number of bytes needed to serialize `track_count` tracks
+    [[nodiscard]] static size_t size(clip_track const* tracks,
+                                     uint32_t track_count,
+                                     clip_encoding encoding) noexcept
+    {
+        layout l = compute_layout(tracks, track_count, encoding);
+        return static_cast<size_t>(l.size);
+    }
+
+    /// Serialize `track_count` tracks to `dst`, which must be 16-byte aligned
+    /// and hold at least `size(tracks, track_count, encoding)` bytes. Returns
+    /// a view of the written clip.
+    static clip write(void* dst,
+                      clip_track const* tracks,
+                      uint32_t track_count,
+                      clip_encoding encoding) noexcept
+    {
+        layout l             = compute_layout(tracks, track_count, encoding);
+        unsigned char* bytes = static_cast<unsigned char*>(dst);
+        std::memset(bytes, 0, static_cast<size_t>(l.size));
+
+        clip_header h;
+        std::memset(&h, 0, sizeof(h));
+        h.magic         = magic;
+        h.version       = version;
+        h.encoding      = static_cast<uint16_t>(encoding);
+        h.track_count   = track_count;
+        h.key_count     = l.key_count;
+        h.tracks_offset = l.tracks_offset;
+        h.times_offset  = l.times_offset;
+        h.keys_offset   = l.keys_offset;
+        h.size          = l.size;
+
+        // Fit the translation range of packed keys to every key of the clip
+        __m128 lo  = _mm_setzero_ps();
+        __m128 hi  = _mm_setzero_ps();
+        bool first = true;
+        for (uint32_t i = 0; i != track_count; ++i)
+        {
+            for (uint32_t j = 0; j != tracks[i].key_count; ++j)
+            {
+                // A translator stores half the negated displacement
+                __m128 t = _mm_mul_ps(
+                    detail::translator_part(tracks[i].keys[j]),
+                    _mm_set_ps(-2.f, -2.f, -2.f, 0.f));
+                lo    = first ? t : _mm_min_ps(lo, t);
+                hi    = first ? t : _mm_max_ps(hi, t);
+                first = false;
+            }
+        }
+        float lo_f[4];
+        float hi_f[4];
+        _mm_storeu_ps(lo_f, lo);
+        _mm_storeu_ps(hi_f, hi);
+        packed_range range{
+            lo_f[1], lo_f[2], lo_f[3], hi_f[1], hi_f[2], hi_f[3]};
+        if (encoding == clip_encoding::packed)
+        {
+            std::memcpy(h.range, lo_f + 1, 3 * sizeof(float));
+            std::memcpy(h.range + 3, hi_f + 1, 3 * sizeof(float));
+        }
+
+        uint32_t key = 0;
+        for (uint32_t i = 0; i != track_count; ++i)
+        {
+            clip_track const& t = tracks[i];
+            clip_track_info info{key, t.key_count};
+            std::memcpy(bytes + l.tracks_offset + i * sizeof(info),
+                        &info,
+                        sizeof(info));
+            std::memcpy(bytes + l.times_offset + key * sizeof(float),
+                        t.times,
+                        t.key_count * sizeof(float));
+            if (t.key_count != 0 && t.times[t.key_count - 1] > h.duration)
+            {
+                h.duration = t.times[t.key_count - 1];
+            }
+
+            if (encoding == clip_encoding::packed)
+            {
+                pack(range,
+                     t.keys,
+                     reinterpret_cast<packed_motor*>(
+                         bytes + l.keys_offset
+                         + key * sizeof(packed_motor)),
+                     t.key_count);
+            }
+            else
+            {
+                std::memcpy(bytes + l.keys_offset + key * sizeof(motor),
+                            t.keys,
+                            t.key_count * sizeof(motor));
+            }
+            key += t.key_count;
+        }
+
+        std::memcpy(bytes, &h, sizeof(h));
+        return clip{dst, static_cast<size_t>(l.size)};
+    }
+
+    [[nodiscard]] bool valid() const noexcept
+    {
+        return header_ != nullptr;
+    }
+
+    [[nodiscard]] uint32_t track_count() const noexcept
+    {
+        return header_->track_count;
+    }
+
+    [[nodiscard]] float duration() const noexcept
+    {
+        return header_->duration;
+    }
+
+    [[nodiscard]] clip_encoding encoding() const noexcept
+    {
+        return static_cast<clip_encoding>(header_->encoding);
+    }
+
+    [[nodiscard]] uint32_t key_count(uint32_t track) const noexcept
+    {
+        return tracks_[track].key_count;
+    }
+
+    /// Sorted key times of a track
+    [[nodiscard]] float const* times(uint32_t track) const noexcept
+    {
+        return times_ + tracks_[track].first_key;
+    }
+
+    /// Decode key `index` of a track
+    [[nodiscard]] motor key(uint32_t track, uint32_t index) const noexcept
+    {
+        return load_key(tracks_[track].first_key + index);
+    }
+
+    /// Sample every track at `time`, writing `track_count()` motors to `out`
+    /// (typically `pose::local()`).
+    ///
+    /// The keys bracketing `time` are found by binary search in each track
+    /// and interpolated along the screw motion between them, as `sclerp`
+    /// does. The logarithms and exponentials are batched across tracks.
+    /// Times outside of a track's keys clamp to its first or last key.
+    void sample(float time, motor* out) const noexcept
+    {
+        // Per-chunk scratch lives on the stack so sampling never allocates
+        constexpr uint32_t chunk = 64;
+        motor from[chunk];
+        motor delta[chunk];
+        line axis[chunk];
+        float t[chunk];
+
+        uint32_t count = header_->track_count;
+        for (uint32_t base = 0; base < count; base += chunk)
+        {
+            uint32_t n = count - base < chunk ? count - base : chunk;
+            for (uint32_t i = 0; i != n; ++i)
+            {
+                clip_track_info const& info = tracks_[base + i];
+                float const* first          = times_ + info.first_key;
+                float const* last           = first + info.key_count;
+
+                // First key with a time greater than the sample time
+                float const* next = std::upper_bound(first, last, time);
+                if (next == first || next == last)
+                {
+                    uint32_t k = next == first ? 0 : info.key_count - 1;
+                    from[i]    = load_key(info.first_key + k);
+                    delta[i]   = motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+                    t[i]       = 0.f;
+                    continue;
+                }
+
+                uint32_t k = static_cast<uint32_t>(next - first) - 1;
+                from[i]    = load_key(info.first_key + k);
+                delta[i]   = load_key(info.first_key + k + 1) * ~from[i];
+                delta[i].constrain();
+                t[i] = (time - first[k]) / (first[k + 1] - first[k]);
+            }
+
+            log(delta, axis, n);
+            for (uint32_t i = 0; i != n; ++i)
+            {
+                axis[i] = axis[i] * t[i];
+            }
+            exp(axis, out + base, n);
+            multiply(out + base, from, out + base, n);
+        }
+    }
+
+private:
+    struct layout
+    {
+        uint32_t key_count;
+        uint32_t tracks_offset;
+        uint32_t times_offset;
+        uint32_t keys_offset;
+        uint64_t size;
+    };
+
+    static uint64_t align16(uint64_t offset) noexcept
+    {
+        return (offset + 15) & ~uint64_t{15};
+    }
+
+    static uint64_t key_stride(uint16_t encoding) noexcept
+    {
+        return encoding == static_cast<uint16_t>(clip_encoding::motor)
+                   ? sizeof(motor)
+                   : encoding == static_cast<uint16_t>(clip_encoding::packed)
+                         ? sizeof(packed_motor)
+                         : 0;
+    }
+
+    // True if the section [offset, offset + size) lies within the clip and
+    // starts on a 16-byte boundary
+    static bool fits(uint32_t offset, uint64_t size, uint64_t total) noexcept
+    {
+        return offset % 16 == 0 && offset >= sizeof(clip_header)
+               && uint64_t{offset} + size <= total;
+    }
+
+    static layout compute_layout(clip_track const* tracks,
+                                 uint32_t track_count,
+                                 clip_encoding encoding) noexcept
+    {
+        layout l;
+        l.key_count = 0;
+        for (uint32_t i = 0; i != track_count; ++i)
+        {
+            l.key_count += tracks[i].key_count;
+        }
+
+        uint64_t offset = sizeof(clip_header);
+        l.tracks_offset = static_cast<uint32_t>(offset);
+        offset          = align16(offset + uint64_t{track_count}
+                                      * sizeof(clip_track_info));
+        l.times_offset  = static_cast<uint32_t>(offset);
+        offset = align16(offset + uint64_t{l.key_count} * sizeof(float));
+        l.keys_offset = static_cast<uint32_t>(offset);
+        offset        = align16(offset
+                         + uint64_t{l.key_count}
+                               * key_stride(static_cast<uint16_t>(encoding)));
+        l.size = offset;
+        return l;
+    }
+
+    motor load_key(uint32_t index) const noexcept
+    {
+        if (encoding() == clip_encoding::packed)
+        {
+            motor out;
+            detail::unpack(
+                reinterpret_cast<packed_motor const*>(keys_)[index],
+                range_,
+                out);
+            return out;
+        }
+        return reinterpret_cast<motor const*>(keys_)[index];
+    }
+
+    clip_header const* header_     = nullptr;
+    clip_track_info const* tracks_ = nullptr;
+    float const* times_            = nullptr;
+    unsigned char const* keys_     = nullptr;
+    packed_range range_;
+};
+/// @}
+} // namespace kln
@@ -0,0 +1,311 @@
+#pragma once
+
+#include "bundle.hpp"
+#include "float_x8.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef KLEIN_VALIDATE
+#    include <cassert>
+#endif
+
+namespace kln
+{
+/// \defgroup convex_volume Convex Volumes
+///
+/// A `kln::convex_volume` is the intersection of the positive half-spaces of
+/// up to 16 planes, such as a camera frustum or the convex hull of an
+/// occluder. A point $P$ lies on the positive side of a plane $p$ when the
+/// $\mathbf{e}_{0123}$ coefficient of $p\wedge P$ (that is,
+/// $ax + by + cz + d$ for a normalized point) is non-negative, so the plane
+/// normals of a volume should point inward.
+///
+/// The planes are normalized on construction and stored in SoA form. Tests
+/// of a single entity evaluate eight planes per instruction. The batched
+/// tests instead process eight entities per instruction and walk the planes,
+/// stopping as soon as all eight entities have been rejected. Their results
+/// are written as bitmasks where bit `i % 32` of `out[i / 32]` is set if the
+/// `i`-th entity is inside (or intersects) the volume. The output array must
+/// hold `(count + 31) / 32` words.
+///
+/// ```cpp
+///     // An axis-aligned frustum looking down -z from the origin
+///     kln::plane planes[6] = {
+///         {0.f, 0.f, -1.f, -0.1f},  // Near
+///         {0.f, 0.f, 1.f, 100.f},   // Far
+///         {1.f, 0.f, -1.f, 0.f},    // Left
+///         {-1.f, 0.f, -1.f, 0.f},   // Right
+///         {0.f, 1.f, -1.f, 0.f},    // Bottom
+///         {0.f, -1.f, -1.f, 0.f}};  // Top
+///     kln::convex_volume frustum{planes, 6};
+///
+///     std::vector<uint32_t> visible((instance_count + 31) / 32);
+///     frustum.intersects(centers, radii, visible.data(), instance_count);
+/// ```
+///
+/// Points are presumed to have a positive homogeneous coordinate, and the
+/// sphere and box tests further presume that it is one.
+
+/// \addtogroup convex_volume
+/// @{
+
+/// An intersection of up to `convex_volume::max_planes` half-spaces
+class convex_volume final
+{
+public:
+    static constexpr size_t max_planes = 16;
+
+    /// The unbounded volume, which contains everything
+    convex_volume() noexcept
+    {
+        init(nullptr, 0);
+    }
+
+    /// The intersection of the positive half-spaces of `count` planes. At
+    /// most `max_planes` planes are used.
+    convex_volume(plane const* planes, size_t count) noexcept
+    {
+#ifdef KLEIN_VALIDATE
+        assert(count <= max_planes
+               && "A convex_volume holds at most max_planes planes");
+#endif
+        if (count > max_planes)
+        {
+            count = max_planes;
+        }
+        init(planes, count);
+    }
+
+    /// Number of bounding planes
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    /// The normalized `i`-th bounding plane
+    [[nodiscard]] plane operator[](size_t i) const noexcept
+    {
+        return plane{a_[i], b_[i], c_[i], d_[i]};
+    }
+
+    /// True if `p` is on the positive side of (or on) every plane
+    [[nodiscard]] bool KLN_VEC_CALL contains(point p) const noexcept
+    {
+        return test_single(p, 0.f, 0.f, 0.f, 0.f);
+    }
+
+    /// True if the sphere with center `center` and radius `radius` is at
+    /// least partially inside the volume. As is usual for culling, spheres
+    /// near an edge or corner of the volume may be reported as intersecting
+    /// when they lie just outside it.
+    [[nodiscard]] bool KLN_VEC_CALL intersects(point center,
+                                               float radius) const noexcept
+    {
+        return test_single(center, radius, 0.f, 0.f, 0.f);
+    }
+
+    /// True if the axis-aligned box from `min` to `max` is at least
+    /// partially inside the volume, with the same conservative treatment of
+    /// edges and corners as the sphere test
+    [[nodiscard]] bool KLN_VEC_CALL intersects(point min,
+                                               point max) const noexcept
+    {
+        point center{0.5f * (min.x() + max.x()),
+                     0.5f * (min.y() + max.y()),
+                     0.5f * (min.z() + max.z())};
+        return test_single(center,
+                           0.f,
+                           0.5f * (max.x() - min.x()),
+                           0.5f * (max.y() - min.y()),
+                           0.5f * (max.z() - min.z()));
+    }
+
+    /// Test `count` points. See `contains(point)`.
+    void contains(point const* in, uint32_t* out, size_t count) const noexcept
+    {
+        for (size_t i = 0; i < count; i += 8)
+        {
+            size_t n = count - i < 8 ? count - i : 8;
+            point_x8 p;
+            p.load(in + i, n);
+            write_mask(test_x8<false>(p, 0.f, 0.f, 0.f, 0.f, n), out, i, n);
+        }
+    }
+
+    /// Test `count` spheres. See `intersects(point, float)`.
+    void intersects(point const* centers,
+                    float const* radii,
+                    uint32_t* out,
+                    size_t count) const noexcept
+    {
+        for (size_t i = 0; i < count; i += 8)
+        {
+            size_t n = count - i < 8 ? count - i : 8;
+            point_x8 p;
+            p.load(centers + i, n);
+            float_x8 radius;
+            if (n == 8)
+            {
+                radius.load(radii + i);
+            }
+            else
+            {
+                float r[8] = {};
+                for (size_t j = 0; j != n; ++j)
+                {
+                    r[j] = radii[i + j];
+                }
+                radius.load(r);
+            }
+            write_mask(
+                test_x8<false>(p, radius, 0.f, 0.f, 0.f, n), out, i, n);
+        }
+    }
+
+    /// Test `count` axis-aligned boxes, the `i`-th spanning `min[i]` to
+    /// `max[i]`. See `intersects(point, point)`.
+    void intersects(point const* min,
+                    point const* max,
+                    uint32_t* out,
+                    size_t count) const noexcept
+    {
+        float_x8 half{0.5f};
+        for (size_t i = 0; i < count; i += 8)
+        {
+            size_t n = count - i < 8 ? count - i : 8;
+            point_x8 lo;
+            point_x8 hi;
+            lo.load(min + i, n);
+            hi.load(max + i, n);
+            point_x8 center{(lo.e032 + hi.e032) * half,
+                            (lo.e013 + hi.e013) * half,
+                            (lo.e021 + hi.e021) * half};
+            write_mask(test_x8<true>(center,
+                                     0.f,
+                                     (hi.e032 - lo.e032) * half,
+                                     (hi.e013 - lo.e013) * half,
+                                     (hi.e021 - lo.e021) * half,
+                                     n),
+                       out,
+                       i,
+                       n);
+        }
+    }
+
+private:
+    void init(plane const* planes, size_t count) noexcept
+    {
+        size_ = count;
+        for (size_t i = 0; i != max_planes; ++i)
+        {
+            if (i < count)
+            {
+                plane const& p = planes[i];
+                float inv      = 1.f / p.norm();
+                a_[i]          = p.x() * inv;
+                b_[i]          = p.y() * inv;
+                c_[i]          = p.z() * inv;
+                d_[i]          = p.d() * inv;
+            }
+            else
+            {
+                // Padding planes pass every test, so single-entity queries
+                // need not mask them off
+                a_[i] = 0.f;
+                b_[i] = 0.f;
+                c_[i] = 0.f;
+                d_[i] = 1.f;
+            }
+        }
+    }
+
+    // A sphere (or box with half extents ex, ey, ez) is rejected by a plane
+    // when its center is further than its radius (or the projection of its
+    // extents onto the normal) behind the plane
+    bool KLN_VEC_CALL test_single(point p,
+                                  float radius,
+                                  float ex,
+                                  float ey,
+                                  float ez) const noexcept
+    {
+        float_x8 x{p.x()};
+        float_x8 y{p.y()};
+        float_x8 z{p.z()};
+        float_x8 w{p.w()};
+        float_x8 r{-radius};
+        for (size_t i = 0; i < size_; i += 8)
+        {
+            float_x8 a;
+            float_x8 b;
+            float_x8 c;
+            float_x8 d;
+            a.load(a_ + i);
+            b.load(b_ + i);
+            c.load(c_ + i);
+            d.load(d_ + i);
+            float_x8 dist = a * x + b * y + c * z + d * w;
+            float_x8 reach
+                = r - detail::abs(a) * ex - detail::abs(b) * ey
+                  - detail::abs(c) * ez;
+            if (detail::any(detail::cmplt(dist, reach)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Mask of the lanes rejected by any plane. Lanes past n start out
+    // rejected so a partial block can still exit early. The extents only
+    // contribute to boxes, so spheres and points skip them.
+    template <bool Box>
+    float_x8 test_x8(point_x8 const& p,
+                     float_x8 radius,
+                     float_x8 ex,
+                     float_x8 ey,
+                     float_x8 ez,
+                     size_t n) const noexcept
+    {
+        float_x8 lanes{_mm_set_ps(3.f, 2.f, 1.f, 0.f),
+                       _mm_set_ps(7.f, 6.f, 5.f, 4.f)};
+        float_x8 outside
+            = detail::cmplt(float_x8{static_cast<float>(n) - 0.5f}, lanes);
+        float_x8 threshold = -radius;
+        for (size_t i = 0; i != size_; ++i)
+        {
+            float_x8 dist = p.e032 * a_[i] + p.e013 * b_[i] + p.e021 * c_[i]
+                            + p.e123 * d_[i];
+            if (Box)
+            {
+                threshold = -(ex * std::abs(a_[i]) + ey * std::abs(b_[i])
+                              + ez * std::abs(c_[i]));
+            }
+            outside = detail::or_x8(outside, detail::cmplt(dist, threshold));
+            if (detail::movemask(outside) == 0xff)
+            {
+                break;
+            }
+        }
+        return outside;
+    }
+
+    static void write_mask(float_x8 outside,
+                           uint32_t* out,
+                           size_t i,
+                           size_t n) noexcept
+    {
+        detail::store_mask(~detail::movemask(outside), out, i, n);
+    }
+
+    alignas(32) float a_[max_planes];
+    alignas(32) float b_[max_planes];
+    alignas(32) float c_[max_planes];
+    alignas(32) float d_[max_planes];
+    size_t size_;
+};
+/// @}
+} // namespace kln
@@ -0,0 +1,92 @@
+// File: dispatch_table.hpp
+// Purpose: Declare the kernel table shared between the runtime dispatch front
+// end (klein/dispatch.hpp) and the per-instruction-set translation units in
+// the klein_dispatch library.
+//
+// Notes:
+// Entries take raw XMM partitions rather than the public entity types. The
+// per-instruction-set translation units only include the detail headers so
+// that the only code they emit is the kernels themselves (see
+// dispatch/klein_dispatch_kernels.inl).
+
+#pragma once
+
+#include "sse.hpp"
+
+#include <cstddef>
+
+namespace kln
+{
+namespace dispatch
+{
+    /// Instruction set levels a kernel table can be compiled for, in
+    /// increasing order of capability.
+    enum class isa : int
+    {
+        sse3   = 0,
+        sse4_1 = 1,
+        avx2   = 2,
+    };
+
+    /// Each entry mirrors an array entry point of the header-only library.
+    /// Motors and rotors are passed as a pointer to their partitions (p1, p2
+    /// for a motor and p1 for a rotor). Entity arrays are passed as their
+    /// packed partitions.
+    struct kernel_table
+    {
+        isa level;
+
+        // motor::operator()(plane*, plane*, size_t)
+        void (*motor_planes)(__m128 const* m,
+                             __m128 const* in,
+                             __m128* out,
+                             size_t count) noexcept;
+        // motor::operator()(line*, line*, size_t)
+        void (*motor_lines)(__m128 const* m,
+                            __m128 const* in,
+                            __m128* out,
+                            size_t count) noexcept;
+        // motor::operator()(point*, point*, size_t)
+        void (*motor_points)(__m128 const* m,
+                             __m128 const* in,
+                             __m128* out,
+                             size_t count) noexcept;
+        // rotor::operator()(plane*, plane*, size_t)
+        void (*rotor_planes)(__m128 const* r,
+                             __m128 const* in,
+                             __m128* out,
+                             size_t count) noexcept;
+        // rotor::operator()(line*, line*, size_t)
+        void (*rotor_lines)(__m128 const* r,
+                            __m128 const* in,
+                            __m128* out,
+                            size_t count) noexcept;
+        // rotor::operator()(point*, point*, size_t)
+        void (*rotor_points)(__m128 const* r,
+                             __m128 const* in,
+                             __m128* out,
+                             size_t count) noexcept;
+        // out[i] = a[i] * b[i] for motors
+        void (*motor_products)(__m128 const* a,
+                               __m128 const* b,
+                               __m128* out,
+                               size_t count) noexcept;
+        // motor::as_mat3x4 over an array
+        void (*motor_mat3x4)(__m128 const* m,
+                             __m128* out,
+                             size_t count) noexcept;
+        // motor::as_mat4x4 over an array
+        void (*motor_mat4x4)(__m128 const* m,
+                             __m128* out,
+                             size_t count) noexcept;
+    };
+} // namespace dispatch
+
+namespace detail
+{
+    // Defined by the klein_dispatch library, one per instruction set
+    extern dispatch::kernel_table const dispatch_sse3;
+    extern dispatch::kernel_table const dispatch_sse4_1;
+    extern dispatch::kernel_table const dispatch_avx2;
+} // namespace detail
+} // namespace kln
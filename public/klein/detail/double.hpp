@@ -0,0 +1,4 @@
+#pragma once
+
+#include "x86/x86_double.hpp"
+#include "x86/x86_double_kernels.hpp"
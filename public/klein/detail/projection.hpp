@@ -0,0 +1,3 @@
+#pragma once
+
+#include "x86/x86_projection.hpp"
@@ -0,0 +1,304 @@
+// File: x86_double.hpp
+// Purpose: Provide a register type holding four doubles along with the
+// primitives needed to express the double-precision kernels with the same
+// structure as their single-precision counterparts.
+//
+// Notes:
+// 1. With KLEIN_AVX2, f64x4 wraps a single YMM register. Otherwise, it is
+//    emulated with a pair of XMM registers holding lanes [0, 2) and [2, 4),
+//    which only requires SSE2.
+// 2. Lane 0 is the lowest address in memory so the partition layouts are
+//    identical to those of the single-precision types.
+// 3. Unlike the single-precision code, reciprocals and square roots are
+//    computed exactly. The double-precision types exist for accuracy, and the
+//    approximate instructions only provide 12 bits for doubles as well.
+
+#pragma once
+
+#include "x86_sse.hpp"
+
+#include <emmintrin.h>
+
+namespace kln
+{
+namespace detail
+{
+    struct f64x4
+    {
+#ifdef KLEIN_AVX2
+        __m256d v;
+#else
+        __m128d lo;
+        __m128d hi;
+#endif
+    };
+
+#ifdef KLEIN_AVX2
+#    define KLN_F64_BINARY(op256, op128, a, b) f64x4{op256((a).v, (b).v)}
+#else
+#    define KLN_F64_BINARY(op256, op128, a, b) \
+        f64x4{op128((a).lo, (b).lo), op128((a).hi, (b).hi)}
+#endif
+
+    // Little-endian swizzle with the same argument order as KLN_SWIZZLE.
+    //
+    // swizzle_pd<3, 2, 1, 0>(a) is the identity.
+    template <int X, int Y, int Z, int W>
+    KLN_INLINE f64x4 KLN_VEC_CALL swizzle_pd(f64x4 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_permute4x64_pd(a.v, _MM_SHUFFLE(X, Y, Z, W))};
+#else
+        // Each output half gathers one lane from either input half
+        return {_mm_shuffle_pd(W < 2 ? a.lo : a.hi,
+                               Z < 2 ? a.lo : a.hi,
+                               (W & 1) | ((Z & 1) << 1)),
+                _mm_shuffle_pd(Y < 2 ? a.lo : a.hi,
+                               X < 2 ? a.lo : a.hi,
+                               (Y & 1) | ((X & 1) << 1))};
+#endif
+    }
+
+#ifndef KLN_SWIZZLE_PD
+#    define KLN_SWIZZLE_PD(reg, x, y, z, w) \
+        ::kln::detail::swizzle_pd<x, y, z, w>(reg)
+#endif
+
+    KLN_INLINE f64x4 KLN_VEC_CALL setzero_pd() noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_setzero_pd()};
+#else
+        return {_mm_setzero_pd(), _mm_setzero_pd()};
+#endif
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL set1_pd(double s) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_set1_pd(s)};
+#else
+        return {_mm_set1_pd(s), _mm_set1_pd(s)};
+#endif
+    }
+
+    // Arguments are ordered from the highest lane to the lowest as in
+    // _mm_set_ps
+    KLN_INLINE f64x4 KLN_VEC_CALL set_pd(double e3,
+                                         double e2,
+                                         double e1,
+                                         double e0) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_set_pd(e3, e2, e1, e0)};
+#else
+        return {_mm_set_pd(e1, e0), _mm_set_pd(e3, e2)};
+#endif
+    }
+
+    // Sets the lowest lane and zeroes the others
+    KLN_INLINE f64x4 KLN_VEC_CALL set_sd(double s) noexcept
+    {
+        return set_pd(0.0, 0.0, 0.0, s);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL loadu_pd(double const* data) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_loadu_pd(data)};
+#else
+        return {_mm_loadu_pd(data), _mm_loadu_pd(data + 2)};
+#endif
+    }
+
+    KLN_INLINE void KLN_VEC_CALL storeu_pd(double* data, f64x4 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        _mm256_storeu_pd(data, a.v);
+#else
+        _mm_storeu_pd(data, a.lo);
+        _mm_storeu_pd(data + 2, a.hi);
+#endif
+    }
+
+    // Lowest lane
+    KLN_INLINE double KLN_VEC_CALL first_pd(f64x4 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return _mm_cvtsd_f64(_mm256_castpd256_pd128(a.v));
+#else
+        return _mm_cvtsd_f64(a.lo);
+#endif
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL add_pd(f64x4 a, f64x4 b) noexcept
+    {
+        return KLN_F64_BINARY(_mm256_add_pd, _mm_add_pd, a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL sub_pd(f64x4 a, f64x4 b) noexcept
+    {
+        return KLN_F64_BINARY(_mm256_sub_pd, _mm_sub_pd, a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL mul_pd(f64x4 a, f64x4 b) noexcept
+    {
+        return KLN_F64_BINARY(_mm256_mul_pd, _mm_mul_pd, a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL div_pd(f64x4 a, f64x4 b) noexcept
+    {
+        return KLN_F64_BINARY(_mm256_div_pd, _mm_div_pd, a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL xor_pd(f64x4 a, f64x4 b) noexcept
+    {
+        return KLN_F64_BINARY(_mm256_xor_pd, _mm_xor_pd, a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL and_pd(f64x4 a, f64x4 b) noexcept
+    {
+        return KLN_F64_BINARY(_mm256_and_pd, _mm_and_pd, a, b);
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL sqrt_pd(f64x4 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_sqrt_pd(a.v)};
+#else
+        return {_mm_sqrt_pd(a.lo), _mm_sqrt_pd(a.hi)};
+#endif
+    }
+
+    // Lanes whose bit is set in Mask are taken from b, the rest from a
+    template <int Mask>
+    KLN_INLINE f64x4 KLN_VEC_CALL blend_pd(f64x4 a, f64x4 b) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_blend_pd(a.v, b.v, Mask)};
+#else
+        // _mm_move_sd(x, y) takes the low lane from y and the high from x
+        __m128d lo = (Mask & 3) == 0   ? a.lo
+                     : (Mask & 3) == 3 ? b.lo
+                     : (Mask & 3) == 1 ? _mm_move_sd(a.lo, b.lo)
+                                       : _mm_move_sd(b.lo, a.lo);
+        __m128d hi = (Mask & 12) == 0   ? a.hi
+                     : (Mask & 12) == 12 ? b.hi
+                     : (Mask & 12) == 4  ? _mm_move_sd(a.hi, b.hi)
+                                         : _mm_move_sd(b.hi, a.hi);
+        return {lo, hi};
+#endif
+    }
+
+    // Scalar counterparts operating on the lowest lane only. The remaining
+    // lanes are passed through from a.
+    KLN_INLINE f64x4 KLN_VEC_CALL add_sd(f64x4 a, f64x4 b) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return blend_pd<1>(a, add_pd(a, b));
+#else
+        return {_mm_add_sd(a.lo, b.lo), a.hi};
+#endif
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL sub_sd(f64x4 a, f64x4 b) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return blend_pd<1>(a, sub_pd(a, b));
+#else
+        return {_mm_sub_sd(a.lo, b.lo), a.hi};
+#endif
+    }
+
+    // Sum of all four lanes, broadcast to every lane
+    KLN_INLINE f64x4 KLN_VEC_CALL hsum_bc(f64x4 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        // (0 + 2, 1 + 3, 2 + 0, 3 + 1)
+        __m256d t = _mm256_add_pd(a.v, _mm256_permute2f128_pd(a.v, a.v, 1));
+        return {_mm256_add_pd(t, _mm256_permute_pd(t, 0b0101))};
+#else
+        __m128d t = _mm_add_pd(a.lo, a.hi);
+        t         = _mm_add_pd(t, _mm_shuffle_pd(t, t, 1));
+        return {t, t};
+#endif
+    }
+
+    // Counterparts of the single-precision dot products in x86_sse.hpp. The
+    // hi_ variants exclude the lowest lane. The _bc variants broadcast the
+    // result while the others store it in the lowest lane and zero the rest.
+    KLN_INLINE f64x4 KLN_VEC_CALL hi_dp_bc(f64x4 a, f64x4 b) noexcept
+    {
+        return hsum_bc(blend_pd<1>(mul_pd(a, b), setzero_pd()));
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL hi_dp(f64x4 a, f64x4 b) noexcept
+    {
+        return blend_pd<0b1110>(hi_dp_bc(a, b), setzero_pd());
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL dp_bc(f64x4 a, f64x4 b) noexcept
+    {
+        return hsum_bc(mul_pd(a, b));
+    }
+
+    KLN_INLINE f64x4 KLN_VEC_CALL dp(f64x4 a, f64x4 b) noexcept
+    {
+        return blend_pd<0b1110>(dp_bc(a, b), setzero_pd());
+    }
+
+    // Returns true if every lane of a equals the corresponding lane of b
+    KLN_INLINE bool KLN_VEC_CALL all_eq_pd(f64x4 a, f64x4 b) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return _mm256_movemask_pd(_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)) == 0xf;
+#else
+        return (_mm_movemask_pd(_mm_cmpeq_pd(a.lo, b.lo))
+                & _mm_movemask_pd(_mm_cmpeq_pd(a.hi, b.hi)))
+               == 3;
+#endif
+    }
+
+    // Returns true if |a - b| < epsilon in every lane
+    KLN_INLINE bool KLN_VEC_CALL all_near_pd(f64x4 a,
+                                             f64x4 b,
+                                             double epsilon) noexcept
+    {
+#ifdef KLEIN_AVX2
+        __m256d diff = _mm256_andnot_pd(_mm256_set1_pd(-0.0),
+                                        _mm256_sub_pd(a.v, b.v));
+        __m256d cmp
+            = _mm256_cmp_pd(diff, _mm256_set1_pd(epsilon), _CMP_LT_OQ);
+        return _mm256_movemask_pd(cmp) == 0xf;
+#else
+        __m128d neg = _mm_set1_pd(-0.0);
+        __m128d eps = _mm_set1_pd(epsilon);
+        __m128d lo  = _mm_andnot_pd(neg, _mm_sub_pd(a.lo, b.lo));
+        __m128d hi  = _mm_andnot_pd(neg, _mm_sub_pd(a.hi, b.hi));
+        return (_mm_movemask_pd(_mm_cmplt_pd(lo, eps))
+                & _mm_movemask_pd(_mm_cmplt_pd(hi, eps)))
+               == 3;
+#endif
+    }
+
+    // Widen four floats to four doubles
+    KLN_INLINE f64x4 KLN_VEC_CALL cvtps_pd(__m128 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return {_mm256_cvtps_pd(a)};
+#else
+        return {_mm_cvtps_pd(a), _mm_cvtps_pd(_mm_movehl_ps(a, a))};
+#endif
+    }
+
+    // Round four doubles to the nearest floats
+    KLN_INLINE __m128 KLN_VEC_CALL cvtpd_ps(f64x4 a) noexcept
+    {
+#ifdef KLEIN_AVX2
+        return _mm256_cvtpd_ps(a.v);
+#else
+        return _mm_movelh_ps(_mm_cvtpd_ps(a.lo), _mm_cvtpd_ps(a.hi));
+#endif
+    }
+} // namespace detail
+} // namespace kln
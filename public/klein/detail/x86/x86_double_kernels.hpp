@@ -0,0 +1,615 @@
+// File: x86_double_kernels.hpp
+// Purpose: Double-precision ports of the geometric product, sandwich,
+// exponential/logarithm, and matrix conversion kernels.
+//
+// Notes:
+// 1. Each function here mirrors the single-precision kernel of the same name
+//    (see x86_geometric_product.hpp, x86_sandwich.hpp, x86_exp_log.hpp, and
+//    x86_matrix.hpp for the derivations) with __m128 replaced by f64x4.
+//    Overload resolution picks the precision from the operand types.
+// 2. Compile-time flags are tested with ordinary branches rather than
+//    `if constexpr` so this header remains valid C++11. Every branch is
+//    well-formed for all flag values, and the untaken branches are removed by
+//    the optimizer.
+
+#pragma once
+
+#include "x86_double.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+namespace kln
+{
+namespace detail
+{
+    // Partition memory layouts
+    //     LSB --> MSB
+    // p0: (e0, e1, e2, e3)
+    // p1: (1, e23, e31, e12)
+    // p2: (e0123, e01, e02, e03)
+    // p3: (e123, e032, e013, e021)
+
+    // Geometric products
+
+    // plane * plane
+    KLN_INLINE void KLN_VEC_CALL gp00(f64x4 a,
+                                      f64x4 b,
+                                      f64x4& KLN_RESTRICT p1_out,
+                                      f64x4& KLN_RESTRICT p2_out) noexcept
+    {
+        p1_out = mul_pd(KLN_SWIZZLE_PD(a, 1, 3, 2, 1),
+                        KLN_SWIZZLE_PD(b, 2, 1, 3, 1));
+        p1_out = sub_pd(p1_out,
+                        xor_pd(set_sd(-0.0),
+                               mul_pd(KLN_SWIZZLE_PD(a, 2, 1, 3, 2),
+                                      KLN_SWIZZLE_PD(b, 1, 3, 2, 2))));
+        p1_out = add_sd(p1_out,
+                        mul_pd(KLN_SWIZZLE_PD(a, 0, 0, 0, 3),
+                               KLN_SWIZZLE_PD(b, 0, 0, 0, 3)));
+
+        p2_out = mul_pd(KLN_SWIZZLE_PD(a, 0, 0, 0, 0), b);
+        p2_out = sub_pd(p2_out, mul_pd(a, KLN_SWIZZLE_PD(b, 0, 0, 0, 0)));
+    }
+
+    // rotor * rotor
+    KLN_INLINE void KLN_VEC_CALL gp11(f64x4 a, f64x4 b, f64x4& p1_out) noexcept
+    {
+        p1_out = mul_pd(KLN_SWIZZLE_PD(a, 0, 0, 0, 0), b);
+        p1_out = sub_pd(p1_out,
+                        mul_pd(KLN_SWIZZLE_PD(a, 1, 3, 2, 1),
+                               KLN_SWIZZLE_PD(b, 2, 1, 3, 1)));
+
+        f64x4 tmp1 = mul_pd(KLN_SWIZZLE_PD(a, 3, 2, 1, 2),
+                            KLN_SWIZZLE_PD(b, 0, 0, 0, 2));
+        f64x4 tmp2 = mul_pd(KLN_SWIZZLE_PD(a, 2, 1, 3, 3),
+                            KLN_SWIZZLE_PD(b, 1, 3, 2, 3));
+        f64x4 tmp  = xor_pd(add_pd(tmp1, tmp2), set_sd(-0.0));
+
+        p1_out = add_pd(p1_out, tmp);
+    }
+
+    // Screw from a dual number (u + v e0123) and a line (b, c)
+    KLN_INLINE void KLN_VEC_CALL gpDL(double u,
+                                      double v,
+                                      f64x4 b,
+                                      f64x4 c,
+                                      f64x4& KLN_RESTRICT p1,
+                                      f64x4& KLN_RESTRICT p2) noexcept
+    {
+        f64x4 u_vec = set1_pd(u);
+        p1          = mul_pd(u_vec, b);
+        p2          = sub_pd(mul_pd(c, u_vec), mul_pd(b, set1_pd(v)));
+    }
+
+    // rotor * translator (Flip = false) or translator * rotor (Flip = true)
+    template <bool Flip>
+    KLN_INLINE void KLN_VEC_CALL gpRT(f64x4 a, f64x4 b, f64x4& p2) noexcept
+    {
+        p2 = mul_pd(KLN_SWIZZLE_PD(a, 0, 0, 0, 1),
+                    KLN_SWIZZLE_PD(b, 3, 2, 1, 1));
+        if (Flip)
+        {
+            p2 = add_pd(p2,
+                        mul_pd(KLN_SWIZZLE_PD(a, 1, 3, 2, 2),
+                               KLN_SWIZZLE_PD(b, 2, 1, 3, 2)));
+            p2 = sub_pd(p2,
+                        xor_pd(set_sd(-0.0),
+                               mul_pd(KLN_SWIZZLE_PD(a, 2, 1, 3, 3),
+                                      KLN_SWIZZLE_PD(b, 1, 3, 2, 3))));
+        }
+        else
+        {
+            p2 = add_pd(p2,
+                        mul_pd(KLN_SWIZZLE_PD(a, 2, 1, 3, 2),
+                               KLN_SWIZZLE_PD(b, 1, 3, 2, 2)));
+            p2 = sub_pd(p2,
+                        xor_pd(set_sd(-0.0),
+                               mul_pd(KLN_SWIZZLE_PD(a, 1, 3, 2, 3),
+                                      KLN_SWIZZLE_PD(b, 2, 1, 3, 3))));
+        }
+    }
+
+    // Contribution of a rotor (a) to the ideal partition of a motor (b)
+    template <bool Flip>
+    KLN_INLINE void KLN_VEC_CALL gp12(f64x4 a, f64x4 b, f64x4& p2) noexcept
+    {
+        gpRT<Flip>(a, b, p2);
+        p2 = sub_pd(
+            p2,
+            xor_pd(set_sd(-0.0), mul_pd(a, KLN_SWIZZLE_PD(b, 0, 0, 0, 0))));
+    }
+
+    // line * line
+    KLN_INLINE void KLN_VEC_CALL gpLL(f64x4 const* KLN_RESTRICT l1,
+                                      f64x4 const* KLN_RESTRICT l2,
+                                      f64x4* KLN_RESTRICT out) noexcept
+    {
+        f64x4 const& a = l1[0];
+        f64x4 const& d = l1[1];
+        f64x4 const& b = l2[0];
+        f64x4 const& c = l2[1];
+
+        f64x4 flip = set_sd(-0.0);
+
+        f64x4& p1 = out[0];
+        f64x4& p2 = out[1];
+
+        p1 = mul_pd(KLN_SWIZZLE_PD(a, 3, 1, 2, 1),
+                    KLN_SWIZZLE_PD(b, 2, 3, 1, 1));
+        p1 = xor_pd(p1, flip);
+        p1 = sub_pd(p1,
+                    mul_pd(KLN_SWIZZLE_PD(a, 2, 3, 1, 3),
+                           KLN_SWIZZLE_PD(b, 3, 1, 2, 3)));
+        f64x4 a2 = KLN_SWIZZLE_PD(a, 2, 2, 2, 2);
+        f64x4 b2 = KLN_SWIZZLE_PD(b, 2, 2, 2, 2);
+        p1       = sub_sd(p1, mul_pd(a2, b2));
+
+        p2 = mul_pd(KLN_SWIZZLE_PD(a, 2, 1, 3, 1),
+                    KLN_SWIZZLE_PD(c, 1, 3, 2, 1));
+        p2 = sub_pd(p2,
+                    xor_pd(flip,
+                           mul_pd(KLN_SWIZZLE_PD(a, 1, 3, 2, 3),
+                                  KLN_SWIZZLE_PD(c, 2, 1, 3, 3))));
+        p2 = add_pd(p2,
+                    mul_pd(KLN_SWIZZLE_PD(b, 1, 3, 2, 1),
+                           KLN_SWIZZLE_PD(d, 2, 1, 3, 1)));
+        p2 = sub_pd(p2,
+                    xor_pd(flip,
+                           mul_pd(KLN_SWIZZLE_PD(b, 2, 1, 3, 3),
+                                  KLN_SWIZZLE_PD(d, 1, 3, 2, 3))));
+        f64x4 c2 = KLN_SWIZZLE_PD(c, 2, 2, 2, 2);
+        f64x4 d2 = KLN_SWIZZLE_PD(d, 2, 2, 2, 2);
+        p2       = add_sd(p2, mul_pd(a2, c2));
+        p2       = add_sd(p2, mul_pd(b2, d2));
+    }
+
+    // motor * motor
+    KLN_INLINE void KLN_VEC_CALL gpMM(f64x4 const* KLN_RESTRICT m1,
+                                      f64x4 const* KLN_RESTRICT m2,
+                                      f64x4* KLN_RESTRICT out) noexcept
+    {
+        f64x4 const& a = m1[0];
+        f64x4 const& b = m1[1];
+        f64x4 const& c = m2[0];
+        f64x4 const& d = m2[1];
+
+        f64x4& e = out[0];
+        f64x4& f = out[1];
+
+        f64x4 a_xxxx = KLN_SWIZZLE_PD(a, 0, 0, 0, 0);
+        f64x4 a_zyzw = KLN_SWIZZLE_PD(a, 3, 2, 1, 2);
+        f64x4 a_ywyz = KLN_SWIZZLE_PD(a, 2, 1, 3, 1);
+        f64x4 a_wzwy = KLN_SWIZZLE_PD(a, 1, 3, 2, 3);
+        f64x4 c_wwyz = KLN_SWIZZLE_PD(c, 2, 1, 3, 3);
+        f64x4 c_yzwy = KLN_SWIZZLE_PD(c, 1, 3, 2, 1);
+        f64x4 s_flip = set_sd(-0.0);
+
+        e       = mul_pd(a_xxxx, c);
+        f64x4 t = mul_pd(a_ywyz, c_yzwy);
+        t       = add_pd(t, mul_pd(a_zyzw, KLN_SWIZZLE_PD(c, 0, 0, 0, 2)));
+        t       = xor_pd(t, s_flip);
+        e       = add_pd(e, t);
+        e       = sub_pd(e, mul_pd(a_wzwy, c_wwyz));
+
+        f = mul_pd(a_xxxx, d);
+        f = add_pd(f, mul_pd(b, KLN_SWIZZLE_PD(c, 0, 0, 0, 0)));
+        f = add_pd(f, mul_pd(a_ywyz, KLN_SWIZZLE_PD(d, 1, 3, 2, 1)));
+        f = add_pd(f, mul_pd(KLN_SWIZZLE_PD(b, 2, 1, 3, 1), c_yzwy));
+        t = mul_pd(a_zyzw, KLN_SWIZZLE_PD(d, 0, 0, 0, 2));
+        t = add_pd(t, mul_pd(a_wzwy, KLN_SWIZZLE_PD(d, 2, 1, 3, 3)));
+        t = add_pd(t,
+                   mul_pd(KLN_SWIZZLE_PD(b, 0, 0, 0, 2),
+                          KLN_SWIZZLE_PD(c, 3, 2, 1, 2)));
+        t = add_pd(t, mul_pd(KLN_SWIZZLE_PD(b, 1, 3, 2, 3), c_wwyz));
+        t = xor_pd(t, s_flip);
+        f = sub_pd(f, t);
+    }
+
+    // Sandwich products
+
+    // Apply a translator to a plane. The low component of b is expected to
+    // hold the scalar component rather than e0123.
+    KLN_INLINE f64x4 KLN_VEC_CALL sw02(f64x4 a, f64x4 b) noexcept
+    {
+        f64x4 tmp = hi_dp(a, b);
+        tmp       = mul_pd(tmp, set1_pd(2.0 / first_pd(b)));
+        return add_pd(a, tmp);
+    }
+
+    // Apply a translator to a line
+    // a := p1 input
+    // d := p2 input
+    // c := p2 translator
+    KLN_INLINE void KLN_VEC_CALL swL2(f64x4 a, f64x4 d, f64x4 c, f64x4* out)
+    {
+        f64x4& p1_out = out[0];
+        f64x4& p2_out = out[1];
+
+        p1_out = a;
+
+        p2_out = mul_pd(KLN_SWIZZLE_PD(a, 1, 3, 2, 0),
+                        KLN_SWIZZLE_PD(c, 2, 1, 3, 0));
+        p2_out = sub_pd(p2_out,
+                        mul_pd(KLN_SWIZZLE_PD(a, 2, 1, 3, 0),
+                               KLN_SWIZZLE_PD(c, 1, 3, 2, 0)));
+        p2_out = sub_pd(
+            p2_out,
+            xor_pd(mul_pd(a, KLN_SWIZZLE_PD(c, 0, 0, 0, 0)), set_sd(-0.0)));
+        p2_out = add_pd(p2_out, p2_out);
+        p2_out = add_pd(p2_out, d);
+    }
+
+    // Apply a translator to a point
+    KLN_INLINE f64x4 KLN_VEC_CALL sw32(f64x4 a, f64x4 b) noexcept
+    {
+        f64x4 tmp = mul_pd(KLN_SWIZZLE_PD(a, 0, 0, 0, 0), b);
+        tmp       = mul_pd(set_pd(-2.0, -2.0, -2.0, 0.0), tmp);
+        return add_pd(a, tmp);
+    }
+
+    // Apply a motor (or rotor if Translate is false) to a line
+    template <bool Variadic, bool Translate, bool InputP2>
+    KLN_INLINE void KLN_VEC_CALL swMM(f64x4 const* KLN_RESTRICT in,
+                                      f64x4 const& KLN_RESTRICT b,
+                                      f64x4 const* KLN_RESTRICT c,
+                                      f64x4* out,
+                                      size_t count = 0) noexcept
+    {
+        f64x4 b_xwyz   = KLN_SWIZZLE_PD(b, 2, 1, 3, 0);
+        f64x4 b_xzwy   = KLN_SWIZZLE_PD(b, 1, 3, 2, 0);
+        f64x4 b_yxxx   = KLN_SWIZZLE_PD(b, 0, 0, 0, 1);
+        f64x4 b_yxxx_2 = mul_pd(b_yxxx, b_yxxx);
+
+        f64x4 tmp   = mul_pd(b, b);
+        tmp         = add_pd(tmp, b_yxxx_2);
+        f64x4 b_tmp = KLN_SWIZZLE_PD(b, 2, 1, 3, 2);
+        f64x4 tmp2  = mul_pd(b_tmp, b_tmp);
+        b_tmp       = KLN_SWIZZLE_PD(b, 1, 3, 2, 3);
+        tmp2        = add_pd(tmp2, mul_pd(b_tmp, b_tmp));
+        tmp         = sub_pd(tmp, xor_pd(tmp2, set_sd(-0.0)));
+
+        f64x4 b_xxxx = KLN_SWIZZLE_PD(b, 0, 0, 0, 0);
+        f64x4 scale  = set_pd(2.0, 2.0, 2.0, 0.0);
+        tmp2         = mul_pd(b_xxxx, b_xwyz);
+        tmp2         = add_pd(tmp2, mul_pd(b, b_xzwy));
+        tmp2         = mul_pd(tmp2, scale);
+
+        f64x4 tmp3 = mul_pd(b, b_xwyz);
+        tmp3       = sub_pd(tmp3, mul_pd(b_xxxx, b_xzwy));
+        tmp3       = mul_pd(tmp3, scale);
+
+        f64x4 tmp4 = setzero_pd();
+        f64x4 tmp5 = setzero_pd();
+        f64x4 tmp6 = setzero_pd();
+        if (Translate)
+        {
+            f64x4 czero  = KLN_SWIZZLE_PD(*c, 0, 0, 0, 0);
+            f64x4 c_xzwy = KLN_SWIZZLE_PD(*c, 1, 3, 2, 0);
+            f64x4 c_xwyz = KLN_SWIZZLE_PD(*c, 2, 1, 3, 0);
+
+            tmp4 = mul_pd(b, *c);
+            tmp4 = sub_pd(tmp4, mul_pd(b_yxxx, KLN_SWIZZLE_PD(*c, 0, 0, 0, 1)));
+            tmp4 = sub_pd(tmp4,
+                          mul_pd(KLN_SWIZZLE_PD(b, 1, 3, 3, 2),
+                                 KLN_SWIZZLE_PD(*c, 1, 3, 3, 2)));
+            tmp4 = sub_pd(tmp4,
+                          mul_pd(KLN_SWIZZLE_PD(b, 2, 1, 2, 3),
+                                 KLN_SWIZZLE_PD(*c, 2, 1, 2, 3)));
+            tmp4 = add_pd(tmp4, tmp4);
+
+            tmp5 = mul_pd(b, c_xwyz);
+            tmp5 = add_pd(tmp5, mul_pd(b_xzwy, czero));
+            tmp5 = add_pd(tmp5, mul_pd(b_xwyz, *c));
+            tmp5 = sub_pd(tmp5, mul_pd(b_xxxx, c_xzwy));
+            tmp5 = mul_pd(tmp5, scale);
+
+            tmp6 = mul_pd(b, c_xzwy);
+            tmp6 = add_pd(tmp6, mul_pd(b_xxxx, c_xwyz));
+            tmp6 = add_pd(tmp6, mul_pd(b_xzwy, *c));
+            tmp6 = sub_pd(tmp6, mul_pd(b_xwyz, czero));
+            tmp6 = mul_pd(tmp6, scale);
+        }
+
+        size_t limit  = Variadic ? count : 1;
+        size_t stride = InputP2 ? 2 : 1;
+        for (size_t i = 0; i != limit; ++i)
+        {
+            f64x4 p1_in      = in[stride * i];
+            f64x4 p1_in_xzwy = KLN_SWIZZLE_PD(p1_in, 1, 3, 2, 0);
+            f64x4 p1_in_xwyz = KLN_SWIZZLE_PD(p1_in, 2, 1, 3, 0);
+
+            f64x4 p1_out = mul_pd(tmp, p1_in);
+            p1_out       = add_pd(p1_out, mul_pd(tmp2, p1_in_xzwy));
+            p1_out       = add_pd(p1_out, mul_pd(tmp3, p1_in_xwyz));
+
+            f64x4 p2_out = setzero_pd();
+            if (InputP2)
+            {
+                f64x4 p2_in = in[2 * i + 1];
+                p2_out      = mul_pd(tmp, p2_in);
+                p2_out      = add_pd(
+                    p2_out, mul_pd(tmp2, KLN_SWIZZLE_PD(p2_in, 1, 3, 2, 0)));
+                p2_out = add_pd(
+                    p2_out, mul_pd(tmp3, KLN_SWIZZLE_PD(p2_in, 2, 1, 3, 0)));
+            }
+
+            if (Translate)
+            {
+                p2_out = add_pd(p2_out, mul_pd(tmp4, p1_in));
+                p2_out = add_pd(p2_out, mul_pd(tmp5, p1_in_xwyz));
+                p2_out = add_pd(p2_out, mul_pd(tmp6, p1_in_xzwy));
+            }
+
+            // All inputs are read before any output is written so in place
+            // application is permitted
+            out[stride * i] = p1_out;
+            if (InputP2 || Translate)
+            {
+                out[2 * i + 1] = p2_out;
+            }
+        }
+    }
+
+    // Apply a motor (or rotor if Translate is false) to a plane
+    template <bool Variadic, bool Translate>
+    KLN_INLINE void KLN_VEC_CALL sw012(f64x4 const* KLN_RESTRICT a,
+                                       f64x4 b,
+                                       f64x4 const* KLN_RESTRICT c,
+                                       f64x4* out,
+                                       size_t count = 0) noexcept
+    {
+        f64x4 dc_scale = set_pd(2.0, 2.0, 2.0, 1.0);
+        f64x4 b_xwyz   = KLN_SWIZZLE_PD(b, 2, 1, 3, 0);
+        f64x4 b_xzwy   = KLN_SWIZZLE_PD(b, 1, 3, 2, 0);
+        f64x4 b_xxxx   = KLN_SWIZZLE_PD(b, 0, 0, 0, 0);
+
+        f64x4 tmp1 = mul_pd(KLN_SWIZZLE_PD(b, 0, 0, 0, 2),
+                            KLN_SWIZZLE_PD(b, 2, 1, 3, 2));
+        tmp1       = add_pd(tmp1,
+                      mul_pd(KLN_SWIZZLE_PD(b, 1, 3, 2, 1),
+                             KLN_SWIZZLE_PD(b, 3, 2, 1, 1)));
+        tmp1       = mul_pd(tmp1, dc_scale);
+
+        f64x4 tmp2 = mul_pd(b, b_xwyz);
+        tmp2       = sub_pd(tmp2,
+                      xor_pd(set_sd(-0.0),
+                             mul_pd(KLN_SWIZZLE_PD(b, 0, 0, 0, 3),
+                                    KLN_SWIZZLE_PD(b, 1, 3, 2, 3))));
+        tmp2       = mul_pd(tmp2, dc_scale);
+
+        f64x4 tmp3 = mul_pd(b, b);
+        tmp3       = sub_pd(tmp3, mul_pd(b_xwyz, b_xwyz));
+        tmp3       = add_pd(tmp3, mul_pd(b_xxxx, b_xxxx));
+        tmp3       = sub_pd(tmp3, mul_pd(b_xzwy, b_xzwy));
+
+        f64x4 tmp4 = setzero_pd();
+        if (Translate)
+        {
+            tmp4 = mul_pd(b_xxxx, *c);
+            tmp4 = add_pd(tmp4, mul_pd(b_xzwy, KLN_SWIZZLE_PD(*c, 2, 1, 3, 0)));
+            tmp4 = add_pd(tmp4, mul_pd(b, KLN_SWIZZLE_PD(*c, 0, 0, 0, 0)));
+            tmp4 = sub_pd(tmp4, mul_pd(b_xwyz, KLN_SWIZZLE_PD(*c, 1, 3, 2, 0)));
+            tmp4 = mul_pd(tmp4, dc_scale);
+        }
+
+        size_t limit = Variadic ? count : 1;
+        for (size_t i = 0; i != limit; ++i)
+        {
+            f64x4 a_i = a[i];
+            f64x4 p   = mul_pd(tmp1, KLN_SWIZZLE_PD(a_i, 1, 3, 2, 0));
+            p = add_pd(p, mul_pd(tmp2, KLN_SWIZZLE_PD(a_i, 2, 1, 3, 0)));
+            p = add_pd(p, mul_pd(tmp3, a_i));
+
+            if (Translate)
+            {
+                p = add_pd(p, hi_dp(tmp4, a_i));
+            }
+            out[i] = p;
+        }
+    }
+
+    // Apply a motor (or rotor if Translate is false) to a point
+    template <bool Variadic, bool Translate>
+    KLN_INLINE void KLN_VEC_CALL sw312(f64x4 const* KLN_RESTRICT a,
+                                       f64x4 b,
+                                       f64x4 const* KLN_RESTRICT c,
+                                       f64x4* out,
+                                       size_t count = 0) noexcept
+    {
+        f64x4 two    = set_pd(2.0, 2.0, 2.0, 0.0);
+        f64x4 b_xxxx = KLN_SWIZZLE_PD(b, 0, 0, 0, 0);
+        f64x4 b_xwyz = KLN_SWIZZLE_PD(b, 2, 1, 3, 0);
+        f64x4 b_xzwy = KLN_SWIZZLE_PD(b, 1, 3, 2, 0);
+
+        f64x4 tmp1 = mul_pd(b, b_xwyz);
+        tmp1       = sub_pd(tmp1, mul_pd(b_xxxx, b_xzwy));
+        tmp1       = mul_pd(tmp1, two);
+
+        f64x4 tmp2 = mul_pd(b_xxxx, b_xwyz);
+        tmp2       = add_pd(tmp2, mul_pd(b_xzwy, b));
+        tmp2       = mul_pd(tmp2, two);
+
+        f64x4 tmp3  = mul_pd(b, b);
+        f64x4 b_tmp = KLN_SWIZZLE_PD(b, 0, 0, 0, 1);
+        tmp3        = add_pd(tmp3, mul_pd(b_tmp, b_tmp));
+        b_tmp       = KLN_SWIZZLE_PD(b, 2, 1, 3, 2);
+        f64x4 tmp4  = mul_pd(b_tmp, b_tmp);
+        b_tmp       = KLN_SWIZZLE_PD(b, 1, 3, 2, 3);
+        tmp4        = add_pd(tmp4, mul_pd(b_tmp, b_tmp));
+        tmp3        = sub_pd(tmp3, xor_pd(tmp4, set_sd(-0.0)));
+
+        if (Translate)
+        {
+            tmp4 = mul_pd(b_xzwy, KLN_SWIZZLE_PD(*c, 2, 1, 3, 0));
+            tmp4 = sub_pd(tmp4, mul_pd(b_xxxx, *c));
+            tmp4 = sub_pd(tmp4, mul_pd(b_xwyz, KLN_SWIZZLE_PD(*c, 1, 3, 2, 0)));
+            tmp4 = sub_pd(tmp4, mul_pd(b, KLN_SWIZZLE_PD(*c, 0, 0, 0, 0)));
+            tmp4 = mul_pd(tmp4, two);
+        }
+
+        size_t limit = Variadic ? count : 1;
+        for (size_t i = 0; i != limit; ++i)
+        {
+            f64x4 a_i = a[i];
+            f64x4 p   = mul_pd(tmp1, KLN_SWIZZLE_PD(a_i, 2, 1, 3, 0));
+            p = add_pd(p, mul_pd(tmp2, KLN_SWIZZLE_PD(a_i, 1, 3, 2, 0)));
+            p = add_pd(p, mul_pd(tmp3, a_i));
+
+            if (Translate)
+            {
+                p = add_pd(p, mul_pd(tmp4, KLN_SWIZZLE_PD(a_i, 0, 0, 0, 0)));
+            }
+            out[i] = p;
+        }
+    }
+
+    // Exponential and logarithm
+
+    KLN_INLINE void KLN_VEC_CALL exp(f64x4 a,
+                                     f64x4 b,
+                                     f64x4& KLN_RESTRICT p1_out,
+                                     f64x4& KLN_RESTRICT p2_out)
+    {
+        if (all_eq_pd(a, setzero_pd()))
+        {
+            p1_out = set_sd(1.0);
+            p2_out = b;
+            return;
+        }
+
+        f64x4 a2          = hi_dp_bc(a, a);
+        f64x4 ab          = hi_dp_bc(a, b);
+        f64x4 a2_sqrt_rcp = div_pd(set1_pd(1.0), sqrt_pd(a2));
+        f64x4 u           = mul_pd(a2, a2_sqrt_rcp);
+        f64x4 minus_v     = mul_pd(ab, a2_sqrt_rcp);
+
+        f64x4 norm_real  = mul_pd(a, a2_sqrt_rcp);
+        f64x4 norm_ideal = mul_pd(b, a2_sqrt_rcp);
+        norm_ideal       = sub_pd(
+            norm_ideal,
+            mul_pd(a, mul_pd(ab, div_pd(a2_sqrt_rcp, a2))));
+
+        double uv[2] = {first_pd(u), first_pd(minus_v)};
+        double sinu  = std::sin(uv[0]);
+        double cosu  = std::cos(uv[0]);
+
+        f64x4 sinu_vec = set1_pd(sinu);
+        p1_out = add_pd(set_sd(cosu), mul_pd(sinu_vec, norm_real));
+
+        f64x4 minus_vcosu = mul_pd(minus_v, set_pd(cosu, cosu, cosu, 0.0));
+        p2_out            = mul_pd(sinu_vec, norm_ideal);
+        p2_out            = add_pd(p2_out, mul_pd(minus_vcosu, norm_real));
+        p2_out            = add_pd(set_sd(uv[1] * sinu), p2_out);
+    }
+
+    KLN_INLINE void KLN_VEC_CALL log(f64x4 p1,
+                                     f64x4 p2,
+                                     f64x4& KLN_RESTRICT p1_out,
+                                     f64x4& KLN_RESTRICT p2_out)
+    {
+        f64x4 bv_mask = set_pd(1.0, 1.0, 1.0, 0.0);
+        f64x4 a       = mul_pd(bv_mask, p1);
+
+        if (all_eq_pd(a, setzero_pd()))
+        {
+            p1_out = setzero_pd();
+            p2_out = p2;
+            return;
+        }
+
+        f64x4 b = mul_pd(bv_mask, p2);
+
+        f64x4 a2          = hi_dp_bc(a, a);
+        f64x4 ab          = hi_dp_bc(a, b);
+        f64x4 a2_sqrt_rcp = div_pd(set1_pd(1.0), sqrt_pd(a2));
+        f64x4 s           = mul_pd(a2, a2_sqrt_rcp);
+        f64x4 minus_t     = mul_pd(ab, a2_sqrt_rcp);
+
+        // p = cosu
+        // q = -v sinu
+        // s_scalar = sinu
+        // t_scalar = v cosu
+        double p        = first_pd(p1);
+        double q        = first_pd(p2);
+        double s_scalar = first_pd(s);
+        double t_scalar = -first_pd(minus_t);
+
+        bool p_zero = std::abs(p) < 1e-6;
+        double u = p_zero ? std::atan2(-q, t_scalar) : std::atan2(s_scalar, p);
+        double v = p_zero ? -q / s_scalar : t_scalar / p;
+
+        f64x4 norm_real  = mul_pd(a, a2_sqrt_rcp);
+        f64x4 norm_ideal = mul_pd(b, a2_sqrt_rcp);
+        norm_ideal       = sub_pd(
+            norm_ideal,
+            mul_pd(a, mul_pd(ab, div_pd(a2_sqrt_rcp, a2))));
+
+        f64x4 uvec = set1_pd(u);
+        p1_out     = mul_pd(uvec, norm_real);
+        p2_out     = mul_pd(uvec, norm_ideal);
+        p2_out     = sub_pd(p2_out, mul_pd(set1_pd(v), norm_real));
+    }
+} // namespace detail
+
+// Matrix conversion
+
+// Convert a motor (or rotor if Translate is false) to a column-major 4x4
+template <bool Translate, bool Normalized>
+KLN_INLINE void KLN_VEC_CALL mat4x4_12(detail::f64x4 b,
+                                       detail::f64x4 const* c,
+                                       detail::f64x4* out) noexcept
+{
+    using namespace detail;
+
+    double buf[4];
+    storeu_pd(buf, mul_pd(b, b));
+    double b0_2 = buf[0];
+    double b1_2 = buf[1];
+    double b2_2 = buf[2];
+    double b3_2 = buf[3];
+
+    f64x4& c0 = out[0];
+    c0        = mul_pd(b, KLN_SWIZZLE_PD(b, 0, 0, 2, 0));
+    f64x4 tmp = mul_pd(KLN_SWIZZLE_PD(b, 0, 1, 3, 1),
+                       KLN_SWIZZLE_PD(b, 0, 3, 0, 1));
+    tmp       = xor_pd(set_pd(0.0, 0.0, -0.0, 0.0), tmp);
+    c0        = mul_pd(set_pd(0.0, 2.0, 2.0, 1.0), add_pd(c0, tmp));
+    c0        = sub_pd(c0, set_sd(b3_2 + b2_2));
+
+    f64x4& c1 = out[1];
+    c1        = mul_pd(b, KLN_SWIZZLE_PD(b, 0, 3, 1, 3));
+    tmp       = mul_pd(KLN_SWIZZLE_PD(b, 0, 0, 3, 2),
+                 KLN_SWIZZLE_PD(b, 0, 1, 3, 1));
+    tmp       = xor_pd(set_pd(0.0, -0.0, 0.0, 0.0), tmp);
+    c1        = mul_pd(set_pd(0.0, 2.0, -1.0, 2.0), add_pd(c1, tmp));
+    c1        = add_pd(c1, set_pd(0.0, 0.0, b0_2 + b2_2, 0.0));
+
+    f64x4& c2 = out[2];
+    c2        = xor_pd(set_pd(0.0, -0.0, 0.0, -0.0),
+                mul_pd(b, KLN_SWIZZLE_PD(b, 0, 2, 0, 2)));
+    c2        = add_pd(c2,
+                mul_pd(KLN_SWIZZLE_PD(b, 0, 0, 2, 1),
+                       KLN_SWIZZLE_PD(b, 0, 0, 3, 3)));
+    c2        = mul_pd(c2, set_pd(0.0, 1.0, 2.0, 2.0));
+    c2        = add_pd(c2, set_pd(0.0, b3_2 - b1_2, 0.0, 0.0));
+
+    f64x4& c3 = out[3];
+    c3        = setzero_pd();
+    if (Translate)
+    {
+        c3  = mul_pd(b, KLN_SWIZZLE_PD(*c, 0, 1, 3, 1));
+        c3  = add_pd(c3,
+                    mul_pd(KLN_SWIZZLE_PD(b, 0, 0, 0, 3),
+                           KLN_SWIZZLE_PD(*c, 0, 3, 2, 2)));
+        c3  = add_pd(c3,
+                    mul_pd(KLN_SWIZZLE_PD(b, 0, 3, 2, 1),
+                           KLN_SWIZZLE_PD(*c, 0, 0, 0, 0)));
+        tmp = mul_pd(KLN_SWIZZLE_PD(b, 0, 1, 3, 2),
+                     KLN_SWIZZLE_PD(*c, 0, 2, 1, 3));
+        c3  = mul_pd(set_pd(0.0, 2.0, 2.0, 2.0), sub_pd(tmp, c3));
+    }
+    double w = Normalized ? 1.0 : b0_2 + b1_2 + b2_2 + b3_2;
+    c3       = blend_pd<0b1000>(c3, set1_pd(w));
+}
+} // namespace kln
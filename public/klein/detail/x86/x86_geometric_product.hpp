@@ -361,5 +361,144 @@ namespace detail
         t = _mm_xor_ps(t, s_flip);
         f = _mm_sub_ps(f, t);
     }
+
+#ifdef KLEIN_AVX2
+    // gpMM on two motor pairs at once. Each register holds the same partition
+    // of two different motors, one per 128-bit lane. The arithmetic is
+    // identical to gpMM above since KLN_SWIZZLE256 never crosses lanes.
+    KLN_INLINE void KLN_VEC_CALL gpMM256(__m256 a,
+                                         __m256 b,
+                                         __m256 c,
+                                         __m256 d,
+                                         __m256& KLN_RESTRICT e,
+                                         __m256& KLN_RESTRICT f) noexcept
+    {
+        __m256 a_xxxx = KLN_SWIZZLE256(a, 0, 0, 0, 0);
+        __m256 a_zyzw = KLN_SWIZZLE256(a, 3, 2, 1, 2);
+        __m256 a_ywyz = KLN_SWIZZLE256(a, 2, 1, 3, 1);
+        __m256 a_wzwy = KLN_SWIZZLE256(a, 1, 3, 2, 3);
+        __m256 c_wwyz = KLN_SWIZZLE256(c, 2, 1, 3, 3);
+        __m256 c_yzwy = KLN_SWIZZLE256(c, 1, 3, 2, 1);
+        __m256 s_flip
+            = _mm256_setr_ps(-0.f, 0.f, 0.f, 0.f, -0.f, 0.f, 0.f, 0.f);
+
+        e = _mm256_mul_ps(a_xxxx, c);
+        __m256 t = _mm256_mul_ps(a_ywyz, c_yzwy);
+        t = _mm256_fmadd_ps(a_zyzw, KLN_SWIZZLE256(c, 0, 0, 0, 2), t);
+        t = _mm256_xor_ps(t, s_flip);
+        e = _mm256_add_ps(e, t);
+        e = _mm256_fnmadd_ps(a_wzwy, c_wwyz, e);
+
+        f = _mm256_mul_ps(a_xxxx, d);
+        f = _mm256_fmadd_ps(b, KLN_SWIZZLE256(c, 0, 0, 0, 0), f);
+        f = _mm256_fmadd_ps(a_ywyz, KLN_SWIZZLE256(d, 1, 3, 2, 1), f);
+        f = _mm256_fmadd_ps(KLN_SWIZZLE256(b, 2, 1, 3, 1), c_yzwy, f);
+        t = _mm256_mul_ps(a_zyzw, KLN_SWIZZLE256(d, 0, 0, 0, 2));
+        t = _mm256_fmadd_ps(a_wzwy, KLN_SWIZZLE256(d, 2, 1, 3, 3), t);
+        t = _mm256_fmadd_ps(KLN_SWIZZLE256(b, 0, 0, 0, 2),
+                            KLN_SWIZZLE256(c, 3, 2, 1, 2),
+                            t);
+        t = _mm256_fmadd_ps(KLN_SWIZZLE256(b, 1, 3, 2, 3), c_wwyz, t);
+        t = _mm256_xor_ps(t, s_flip);
+        f = _mm256_sub_ps(f, t);
+    }
+#endif
+
+    // Batched motor * motor over arrays of packed (p1, p2) partitions.
+    //
+    // If Broadcast is false, out[i] = a[i] * b[i]. Otherwise, a points to a
+    // single motor and out[i] = a * b[i].
+    //
+    // Every iteration loads all of its operands before storing anything, so
+    // out may alias a or b. Iterations carry no dependencies which leaves the
+    // compiler free to overlap the loads of one iteration with the arithmetic
+    // of the previous.
+    template <bool Broadcast>
+    KLN_INLINE void KLN_VEC_CALL gpMM(__m128 const* a,
+                                      __m128 const* b,
+                                      __m128* out,
+                                      size_t count) noexcept
+    {
+        size_t i = 0;
+#ifdef KLEIN_AVX2
+        // Two motors per iteration. A load of one motor yields (p1 | p2), so
+        // pairs of loads are regrouped into (p1 | p1') and (p2 | p2').
+        float const* fa = reinterpret_cast<float const*>(a);
+        float const* fb = reinterpret_cast<float const*>(b);
+        float* fo       = reinterpret_cast<float*>(out);
+        __m256 a1       = _mm256_setzero_ps();
+        __m256 a2       = _mm256_setzero_ps();
+        if (Broadcast)
+        {
+            a1 = bc256(a[0]);
+            a2 = bc256(a[1]);
+        }
+        for (; i + 2 <= count; i += 2)
+        {
+            if (!Broadcast)
+            {
+                __m256 m0 = _mm256_loadu_ps(fa + 8 * i);
+                __m256 m1 = _mm256_loadu_ps(fa + 8 * i + 8);
+                a1        = _mm256_permute2f128_ps(m0, m1, 0x20);
+                a2        = _mm256_permute2f128_ps(m0, m1, 0x31);
+            }
+            __m256 n0 = _mm256_loadu_ps(fb + 8 * i);
+            __m256 n1 = _mm256_loadu_ps(fb + 8 * i + 8);
+            __m256 b1 = _mm256_permute2f128_ps(n0, n1, 0x20);
+            __m256 b2 = _mm256_permute2f128_ps(n0, n1, 0x31);
+
+            __m256 e;
+            __m256 f;
+            gpMM256(a1, a2, b1, b2, e, f);
+
+            _mm256_storeu_ps(fo + 8 * i, _mm256_permute2f128_ps(e, f, 0x20));
+            _mm256_storeu_ps(fo + 8 * i + 8,
+                             _mm256_permute2f128_ps(e, f, 0x31));
+        }
+#endif
+        __m128 lhs[2] = {_mm_setzero_ps(), _mm_setzero_ps()};
+        if (Broadcast)
+        {
+            lhs[0] = a[0];
+            lhs[1] = a[1];
+        }
+        for (; i != count; ++i)
+        {
+            if (!Broadcast)
+            {
+                lhs[0] = a[2 * i];
+                lhs[1] = a[2 * i + 1];
+            }
+            __m128 rhs[2] = {b[2 * i], b[2 * i + 1]};
+            gpMM(lhs[0], rhs[0], out + 2 * i);
+        }
+    }
+
+    // Running product over an array of motors: out[0] = in[0] and
+    // out[i] = out[i - 1] * in[i]. The accumulator stays in registers rather
+    // than being reloaded from out. in and out may alias.
+    KLN_INLINE void KLN_VEC_CALL gpMM_prefix(__m128 const* in,
+                                             __m128* out,
+                                             size_t count) noexcept
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        __m128 acc[2] = {in[0], in[1]};
+        out[0]        = acc[0];
+        out[1]        = acc[1];
+        for (size_t i = 1; i != count; ++i)
+        {
+            __m128 next[2] = {in[2 * i], in[2 * i + 1]};
+            __m128 tmp[2];
+            gpMM(acc[0], next[0], tmp);
+            acc[0]         = tmp[0];
+            acc[1]         = tmp[1];
+            out[2 * i]     = tmp[0];
+            out[2 * i + 1] = tmp[1];
+        }
+    }
 } // namespace detail
 } // namespace kln
\ No newline at end of file
@@ -10,6 +10,8 @@
 
 #include "x86_sse.hpp"
 
+#include <cstddef>
+
 namespace kln
 {
 // Partition memory layouts
@@ -118,6 +120,10 @@ KLN_INLINE void KLN_VEC_CALL mat4x4_12(__m128 b,
         tmp = _mm_mul_ps(KLN_SWIZZLE(b, 0, 1, 3, 2), KLN_SWIZZLE(*c, 0, 2, 1, 3));
         c3 = _mm_mul_ps(_mm_set_ps(0.f, 2.f, 2.f, 2.f), _mm_sub_ps(tmp, c3));
     }
+    else
+    {
+        c3 = _mm_setzero_ps();
+    }
     if constexpr (Normalized)
     {
 #    ifdef KLEIN_SSE_4_1
@@ -139,4 +145,182 @@ KLN_INLINE void KLN_VEC_CALL mat4x4_12(__m128 b,
 #else
 #    include "x86_matrix_cxx11.inl"
 #endif
+
+// Store a matrix column either through the cache or with a non-temporal store
+// that bypasses it. The latter is preferable when the destination is
+// write-combined memory (e.g. a mapped GPU upload buffer) or is not read back
+// by the CPU soon after.
+template <bool Stream>
+KLN_INLINE void KLN_VEC_CALL store_col(__m128* out, __m128 col) noexcept
+{
+    if (Stream)
+    {
+        _mm_stream_ps(reinterpret_cast<float*>(out), col);
+    }
+    else
+    {
+        *out = col;
+    }
+}
+
+// Convert an array of rotors (Translate = false) or motors (Translate = true)
+// to column-major 4x4 matrices. Instead of spilling the squared components of
+// each motor to scalars as mat4x4_12 does, four motors are transposed so that
+// each register holds one component of four motors and every matrix entry is
+// computed for all four lanes at once. The entries are then transposed back
+// into columns. Remainders are handled by mat4x4_12.
+template <bool Translate, bool Normalized, bool Stream>
+KLN_INLINE void KLN_VEC_CALL mat4x4_12(__m128 const* in,
+                                       __m128* out,
+                                       size_t count) noexcept
+{
+    size_t const stride = Translate ? 2 : 1;
+    __m128 const two    = _mm_set1_ps(2.f);
+    __m128 const zero   = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 const* m = in + stride * i;
+        __m128* o       = out + 4 * i;
+
+        // b0 = (1) b1 = (e23) b2 = (e31) b3 = (e12) of four motors
+        __m128 b0 = m[0];
+        __m128 b1 = m[stride];
+        __m128 b2 = m[2 * stride];
+        __m128 b3 = m[3 * stride];
+        _MM_TRANSPOSE4_PS(b0, b1, b2, b3);
+
+        __m128 b0_2 = _mm_mul_ps(b0, b0);
+        __m128 b1_2 = _mm_mul_ps(b1, b1);
+        __m128 b2_2 = _mm_mul_ps(b2, b2);
+        __m128 b3_2 = _mm_mul_ps(b3, b3);
+        __m128 b0b1 = _mm_mul_ps(b0, b1);
+        __m128 b0b2 = _mm_mul_ps(b0, b2);
+        __m128 b0b3 = _mm_mul_ps(b0, b3);
+        __m128 b1b2 = _mm_mul_ps(b1, b2);
+        __m128 b1b3 = _mm_mul_ps(b1, b3);
+        __m128 b2b3 = _mm_mul_ps(b2, b3);
+
+        // See the column derivations in mat4x4_12 above. Entry rij is the
+        // i-th row of the j-th column.
+        __m128 r00 = _mm_sub_ps(_mm_add_ps(b0_2, b1_2), _mm_add_ps(b2_2, b3_2));
+        __m128 r10 = _mm_mul_ps(two, _mm_sub_ps(b1b2, b0b3));
+        __m128 r20 = _mm_mul_ps(two, _mm_add_ps(b0b2, b1b3));
+        __m128 r01 = _mm_mul_ps(two, _mm_add_ps(b0b3, b1b2));
+        __m128 r11 = _mm_sub_ps(_mm_add_ps(b0_2, b2_2), _mm_add_ps(b1_2, b3_2));
+        __m128 r21 = _mm_mul_ps(two, _mm_sub_ps(b2b3, b0b1));
+        __m128 r02 = _mm_mul_ps(two, _mm_sub_ps(b1b3, b0b2));
+        __m128 r12 = _mm_mul_ps(two, _mm_add_ps(b0b1, b2b3));
+        __m128 r22 = _mm_sub_ps(_mm_add_ps(b0_2, b3_2), _mm_add_ps(b1_2, b2_2));
+
+        __m128 r03 = zero;
+        __m128 r13 = zero;
+        __m128 r23 = zero;
+        if (Translate)
+        {
+            // c0 = (e0123) c1 = (e01) c2 = (e02) c3 = (e03) of four motors
+            __m128 c0 = m[1];
+            __m128 c1 = m[stride + 1];
+            __m128 c2 = m[2 * stride + 1];
+            __m128 c3 = m[3 * stride + 1];
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+
+            // 2(b2 c3 - b0 c1 - b3 c2 - b1 c0)
+            r03 = _mm_sub_ps(_mm_mul_ps(b2, c3), _mm_mul_ps(b0, c1));
+            r03 = _mm_sub_ps(r03, _mm_mul_ps(b3, c2));
+            r03 = _mm_mul_ps(two, _mm_sub_ps(r03, _mm_mul_ps(b1, c0)));
+            // 2(b3 c1 - b1 c3 - b0 c2 - b2 c0)
+            r13 = _mm_sub_ps(_mm_mul_ps(b3, c1), _mm_mul_ps(b1, c3));
+            r13 = _mm_sub_ps(r13, _mm_mul_ps(b0, c2));
+            r13 = _mm_mul_ps(two, _mm_sub_ps(r13, _mm_mul_ps(b2, c0)));
+            // 2(b1 c2 - b2 c1 - b0 c3 - b3 c0)
+            r23 = _mm_sub_ps(_mm_mul_ps(b1, c2), _mm_mul_ps(b2, c1));
+            r23 = _mm_sub_ps(r23, _mm_mul_ps(b0, c3));
+            r23 = _mm_mul_ps(two, _mm_sub_ps(r23, _mm_mul_ps(b3, c0)));
+        }
+
+        __m128 r33;
+        if (Normalized)
+        {
+            r33 = _mm_set1_ps(1.f);
+        }
+        else
+        {
+            r33 = _mm_add_ps(_mm_add_ps(b0_2, b1_2), _mm_add_ps(b2_2, b3_2));
+        }
+
+        // Transpose each set of entries back into the same column of four
+        // separate matrices.
+        __m128 w0 = zero;
+        __m128 w1 = zero;
+        __m128 w2 = zero;
+        _MM_TRANSPOSE4_PS(r00, r10, r20, w0);
+        _MM_TRANSPOSE4_PS(r01, r11, r21, w1);
+        _MM_TRANSPOSE4_PS(r02, r12, r22, w2);
+        _MM_TRANSPOSE4_PS(r03, r13, r23, r33);
+
+        store_col<Stream>(o, r00);
+        store_col<Stream>(o + 1, r01);
+        store_col<Stream>(o + 2, r02);
+        store_col<Stream>(o + 3, r03);
+        store_col<Stream>(o + 4, r10);
+        store_col<Stream>(o + 5, r11);
+        store_col<Stream>(o + 6, r12);
+        store_col<Stream>(o + 7, r13);
+        store_col<Stream>(o + 8, r20);
+        store_col<Stream>(o + 9, r21);
+        store_col<Stream>(o + 10, r22);
+        store_col<Stream>(o + 11, r23);
+        store_col<Stream>(o + 12, w0);
+        store_col<Stream>(o + 13, w1);
+        store_col<Stream>(o + 14, w2);
+        store_col<Stream>(o + 15, r33);
+    }
+
+    for (; i != count; ++i)
+    {
+        __m128 cols[4];
+        mat4x4_12<Translate, Normalized>(
+            in[stride * i], Translate ? in + stride * i + 1 : nullptr, cols);
+        for (size_t j = 0; j != 4; ++j)
+        {
+            store_col<Stream>(out + 4 * i + j, cols[j]);
+        }
+    }
+
+    if (Stream)
+    {
+        // Order the non-temporal stores before anything that follows, such as
+        // handing the buffer off to another thread or the GPU.
+        _mm_sfence();
+    }
+}
+
+// Convert an array of translators to column-major 4x4 matrices. The upper
+// 3x3 block is the identity, so only the last column depends on the input.
+template <bool Stream>
+KLN_INLINE void KLN_VEC_CALL mat4x4_2(__m128 const* in,
+                                      __m128* out,
+                                      size_t count) noexcept
+{
+    // (e01, e02, e03, _) * (-2, -2, -2, 0) + (0, 0, 0, 1)
+    __m128 const scale = _mm_set_ps(0.f, -2.f, -2.f, -2.f);
+    __m128 const w     = _mm_set_ps(1.f, 0.f, 0.f, 0.f);
+    for (size_t i = 0; i != count; ++i)
+    {
+        __m128* o = out + 4 * i;
+        store_col<Stream>(o, _mm_set_ss(1.f));
+        store_col<Stream>(o + 1, _mm_set_ps(0.f, 0.f, 1.f, 0.f));
+        store_col<Stream>(o + 2, _mm_set_ps(0.f, 1.f, 0.f, 0.f));
+        store_col<Stream>(
+            o + 3,
+            _mm_add_ps(w, _mm_mul_ps(scale, KLN_SWIZZLE(in[i], 0, 3, 2, 1))));
+    }
+
+    if (Stream)
+    {
+        _mm_sfence();
+    }
+}
 } // namespace kln
\ No newline at end of file
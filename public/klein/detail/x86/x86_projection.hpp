@@ -0,0 +1,65 @@
+#pragma once
+
+#include "x86_sse.hpp"
+
+namespace kln
+{
+namespace detail
+{
+    // Partition memory layouts
+    //     LSB --> MSB
+    // p0: (e0, e1, e2, e3)
+    // p1: (1, e23, e31, e12)
+    // p2: (e0123, e01, e02, e03)
+    // p3: (e123, e032, e013, e021)
+
+    // Projection of the point p3 onto the line a ^ b for two planes a and b.
+    // This is (p3 | (a ^ b)) ^ (a ^ b), but neither the line nor the plane
+    // through p3 is formed. With d and m the p1 and p2 partitions of a ^ b as
+    // computed by ext00, p3 | (a ^ b) is the plane (p3.d) e0 - w d (dotPTL),
+    // and its meet with the line (extPB and ext02) reduces to
+    //
+    // -w(d1^2 + d2^2 + d3^2) e123 +
+    // -((p3.d) d1 + w(d2 m3 - d3 m2)) e032 +
+    // -((p3.d) d2 + w(d3 m1 - d1 m3)) e013 +
+    // -((p3.d) d3 + w(d1 m2 - d2 m1)) e021
+    //
+    // where w is the e123 component of p3. Both dot products come from a
+    // single pair of horizontal adds.
+    KLN_INLINE void KLN_VEC_CALL projPTPP(__m128 p3,
+                                          __m128 a,
+                                          __m128 b,
+                                          __m128& p3_out) noexcept
+    {
+        // The lowest components of d and m cancel to zero (see ext00)
+        __m128 d = _mm_mul_ps(a, KLN_SWIZZLE(b, 1, 3, 2, 0));
+        d        = KLN_SWIZZLE(
+            _mm_sub_ps(d, _mm_mul_ps(KLN_SWIZZLE(a, 1, 3, 2, 0), b)),
+            1,
+            3,
+            2,
+            0);
+        __m128 m = _mm_mul_ps(KLN_SWIZZLE(a, 0, 0, 0, 0), b);
+        m        = _mm_sub_ps(m, _mm_mul_ps(a, KLN_SWIZZLE(b, 0, 0, 0, 0)));
+
+        // d x m
+        __m128 dm = _mm_mul_ps(d, KLN_SWIZZLE(m, 1, 3, 2, 0));
+        dm        = KLN_SWIZZLE(
+            _mm_sub_ps(dm, _mm_mul_ps(KLN_SWIZZLE(d, 1, 3, 2, 0), m)),
+            1,
+            3,
+            2,
+            0);
+
+        // (p3.d, d.d, p3.d, d.d)
+        __m128 dp = _mm_hadd_ps(_mm_mul_ps(p3, d), _mm_mul_ps(d, d));
+        dp        = _mm_hadd_ps(dp, dp);
+
+        __m128 w = KLN_SWIZZLE(p3, 0, 0, 0, 0);
+        p3_out   = _mm_mul_ps(KLN_SWIZZLE(dp, 0, 0, 0, 0), d);
+        p3_out   = _mm_add_ps(p3_out, _mm_mul_ps(w, dm));
+        p3_out   = _mm_add_ss(p3_out, _mm_mul_ss(w, _mm_movehdup_ps(dp)));
+        p3_out   = _mm_xor_ps(p3_out, _mm_set1_ps(-0.f));
+    }
+} // namespace detail
+} // namespace kln
@@ -11,6 +11,9 @@
 //    a point or vector isn't supported at this time).
 // 3. For efficiency, the sandwich operator is NOT implemented in terms of two
 //    geometric products and a reversion. The result is nevertheless equivalent.
+// 4. When KLEIN_AVX2 is defined, the variadic paths of sw312, sw012, and swMM
+//    operate on YMM registers using FMA instructions (two points or planes, or
+//    one full line, per register). Any remainder is handled with XMM code.
 
 #pragma once
 
@@ -362,9 +365,59 @@ namespace detail
 
         size_t limit            = Variadic ? count : 1;
         constexpr size_t stride = InputP2 ? 2 : 1;
-        for (size_t i = 0; i != limit; ++i)
+        size_t i                = 0;
+
+#    ifdef KLEIN_AVX2
+        if constexpr (Variadic && InputP2)
         {
-            __m128 const& p1_in = in[stride * i]; // a
+            // Each line occupies a full YMM register (p1 in the low lane and
+            // p2 in the high lane). The rotational part acts identically on
+            // both partitions, so the temporaries are simply broadcast. The
+            // translational part only contributes to p2 and is driven by p1,
+            // so p1 is broadcast to both lanes and the low lane of each
+            // translation temporary is zeroed.
+            __m256 r0 = bc256(tmp);
+            __m256 r1 = bc256(tmp2);
+            __m256 r2 = bc256(tmp3);
+            [[maybe_unused]] __m256 t0;
+            [[maybe_unused]] __m256 t1;
+            [[maybe_unused]] __m256 t2;
+            if constexpr (Translate)
+            {
+                t0 = pack256(_mm_setzero_ps(), tmp4);
+                t1 = pack256(_mm_setzero_ps(), tmp5);
+                t2 = pack256(_mm_setzero_ps(), tmp6);
+            }
+
+            for (; i != limit; ++i)
+            {
+                float const* l_in = reinterpret_cast<float const*>(in + 2 * i);
+                __m256 l          = _mm256_loadu_ps(l_in);
+
+                __m256 l_out = _mm256_mul_ps(r0, l);
+                l_out        = _mm256_fmadd_ps(
+                    r1, KLN_SWIZZLE256(l, 1, 3, 2, 0), l_out);
+                l_out = _mm256_fmadd_ps(
+                    r2, KLN_SWIZZLE256(l, 2, 1, 3, 0), l_out);
+
+                if constexpr (Translate)
+                {
+                    __m256 p1_in = _mm256_broadcast_ps(in + 2 * i);
+                    l_out        = _mm256_fmadd_ps(t0, p1_in, l_out);
+                    l_out        = _mm256_fmadd_ps(
+                        t1, KLN_SWIZZLE256(p1_in, 2, 1, 3, 0), l_out);
+                    l_out = _mm256_fmadd_ps(
+                        t2, KLN_SWIZZLE256(p1_in, 1, 3, 2, 0), l_out);
+                }
+
+                _mm256_storeu_ps(reinterpret_cast<float*>(out + 2 * i), l_out);
+            }
+        }
+#    endif
+
+        for (; i != limit; ++i)
+        {
+            __m128 p1_in        = in[stride * i]; // a
             __m128 p1_in_xzwy   = KLN_SWIZZLE(p1_in, 1, 3, 2, 0);
             __m128 p1_in_xwyz   = KLN_SWIZZLE(p1_in, 2, 1, 3, 0);
 
@@ -376,7 +429,7 @@ namespace detail
 
             if constexpr (InputP2)
             {
-                __m128 const& p2_in = in[2 * i + 1]; // d
+                __m128 p2_in        = in[2 * i + 1]; // d
                 __m128& p2_out      = out[2 * i + 1];
                 p2_out              = _mm_mul_ps(tmp, p2_in);
                 p2_out              = _mm_add_ps(
@@ -494,17 +547,51 @@ namespace detail
         // dependence on b and c.
 
         size_t limit = Variadic ? count : 1;
-        for (size_t i = 0; i != limit; ++i)
+        size_t i     = 0;
+
+#    ifdef KLEIN_AVX2
+        if constexpr (Variadic)
+        {
+            // Two planes per YMM register
+            __m256 t1 = bc256(tmp1);
+            __m256 t2 = bc256(tmp2);
+            __m256 t3 = bc256(tmp3);
+            [[maybe_unused]] __m256 t4;
+            if constexpr (Translate)
+            {
+                t4 = bc256(tmp4);
+            }
+
+            for (; i + 2 <= limit; i += 2)
+            {
+                __m256 a2
+                    = _mm256_loadu_ps(reinterpret_cast<float const*>(a + i));
+                __m256 p  = _mm256_mul_ps(t1, KLN_SWIZZLE256(a2, 1, 3, 2, 0));
+                p = _mm256_fmadd_ps(t2, KLN_SWIZZLE256(a2, 2, 1, 3, 0), p);
+                p = _mm256_fmadd_ps(t3, a2, p);
+
+                if constexpr (Translate)
+                {
+                    p = _mm256_add_ps(p, _mm256_dp_ps(t4, a2, 0b11100001));
+                }
+
+                _mm256_storeu_ps(reinterpret_cast<float*>(out + i), p);
+            }
+        }
+#    endif
+
+        for (; i != limit; ++i)
         {
             // Compute the lower block for components e1, e2, and e3
-            __m128& p = out[i];
-            p         = _mm_mul_ps(tmp1, KLN_SWIZZLE(a[i], 1, 3, 2, 0));
-            p = _mm_add_ps(p, _mm_mul_ps(tmp2, KLN_SWIZZLE(a[i], 2, 1, 3, 0)));
-            p = _mm_add_ps(p, _mm_mul_ps(tmp3, a[i]));
+            __m128 a_i = a[i];
+            __m128& p  = out[i];
+            p          = _mm_mul_ps(tmp1, KLN_SWIZZLE(a_i, 1, 3, 2, 0));
+            p = _mm_add_ps(p, _mm_mul_ps(tmp2, KLN_SWIZZLE(a_i, 2, 1, 3, 0)));
+            p = _mm_add_ps(p, _mm_mul_ps(tmp3, a_i));
 
             if constexpr (Translate)
             {
-                __m128 tmp5 = hi_dp(tmp4, a[i]);
+                __m128 tmp5 = hi_dp(tmp4, a_i);
                 p           = _mm_add_ps(p, tmp5);
             }
         }
@@ -582,17 +669,52 @@ namespace detail
         }
 
         size_t limit = Variadic ? count : 1;
-        for (size_t i = 0; i != limit; ++i)
+        size_t i     = 0;
+
+#    ifdef KLEIN_AVX2
+        if constexpr (Variadic)
+        {
+            // Two points per YMM register
+            __m256 t1 = bc256(tmp1);
+            __m256 t2 = bc256(tmp2);
+            __m256 t3 = bc256(tmp3);
+            [[maybe_unused]] __m256 t4;
+            if constexpr (Translate)
+            {
+                t4 = bc256(tmp4);
+            }
+
+            for (; i + 2 <= limit; i += 2)
+            {
+                __m256 a2
+                    = _mm256_loadu_ps(reinterpret_cast<float const*>(a + i));
+                __m256 p  = _mm256_mul_ps(t1, KLN_SWIZZLE256(a2, 2, 1, 3, 0));
+                p = _mm256_fmadd_ps(t2, KLN_SWIZZLE256(a2, 1, 3, 2, 0), p);
+                p = _mm256_fmadd_ps(t3, a2, p);
+
+                if constexpr (Translate)
+                {
+                    p = _mm256_fmadd_ps(
+                        t4, KLN_SWIZZLE256(a2, 0, 0, 0, 0), p);
+                }
+
+                _mm256_storeu_ps(reinterpret_cast<float*>(out + i), p);
+            }
+        }
+#    endif
+
+        for (; i != limit; ++i)
         {
-            __m128& p = out[i];
-            p         = _mm_mul_ps(tmp1, KLN_SWIZZLE(a[i], 2, 1, 3, 0));
-            p = _mm_add_ps(p, _mm_mul_ps(tmp2, KLN_SWIZZLE(a[i], 1, 3, 2, 0)));
-            p = _mm_add_ps(p, _mm_mul_ps(tmp3, a[i]));
+            __m128 a_i = a[i];
+            __m128& p  = out[i];
+            p          = _mm_mul_ps(tmp1, KLN_SWIZZLE(a_i, 2, 1, 3, 0));
+            p = _mm_add_ps(p, _mm_mul_ps(tmp2, KLN_SWIZZLE(a_i, 1, 3, 2, 0)));
+            p = _mm_add_ps(p, _mm_mul_ps(tmp3, a_i));
 
             if constexpr (Translate)
             {
                 p = _mm_add_ps(
-                    p, _mm_mul_ps(tmp4, KLN_SWIZZLE(a[i], 0, 0, 0, 0)));
+                    p, _mm_mul_ps(tmp4, KLN_SWIZZLE(a_i, 0, 0, 0, 0)));
             }
         }
     }
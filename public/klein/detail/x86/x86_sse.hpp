@@ -3,7 +3,15 @@
 // intrinsics
 #pragma once
 
-#ifdef KLEIN_SSE_4_1
+// AVX2 hardware always supports SSE4.1 so the SSE4.1 code paths are enabled
+// implicitly
+#if defined(KLEIN_AVX2) && !defined(KLEIN_SSE_4_1)
+#    define KLEIN_SSE_4_1
+#endif
+
+#ifdef KLEIN_AVX2
+#    include <immintrin.h>
+#elif defined(KLEIN_SSE_4_1)
 #    include <smmintrin.h>
 #else
 #    include <tmmintrin.h>
@@ -20,6 +28,16 @@
         _mm_shuffle_ps((reg), (reg), _MM_SHUFFLE(x, y, z, w))
 #endif
 
+#ifdef KLEIN_AVX2
+// Apply the same swizzle to both 128-bit lanes of a YMM register.
+//
+// KLN_SWIZZLE256(reg, 3, 2, 1, 0) is the identity.
+#    ifndef KLN_SWIZZLE256
+#        define KLN_SWIZZLE256(reg, x, y, z, w) \
+            _mm256_permute_ps((reg), _MM_SHUFFLE(x, y, z, w))
+#    endif
+#endif
+
 #ifndef KLN_RESTRICT
 #    define KLN_RESTRICT __restrict
 #endif
@@ -189,5 +207,34 @@ namespace detail
         return KLN_SWIZZLE(out, 0, 0, 0, 0);
     }
 #endif
+
+#ifdef KLEIN_AVX2
+    // Pack two XMM registers into the low and high lanes of a YMM register
+    KLN_INLINE __m256 KLN_VEC_CALL pack256(__m128 lo, __m128 hi) noexcept
+    {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    }
+
+    // Broadcast an XMM register to both lanes of a YMM register
+    KLN_INLINE __m256 KLN_VEC_CALL bc256(__m128 a) noexcept
+    {
+        return pack256(a, a);
+    }
+
+    // YMM counterparts of rcp_nr1 and rsqrt_nr1 above
+    KLN_INLINE __m256 KLN_VEC_CALL rcp_nr1(__m256 a) noexcept
+    {
+        __m256 xn = _mm256_rcp_ps(a);
+        return _mm256_mul_ps(xn, _mm256_fnmadd_ps(a, xn, _mm256_set1_ps(2.f)));
+    }
+
+    KLN_INLINE __m256 KLN_VEC_CALL rsqrt_nr1(__m256 a) noexcept
+    {
+        __m256 xn   = _mm256_rsqrt_ps(a);
+        __m256 axn2 = _mm256_mul_ps(a, _mm256_mul_ps(xn, xn));
+        __m256 xn3  = _mm256_sub_ps(_mm256_set1_ps(3.f), axn2);
+        return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), xn), xn3);
+    }
+#endif
 } // namespace detail
 } // namespace kln
\ No newline at end of file
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "detail/dispatch_table.hpp"
+#include "line.hpp"
+#include "mat3x4.hpp"
+#include "mat4x4.hpp"
+#include "motor.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+#include "rotor.hpp"
+
+namespace kln
+{
+/// \defgroup dispatch Runtime Dispatch
+///
+/// The header-only library selects its instruction set at compile time via
+/// the `klein`, `klein_sse42`, and `klein_avx2` targets. Applications that
+/// ship a single binary to machines of differing capability can instead
+/// link the `klein::klein_dispatch` library and call the array entry points
+/// in the `kln::dispatch` namespace. The library contains a copy of each
+/// batch kernel compiled for SSE3, SSE4.1, and AVX2+FMA. The CPU is queried
+/// once on first use and the best supported kernel table is bound for the
+/// lifetime of the process.
+///
+/// ```cpp
+///     #include <klein/dispatch.hpp>
+///
+///     kln::motor m = ...;
+///     // Uses _mm_dp_ps or 256-bit kernels where available
+///     kln::dispatch::apply(m, points, points, count);
+/// ```
+///
+/// !!! tip
+///
+///     Dispatch adds an indirect call per batch, not per entity. For a
+///     handful of entities, prefer the header-only entry points.
+///
+/// !!! danger
+///
+///     This header is not included by `klein.hpp`. It requires linking
+///     against `klein::klein_dispatch`.
+
+/// \addtogroup dispatch
+/// @{
+namespace dispatch
+{
+    /// Highest instruction set level supported by the host CPU and OS. The
+    /// result is computed once and cached.
+    [[nodiscard]] isa detect() noexcept;
+
+    /// Kernel table compiled for `level`, or `nullptr` if the host cannot
+    /// execute it.
+    [[nodiscard]] kernel_table const* table(isa level) noexcept;
+
+    /// The kernel table in use. On first call, this binds the table matching
+    /// `detect()`.
+    [[nodiscard]] kernel_table const& active() noexcept;
+
+    /// Rebind the active kernel table to a specific level (e.g. to compare
+    /// paths in tests or to work around a faulty host). Returns `false` and
+    /// leaves the binding unchanged if the level is unsupported.
+    bool bind(isa level) noexcept;
+
+    /// Conjugate `count` planes with a motor (see
+    /// `motor::operator()(plane*, plane*, size_t)`).
+    inline void apply(motor const& m,
+                      plane const* in,
+                      plane* out,
+                      size_t count) noexcept
+    {
+        active().motor_planes(&m.p1_, &in->p0_, &out->p0_, count);
+    }
+
+    /// Conjugate `count` lines with a motor (see
+    /// `motor::operator()(line*, line*, size_t)`).
+    inline void apply(motor const& m,
+                      line const* in,
+                      line* out,
+                      size_t count) noexcept
+    {
+        active().motor_lines(&m.p1_, &in->p1_, &out->p1_, count);
+    }
+
+    /// Conjugate `count` points with a motor (see
+    /// `motor::operator()(point*, point*, size_t)`).
+    inline void apply(motor const& m,
+                      point const* in,
+                      point* out,
+                      size_t count) noexcept
+    {
+        active().motor_points(&m.p1_, &in->p3_, &out->p3_, count);
+    }
+
+    /// Conjugate `count` planes with a rotor.
+    inline void apply(rotor const& r,
+                      plane const* in,
+                      plane* out,
+                      size_t count) noexcept
+    {
+        active().rotor_planes(&r.p1_, &in->p0_, &out->p0_, count);
+    }
+
+    /// Conjugate `count` lines with a rotor.
+    inline void apply(rotor const& r,
+                      line const* in,
+                      line* out,
+                      size_t count) noexcept
+    {
+        active().rotor_lines(&r.p1_, &in->p1_, &out->p1_, count);
+    }
+
+    /// Conjugate `count` points with a rotor.
+    inline void apply(rotor const& r,
+                      point const* in,
+                      point* out,
+                      size_t count) noexcept
+    {
+        active().rotor_points(&r.p1_, &in->p3_, &out->p3_, count);
+    }
+
+    /// Compute `out[i] = a[i] * b[i]` for `count` motors. Any of the three
+    /// arrays may alias.
+    inline void multiply(motor const* a,
+                         motor const* b,
+                         motor* out,
+                         size_t count) noexcept
+    {
+        active().motor_products(&a->p1_, &b->p1_, &out->p1_, count);
+    }
+
+    /// Convert `count` motors to 3x4 column-major matrices.
+    inline void to_mat3x4(motor const* in, mat3x4* out, size_t count) noexcept
+    {
+        active().motor_mat3x4(&in->p1_, out->cols, count);
+    }
+
+    /// Convert `count` motors to 4x4 column-major matrices.
+    inline void to_mat4x4(motor const* in, mat4x4* out, size_t count) noexcept
+    {
+        active().motor_mat4x4(&in->p1_, out->cols, count);
+    }
+} // namespace dispatch
+} // namespace kln
+/// @}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "detail/double.hpp"
+#include "line.hpp"
+
+#include <cmath>
+
+namespace kln
+{
+/// \addtogroup double
+/// @{
+
+/// Double-precision counterpart of `kln::line`, representing
+/// $a\mathbf{e}_{01} + b\mathbf{e}_{02} + c\mathbf{e}_{03} +\
+/// d\mathbf{e}_{23} + e\mathbf{e}_{31} + f\mathbf{e}_{12}$.
+///
+/// Ideal lines and branches (lines through the origin) are represented as
+/// `dline`s with a zero Euclidean or ideal part respectively.
+class dline final
+{
+public:
+    dline() noexcept = default;
+
+    /// Plücker coordinates in the same order as `kln::line`
+    dline(double a, double b, double c, double d, double e, double f) noexcept
+        : p1_{detail::set_pd(f, e, d, 0.0)}
+        , p2_{detail::set_pd(c, b, a, 0.0)}
+    {}
+
+    dline(detail::f64x4 p1, detail::f64x4 p2) noexcept
+        : p1_{p1}
+        , p2_{p2}
+    {}
+
+    /// Widen a single-precision line
+    explicit dline(line l) noexcept
+        : p1_{detail::cvtps_pd(l.p1_)}
+        , p2_{detail::cvtps_pd(l.p2_)}
+    {}
+
+    /// Round to a single-precision line
+    [[nodiscard]] line as_float() const noexcept
+    {
+        return {detail::cvtpd_ps(p1_), detail::cvtpd_ps(p2_)};
+    }
+
+    /// Returns $\sqrt{d^2 + e^2 + f^2}$ (see `kln::line::norm`)
+    [[nodiscard]] double norm() const noexcept
+    {
+        return std::sqrt(squared_norm());
+    }
+
+    /// Returns $d^2 + e^2 + f^2$
+    [[nodiscard]] double squared_norm() const noexcept
+    {
+        return detail::first_pd(detail::hi_dp(p1_, p1_));
+    }
+
+    /// Normalize a line such that $\ell^2 = -1$.
+    void normalize() noexcept
+    {
+        // See line::normalize for the derivation of s + t e0123
+        detail::f64x4 b2 = detail::hi_dp_bc(p1_, p1_);
+        detail::f64x4 s  = detail::div_pd(detail::set1_pd(1.0),
+                                         detail::sqrt_pd(b2));
+        detail::f64x4 bc = detail::hi_dp_bc(p1_, p2_);
+        detail::f64x4 t  = detail::mul_pd(detail::div_pd(bc, b2), s);
+
+        detail::f64x4 tmp = detail::mul_pd(p2_, s);
+        p2_ = detail::sub_pd(tmp, detail::mul_pd(p1_, t));
+        p1_ = detail::mul_pd(p1_, s);
+    }
+
+    [[nodiscard]] dline normalized() const noexcept
+    {
+        dline out = *this;
+        out.normalize();
+        return out;
+    }
+
+    void invert() noexcept
+    {
+        detail::f64x4 b2     = detail::hi_dp_bc(p1_, p1_);
+        detail::f64x4 s      = detail::div_pd(detail::set1_pd(1.0),
+                                         detail::sqrt_pd(b2));
+        detail::f64x4 bc     = detail::hi_dp_bc(p1_, p2_);
+        detail::f64x4 b2_inv = detail::div_pd(detail::set1_pd(1.0), b2);
+        detail::f64x4 t      = detail::mul_pd(detail::mul_pd(bc, b2_inv), s);
+        detail::f64x4 neg    = detail::set_pd(-0.0, -0.0, -0.0, 0.0);
+
+        detail::f64x4 st = detail::mul_pd(p1_, detail::mul_pd(s, t));
+        p2_ = detail::sub_pd(detail::mul_pd(p2_, b2_inv),
+                             detail::add_pd(st, st));
+        p2_ = detail::xor_pd(p2_, neg);
+        p1_ = detail::xor_pd(detail::mul_pd(p1_, b2_inv), neg);
+    }
+
+    [[nodiscard]] dline inverse() const noexcept
+    {
+        dline out = *this;
+        out.invert();
+        return out;
+    }
+
+    /// Bitwise comparison
+    [[nodiscard]] bool KLN_VEC_CALL operator==(dline other) const noexcept
+    {
+        return detail::all_eq_pd(p1_, other.p1_)
+               && detail::all_eq_pd(p2_, other.p2_);
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL approx_eq(dline other,
+                                              double epsilon) const noexcept
+    {
+        return detail::all_near_pd(p1_, other.p1_, epsilon)
+               && detail::all_near_pd(p2_, other.p2_, epsilon);
+    }
+
+    /// Line addition
+    dline& KLN_VEC_CALL operator+=(dline b) noexcept
+    {
+        p1_ = detail::add_pd(p1_, b.p1_);
+        p2_ = detail::add_pd(p2_, b.p2_);
+        return *this;
+    }
+
+    /// Line subtraction
+    dline& KLN_VEC_CALL operator-=(dline b) noexcept
+    {
+        p1_ = detail::sub_pd(p1_, b.p1_);
+        p2_ = detail::sub_pd(p2_, b.p2_);
+        return *this;
+    }
+
+    /// Line uniform scale
+    dline& operator*=(double s) noexcept
+    {
+        detail::f64x4 vs = detail::set1_pd(s);
+        p1_              = detail::mul_pd(p1_, vs);
+        p2_              = detail::mul_pd(p2_, vs);
+        return *this;
+    }
+
+    /// Line uniform inverse scale
+    dline& operator/=(double s) noexcept
+    {
+        detail::f64x4 vs = detail::set1_pd(s);
+        p1_              = detail::div_pd(p1_, vs);
+        p2_              = detail::div_pd(p2_, vs);
+        return *this;
+    }
+
+    [[nodiscard]] double e12() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p1_);
+        return out[3];
+    }
+
+    [[nodiscard]] double e21() const noexcept
+    {
+        return -e12();
+    }
+
+    [[nodiscard]] double e31() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p1_);
+        return out[2];
+    }
+
+    [[nodiscard]] double e13() const noexcept
+    {
+        return -e31();
+    }
+
+    [[nodiscard]] double e23() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p1_);
+        return out[1];
+    }
+
+    [[nodiscard]] double e32() const noexcept
+    {
+        return -e23();
+    }
+
+    [[nodiscard]] double e01() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p2_);
+        return out[1];
+    }
+
+    [[nodiscard]] double e10() const noexcept
+    {
+        return -e01();
+    }
+
+    [[nodiscard]] double e02() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p2_);
+        return out[2];
+    }
+
+    [[nodiscard]] double e20() const noexcept
+    {
+        return -e02();
+    }
+
+    [[nodiscard]] double e03() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p2_);
+        return out[3];
+    }
+
+    [[nodiscard]] double e30() const noexcept
+    {
+        return -e03();
+    }
+
+    detail::f64x4 p1_;
+    detail::f64x4 p2_;
+};
+
+/// Line addition
+[[nodiscard]] inline dline KLN_VEC_CALL operator+(dline a, dline b) noexcept
+{
+    return a += b;
+}
+
+/// Line subtraction
+[[nodiscard]] inline dline KLN_VEC_CALL operator-(dline a, dline b) noexcept
+{
+    return a -= b;
+}
+
+/// Line uniform scale
+[[nodiscard]] inline dline KLN_VEC_CALL operator*(dline l, double s) noexcept
+{
+    return l *= s;
+}
+
+/// Line uniform scale
+[[nodiscard]] inline dline KLN_VEC_CALL operator*(double s, dline l) noexcept
+{
+    return l *= s;
+}
+
+/// Line uniform inverse scale
+[[nodiscard]] inline dline KLN_VEC_CALL operator/(dline l, double s) noexcept
+{
+    return l /= s;
+}
+
+/// Unary minus
+[[nodiscard]] inline dline KLN_VEC_CALL operator-(dline l) noexcept
+{
+    detail::f64x4 flip = detail::set1_pd(-0.0);
+    return {detail::xor_pd(l.p1_, flip), detail::xor_pd(l.p2_, flip)};
+}
+
+/// Reversion operator
+[[nodiscard]] inline dline KLN_VEC_CALL operator~(dline l) noexcept
+{
+    detail::f64x4 flip = detail::set_pd(-0.0, -0.0, -0.0, 0.0);
+    return {detail::xor_pd(l.p1_, flip), detail::xor_pd(l.p2_, flip)};
+}
+/// @}
+} // namespace kln
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "detail/double.hpp"
+
+namespace kln
+{
+/// 3x4 column-major double-precision matrix (the double-precision counterpart
+/// of `kln::mat3x4`). The storage requirement is identical to a column-major
+/// `dmat4x4`.
+struct dmat3x4
+{
+    union
+    {
+        detail::f64x4 cols[4];
+        double data[16];
+    };
+
+    /// Apply the linear transformation represented by this matrix to a point
+    /// packed with the layout (x, y, z, 1.0)
+    detail::f64x4 KLN_VEC_CALL
+    operator()(detail::f64x4 const& xyzw) const noexcept
+    {
+        using namespace detail;
+        f64x4 out = mul_pd(cols[0], KLN_SWIZZLE_PD(xyzw, 0, 0, 0, 0));
+        out = add_pd(out, mul_pd(cols[1], KLN_SWIZZLE_PD(xyzw, 1, 1, 1, 1)));
+        out = add_pd(out, mul_pd(cols[2], KLN_SWIZZLE_PD(xyzw, 2, 2, 2, 2)));
+        out = add_pd(out, mul_pd(cols[3], KLN_SWIZZLE_PD(xyzw, 3, 3, 3, 3)));
+        return out;
+    }
+};
+
+/// 4x4 column-major double-precision matrix (the double-precision counterpart
+/// of `kln::mat4x4`).
+struct dmat4x4
+{
+    union
+    {
+        detail::f64x4 cols[4];
+        double data[16];
+    };
+
+    /// Apply the linear transformation represented by this matrix to a point
+    /// packed with the layout (x, y, z, 1.0)
+    detail::f64x4 KLN_VEC_CALL
+    operator()(detail::f64x4 const& xyzw) const noexcept
+    {
+        using namespace detail;
+        f64x4 out = mul_pd(cols[0], KLN_SWIZZLE_PD(xyzw, 0, 0, 0, 0));
+        out = add_pd(out, mul_pd(cols[1], KLN_SWIZZLE_PD(xyzw, 1, 1, 1, 1)));
+        out = add_pd(out, mul_pd(cols[2], KLN_SWIZZLE_PD(xyzw, 2, 2, 2, 2)));
+        out = add_pd(out, mul_pd(cols[3], KLN_SWIZZLE_PD(xyzw, 3, 3, 3, 3)));
+        return out;
+    }
+};
+} // namespace kln
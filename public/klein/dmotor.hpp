@@ -0,0 +1,408 @@
+#pragma once
+
+#include "detail/double.hpp"
+#include "dline.hpp"
+#include "dmat.hpp"
+#include "dplane.hpp"
+#include "dpoint.hpp"
+#include "drotor.hpp"
+#include "dtranslator.hpp"
+#include "motor.hpp"
+
+#include <cstddef>
+
+namespace kln
+{
+/// \addtogroup double
+/// @{
+
+/// Double-precision counterpart of `kln::motor`, representing
+/// $a + b\mathbf{e}_{23} + c\mathbf{e}_{31} + d\mathbf{e}_{12} +\
+/// e\mathbf{e}_{01} + f\mathbf{e}_{02} + g\mathbf{e}_{03} +\
+/// h\mathbf{e}_{0123}$.
+class dmotor final
+{
+public:
+    dmotor() noexcept = default;
+
+    /// Direct initialization from components in the same order as
+    /// `kln::motor`
+    dmotor(double a,
+           double b,
+           double c,
+           double d,
+           double e,
+           double f,
+           double g,
+           double h) noexcept
+        : p1_{detail::set_pd(d, c, b, a)}
+        , p2_{detail::set_pd(g, f, e, h)}
+    {}
+
+    /// Produce a screw motion rotating and translating by the amounts
+    /// provided along the provided line (see the `kln::motor` constructor of
+    /// the same signature).
+    dmotor(double ang_rad, double d, dline l) noexcept
+    {
+        dline log_m;
+        detail::gpDL(
+            -ang_rad * 0.5, d * 0.5, l.p1_, l.p2_, log_m.p1_, log_m.p2_);
+        detail::exp(log_m.p1_, log_m.p2_, p1_, p2_);
+    }
+
+    dmotor(detail::f64x4 p1, detail::f64x4 p2) noexcept
+        : p1_{p1}
+        , p2_{p2}
+    {}
+
+    explicit dmotor(drotor r) noexcept
+        : p1_{r.p1_}
+        , p2_{detail::setzero_pd()}
+    {}
+
+    explicit dmotor(dtranslator t) noexcept
+        : p1_{detail::set_sd(1.0)}
+        , p2_{t.p2_}
+    {}
+
+    /// Widen a single-precision motor
+    explicit dmotor(motor m) noexcept
+        : p1_{detail::cvtps_pd(m.p1_)}
+        , p2_{detail::cvtps_pd(m.p2_)}
+    {}
+
+    /// Round to a single-precision motor
+    [[nodiscard]] motor as_float() const noexcept
+    {
+        return {detail::cvtpd_ps(p1_), detail::cvtpd_ps(p2_)};
+    }
+
+    /// Load a motor from a pointer to 8 doubles with the same layout as
+    /// `kln::motor::load`.
+    void load(double const* in) noexcept
+    {
+        p1_ = detail::loadu_pd(in);
+        p2_ = detail::loadu_pd(in + 4);
+    }
+
+    /// Store the motor as 8 doubles in the layout accepted by `load`
+    void store(double* out) const noexcept
+    {
+        detail::storeu_pd(out, p1_);
+        detail::storeu_pd(out + 4, p2_);
+    }
+
+    /// Normalizes this motor $m$ such that $m\widetilde{m} = 1$ (see
+    /// `kln::motor::normalize` for the derivation).
+    void normalize() noexcept
+    {
+        detail::f64x4 neg0 = detail::set_sd(-0.0);
+        detail::f64x4 b2   = detail::dp_bc(p1_, p1_);
+        detail::f64x4 s
+            = detail::div_pd(detail::set1_pd(1.0), detail::sqrt_pd(b2));
+        detail::f64x4 bc = detail::dp_bc(detail::xor_pd(p1_, neg0), p2_);
+        detail::f64x4 t  = detail::mul_pd(detail::div_pd(bc, b2), s);
+
+        detail::f64x4 tmp = detail::mul_pd(p2_, s);
+        p2_ = detail::sub_pd(tmp, detail::xor_pd(detail::mul_pd(p1_, t), neg0));
+        p1_ = detail::mul_pd(p1_, s);
+    }
+
+    [[nodiscard]] dmotor normalized() const noexcept
+    {
+        dmotor out = *this;
+        out.normalize();
+        return out;
+    }
+
+    void invert() noexcept
+    {
+        detail::f64x4 neg0 = detail::set_sd(-0.0);
+        detail::f64x4 b2   = detail::dp_bc(p1_, p1_);
+        detail::f64x4 s
+            = detail::div_pd(detail::set1_pd(1.0), detail::sqrt_pd(b2));
+        detail::f64x4 bc = detail::dp_bc(detail::xor_pd(p1_, neg0), p2_);
+        detail::f64x4 b2_inv = detail::div_pd(detail::set1_pd(1.0), b2);
+        detail::f64x4 t   = detail::mul_pd(detail::mul_pd(bc, b2_inv), s);
+        detail::f64x4 neg = detail::set_pd(-0.0, -0.0, -0.0, 0.0);
+
+        detail::f64x4 st = detail::mul_pd(p1_, detail::mul_pd(s, t));
+        p2_              = detail::sub_pd(detail::mul_pd(p2_, b2_inv),
+                             detail::xor_pd(detail::add_pd(st, st), neg0));
+        p2_              = detail::xor_pd(p2_, neg);
+        p1_ = detail::xor_pd(detail::mul_pd(p1_, b2_inv), neg);
+    }
+
+    [[nodiscard]] dmotor inverse() const noexcept
+    {
+        dmotor out = *this;
+        out.invert();
+        return out;
+    }
+
+    /// Constrains the motor to traverse the shortest arc
+    void constrain() noexcept
+    {
+        detail::f64x4 mask = KLN_SWIZZLE_PD(
+            detail::and_pd(p1_, detail::set_sd(-0.0)), 0, 0, 0, 0);
+        p1_ = detail::xor_pd(mask, p1_);
+        p2_ = detail::xor_pd(mask, p2_);
+    }
+
+    [[nodiscard]] dmotor constrained() const noexcept
+    {
+        dmotor out = *this;
+        out.constrain();
+        return out;
+    }
+
+    /// Bitwise comparison
+    [[nodiscard]] bool KLN_VEC_CALL operator==(dmotor other) const noexcept
+    {
+        return detail::all_eq_pd(p1_, other.p1_)
+               && detail::all_eq_pd(p2_, other.p2_);
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL approx_eq(dmotor other,
+                                              double epsilon) const noexcept
+    {
+        return detail::all_near_pd(p1_, other.p1_, epsilon)
+               && detail::all_near_pd(p2_, other.p2_, epsilon);
+    }
+
+    /// Convert this motor to a 3x4 column-major matrix. The results of this
+    /// conversion are only defined if the motor is normalized.
+    [[nodiscard]] dmat3x4 as_mat3x4() const noexcept
+    {
+        dmat3x4 out;
+        mat4x4_12<true, true>(p1_, &p2_, out.cols);
+        return out;
+    }
+
+    /// Convert this motor to a 4x4 column-major matrix.
+    [[nodiscard]] dmat4x4 as_mat4x4() const noexcept
+    {
+        dmat4x4 out;
+        mat4x4_12<true, false>(p1_, &p2_, out.cols);
+        return out;
+    }
+
+    /// Conjugates a plane $p$ with this motor and returns the result
+    /// $mp\widetilde{m}$.
+    [[nodiscard]] dplane KLN_VEC_CALL operator()(dplane const& p) const noexcept
+    {
+        dplane out;
+        detail::sw012<false, true>(&p.p0_, p1_, &p2_, &out.p0_);
+        return out;
+    }
+
+    /// Conjugates an array of planes with this motor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(dplane* in,
+                                 dplane* out,
+                                 size_t count) const noexcept
+    {
+        detail::sw012<true, true>(&in->p0_, p1_, &p2_, &out->p0_, count);
+    }
+
+    /// Conjugates a line $\ell$ with this motor and returns the result
+    /// $m\ell \widetilde{m}$.
+    [[nodiscard]] dline KLN_VEC_CALL operator()(dline const& l) const noexcept
+    {
+        dline out;
+        detail::swMM<false, true, true>(&l.p1_, p1_, &p2_, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates an array of lines with this motor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(dline* in,
+                                 dline* out,
+                                 size_t count) const noexcept
+    {
+        detail::swMM<true, true, true>(&in->p1_, p1_, &p2_, &out->p1_, count);
+    }
+
+    /// Conjugates a point $p$ with this motor and returns the result
+    /// $mp\widetilde{m}$.
+    [[nodiscard]] dpoint KLN_VEC_CALL operator()(dpoint const& p) const noexcept
+    {
+        dpoint out;
+        detail::sw312<false, true>(&p.p3_, p1_, &p2_, &out.p3_);
+        return out;
+    }
+
+    /// Conjugates an array of points with this motor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(dpoint* in,
+                                 dpoint* out,
+                                 size_t count) const noexcept
+    {
+        detail::sw312<true, true>(&in->p3_, p1_, &p2_, &out->p3_, count);
+    }
+
+    /// Motor addition
+    dmotor& KLN_VEC_CALL operator+=(dmotor b) noexcept
+    {
+        p1_ = detail::add_pd(p1_, b.p1_);
+        p2_ = detail::add_pd(p2_, b.p2_);
+        return *this;
+    }
+
+    /// Motor subtraction
+    dmotor& KLN_VEC_CALL operator-=(dmotor b) noexcept
+    {
+        p1_ = detail::sub_pd(p1_, b.p1_);
+        p2_ = detail::sub_pd(p2_, b.p2_);
+        return *this;
+    }
+
+    /// Motor uniform scale
+    dmotor& operator*=(double s) noexcept
+    {
+        detail::f64x4 vs = detail::set1_pd(s);
+        p1_              = detail::mul_pd(p1_, vs);
+        p2_              = detail::mul_pd(p2_, vs);
+        return *this;
+    }
+
+    /// Motor uniform inverse scale
+    dmotor& operator/=(double s) noexcept
+    {
+        detail::f64x4 vs = detail::set1_pd(s);
+        p1_              = detail::div_pd(p1_, vs);
+        p2_              = detail::div_pd(p2_, vs);
+        return *this;
+    }
+
+    [[nodiscard]] double scalar() const noexcept
+    {
+        return detail::first_pd(p1_);
+    }
+
+    [[nodiscard]] double e12() const noexcept
+    {
+        double out[8];
+        store(out);
+        return out[3];
+    }
+
+    [[nodiscard]] double e21() const noexcept
+    {
+        return -e12();
+    }
+
+    [[nodiscard]] double e31() const noexcept
+    {
+        double out[8];
+        store(out);
+        return out[2];
+    }
+
+    [[nodiscard]] double e13() const noexcept
+    {
+        return -e31();
+    }
+
+    [[nodiscard]] double e23() const noexcept
+    {
+        double out[8];
+        store(out);
+        return out[1];
+    }
+
+    [[nodiscard]] double e32() const noexcept
+    {
+        return -e23();
+    }
+
+    [[nodiscard]] double e01() const noexcept
+    {
+        double out[8];
+        store(out);
+        return out[5];
+    }
+
+    [[nodiscard]] double e10() const noexcept
+    {
+        return -e01();
+    }
+
+    [[nodiscard]] double e02() const noexcept
+    {
+        double out[8];
+        store(out);
+        return out[6];
+    }
+
+    [[nodiscard]] double e20() const noexcept
+    {
+        return -e02();
+    }
+
+    [[nodiscard]] double e03() const noexcept
+    {
+        double out[8];
+        store(out);
+        return out[7];
+    }
+
+    [[nodiscard]] double e30() const noexcept
+    {
+        return -e03();
+    }
+
+    [[nodiscard]] double e0123() const noexcept
+    {
+        return detail::first_pd(p2_);
+    }
+
+    detail::f64x4 p1_;
+    detail::f64x4 p2_;
+};
+
+/// Motor addition
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator+(dmotor a, dmotor b) noexcept
+{
+    return a += b;
+}
+
+/// Motor subtraction
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator-(dmotor a, dmotor b) noexcept
+{
+    return a -= b;
+}
+
+/// Motor uniform scale
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dmotor m, double s) noexcept
+{
+    return m *= s;
+}
+
+/// Motor uniform scale
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(double s, dmotor m) noexcept
+{
+    return m *= s;
+}
+
+/// Motor uniform inverse scale
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator/(dmotor m, double s) noexcept
+{
+    return m /= s;
+}
+
+/// Unary minus
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator-(dmotor m) noexcept
+{
+    detail::f64x4 flip = detail::set1_pd(-0.0);
+    return {detail::xor_pd(m.p1_, flip), detail::xor_pd(m.p2_, flip)};
+}
+
+/// Reversion operator
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator~(dmotor m) noexcept
+{
+    detail::f64x4 flip = detail::set_pd(-0.0, -0.0, -0.0, 0.0);
+    return {detail::xor_pd(m.p1_, flip), detail::xor_pd(m.p2_, flip)};
+}
+/// @}
+} // namespace kln
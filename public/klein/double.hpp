@@ -0,0 +1,219 @@
+#pragma once
+
+#include "detail/double.hpp"
+
+#include "dline.hpp"
+#include "dmat.hpp"
+#include "dmotor.hpp"
+#include "dplane.hpp"
+#include "dpoint.hpp"
+#include "drotor.hpp"
+#include "dtranslator.hpp"
+
+namespace kln
+{
+/// \defgroup double Double Precision
+///
+/// Single precision runs out of room quickly for large worlds. A point a
+/// kilometer from the origin resolves to roughly 0.06 mm, and error
+/// accumulates further as long chains of motors are composed. The `d`-prefixed
+/// types (`dpoint`, `dplane`, `dline`, `drotor`, `dtranslator`, `dmotor`)
+/// mirror their single-precision counterparts in layout, naming, and
+/// semantics with each partition widened to four doubles. With `KLEIN_AVX2`
+/// a partition occupies a single `__m256d`; otherwise it is split across a
+/// pair of `__m128d` registers.
+///
+/// Unlike the single-precision types, square roots and divisions are computed
+/// exactly rather than with a refined reciprocal estimate, since an estimate
+/// would forfeit most of the additional precision.
+///
+/// Conversion between the two precisions is explicit. Widen with the
+/// `explicit` constructor and round back with `as_float()`.
+///
+/// ```cpp
+///     kln::dmotor world{kln::motor{...}};
+///     kln::dpoint p{1e6, 2e6, 3.25};
+///
+///     // Transform in double precision, then hand off to the renderer in
+///     // single precision relative to the camera.
+///     kln::point local = camera(world(p)).as_float();
+/// ```
+
+/// \addtogroup double
+/// @{
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dplane a, dplane b) noexcept
+{
+    dmotor out;
+    detail::gp00(a.p0_, b.p0_, out.p1_, out.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dline a, dline b) noexcept
+{
+    dmotor out;
+    detail::gpLL(&a.p1_, &b.p1_, &out.p1_);
+    return out;
+}
+
+[[nodiscard]] inline drotor KLN_VEC_CALL operator*(drotor a, drotor b) noexcept
+{
+    drotor out;
+    detail::gp11(a.p1_, b.p1_, out.p1_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(drotor a,
+                                                   dtranslator b) noexcept
+{
+    dmotor out;
+    out.p1_ = a.p1_;
+    detail::gpRT<false>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dtranslator b,
+                                                   drotor a) noexcept
+{
+    dmotor out;
+    out.p1_ = a.p1_;
+    detail::gpRT<true>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator*(dtranslator a,
+                                                        dtranslator b) noexcept
+{
+    // (1 + a)(1 + b) = 1 + a + b since the ideal parts square to zero
+    return a + b;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(drotor a, dmotor b) noexcept
+{
+    dmotor out;
+    detail::gp11(a.p1_, b.p1_, out.p1_);
+    detail::gp12<false>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dmotor b, drotor a) noexcept
+{
+    dmotor out;
+    detail::gp11(b.p1_, a.p1_, out.p1_);
+    detail::gp12<true>(a.p1_, b.p2_, out.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dtranslator a,
+                                                   dmotor b) noexcept
+{
+    dmotor out;
+    out.p1_ = b.p1_;
+    detail::gpRT<true>(b.p1_, a.p2_, out.p2_);
+    out.p2_ = detail::add_pd(out.p2_, b.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dmotor b,
+                                                   dtranslator a) noexcept
+{
+    dmotor out;
+    out.p1_ = b.p1_;
+    detail::gpRT<false>(b.p1_, a.p2_, out.p2_);
+    out.p2_ = detail::add_pd(out.p2_, b.p2_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator*(dmotor a, dmotor b) noexcept
+{
+    dmotor out;
+    detail::gpMM(&a.p1_, &b.p1_, &out.p1_);
+    return out;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator/(dplane a, dplane b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator/(dline a, dline b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+[[nodiscard]] inline drotor KLN_VEC_CALL operator/(drotor a, drotor b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator/(dtranslator a,
+                                                        dtranslator b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator/(dmotor a, drotor b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator/(dmotor a,
+                                                   dtranslator b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+[[nodiscard]] inline dmotor KLN_VEC_CALL operator/(dmotor a, dmotor b) noexcept
+{
+    b.invert();
+    return a * b;
+}
+
+/// Takes the principal branch of the logarithm of the motor, returning a
+/// bivector. Exponentiation of that bivector without any changes produces
+/// this motor again.
+[[nodiscard]] inline dline KLN_VEC_CALL log(dmotor m) noexcept
+{
+    dline out;
+    detail::log(m.p1_, m.p2_, out.p1_, out.p2_);
+    return out;
+}
+
+/// Exponentiate a line to produce a motor that possesses this line
+/// as its axis.
+[[nodiscard]] inline dmotor KLN_VEC_CALL exp(dline l) noexcept
+{
+    dmotor out;
+    detail::exp(l.p1_, l.p2_, out.p1_, out.p2_);
+    return out;
+}
+
+/// Compute the square root of the provided rotor $r$.
+[[nodiscard]] inline drotor KLN_VEC_CALL sqrt(drotor r) noexcept
+{
+    r.p1_ = detail::add_sd(r.p1_, detail::set_sd(1.0));
+    r.normalize();
+    return r;
+}
+
+/// Compute the square root of the provided translator $t$.
+[[nodiscard]] inline dtranslator KLN_VEC_CALL sqrt(dtranslator t) noexcept
+{
+    return t *= 0.5;
+}
+
+/// Compute the square root of the provided motor $m$.
+[[nodiscard]] inline dmotor KLN_VEC_CALL sqrt(dmotor m) noexcept
+{
+    m.p1_ = detail::add_sd(m.p1_, detail::set_sd(1.0));
+    m.normalize();
+    return m;
+}
+/// @}
+} // namespace kln
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "detail/double.hpp"
+#include "plane.hpp"
+
+namespace kln
+{
+/// \addtogroup double
+/// @{
+
+/// Double-precision counterpart of `kln::plane`, representing
+/// $d\mathbf{e}_0 + a\mathbf{e}_1 + b\mathbf{e}_2 + c\mathbf{e}_3$.
+class dplane final
+{
+public:
+    dplane() noexcept = default;
+
+    dplane(detail::f64x4 p0) noexcept
+        : p0_{p0}
+    {}
+
+    /// The plane $ax + by + cz + d = 0$
+    dplane(double a, double b, double c, double d) noexcept
+        : p0_{detail::set_pd(c, b, a, d)}
+    {}
+
+    /// Widen a single-precision plane
+    explicit dplane(plane p) noexcept
+        : p0_{detail::cvtps_pd(p.p0_)}
+    {}
+
+    /// Round to a single-precision plane
+    [[nodiscard]] plane as_float() const noexcept
+    {
+        return {detail::cvtpd_ps(p0_)};
+    }
+
+    /// Load four doubles with layout `(d, a, b, c)` where `d` occupies the
+    /// lowest address in memory.
+    void load(double const* data) noexcept
+    {
+        p0_ = detail::loadu_pd(data);
+    }
+
+    /// Normalize this plane $p$ such that $p \cdot p = 1$. All four
+    /// components are scaled so the plane itself is unchanged.
+    void normalize() noexcept
+    {
+        detail::f64x4 norm = detail::sqrt_pd(detail::hi_dp_bc(p0_, p0_));
+        p0_                = detail::div_pd(p0_, norm);
+    }
+
+    [[nodiscard]] dplane normalized() const noexcept
+    {
+        dplane out = *this;
+        out.normalize();
+        return out;
+    }
+
+    /// Compute the plane norm $\sqrt{a^2 + b^2 + c^2}$
+    [[nodiscard]] double norm() const noexcept
+    {
+        return detail::first_pd(
+            detail::sqrt_pd(detail::hi_dp(p0_, p0_)));
+    }
+
+    void invert() noexcept
+    {
+        p0_ = detail::div_pd(p0_, detail::hi_dp_bc(p0_, p0_));
+    }
+
+    [[nodiscard]] dplane inverse() const noexcept
+    {
+        dplane out = *this;
+        out.invert();
+        return out;
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL operator==(dplane other) const noexcept
+    {
+        return detail::all_eq_pd(p0_, other.p0_);
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL approx_eq(dplane other,
+                                              double epsilon) const noexcept
+    {
+        return detail::all_near_pd(p0_, other.p0_, epsilon);
+    }
+
+    [[nodiscard]] double x() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p0_);
+        return out[1];
+    }
+
+    [[nodiscard]] double e1() const noexcept
+    {
+        return x();
+    }
+
+    [[nodiscard]] double y() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p0_);
+        return out[2];
+    }
+
+    [[nodiscard]] double e2() const noexcept
+    {
+        return y();
+    }
+
+    [[nodiscard]] double z() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p0_);
+        return out[3];
+    }
+
+    [[nodiscard]] double e3() const noexcept
+    {
+        return z();
+    }
+
+    [[nodiscard]] double d() const noexcept
+    {
+        return detail::first_pd(p0_);
+    }
+
+    [[nodiscard]] double e0() const noexcept
+    {
+        return d();
+    }
+
+    /// Plane addition
+    dplane& KLN_VEC_CALL operator+=(dplane b) noexcept
+    {
+        p0_ = detail::add_pd(p0_, b.p0_);
+        return *this;
+    }
+
+    /// Plane subtraction
+    dplane& KLN_VEC_CALL operator-=(dplane b) noexcept
+    {
+        p0_ = detail::sub_pd(p0_, b.p0_);
+        return *this;
+    }
+
+    /// Plane uniform scale
+    dplane& operator*=(double s) noexcept
+    {
+        p0_ = detail::mul_pd(p0_, detail::set1_pd(s));
+        return *this;
+    }
+
+    /// Plane uniform inverse scale
+    dplane& operator/=(double s) noexcept
+    {
+        p0_ = detail::div_pd(p0_, detail::set1_pd(s));
+        return *this;
+    }
+
+    detail::f64x4 p0_;
+};
+
+/// Plane addition
+[[nodiscard]] inline dplane KLN_VEC_CALL operator+(dplane a, dplane b) noexcept
+{
+    return a += b;
+}
+
+/// Plane subtraction
+[[nodiscard]] inline dplane KLN_VEC_CALL operator-(dplane a, dplane b) noexcept
+{
+    return a -= b;
+}
+
+/// Plane uniform scale
+[[nodiscard]] inline dplane KLN_VEC_CALL operator*(dplane p, double s) noexcept
+{
+    return p *= s;
+}
+
+/// Plane uniform scale
+[[nodiscard]] inline dplane KLN_VEC_CALL operator*(double s, dplane p) noexcept
+{
+    return p *= s;
+}
+
+/// Plane uniform inverse scale
+[[nodiscard]] inline dplane KLN_VEC_CALL operator/(dplane p, double s) noexcept
+{
+    return p /= s;
+}
+
+/// Unary minus (leaves displacement from origin untouched, changing
+/// orientation only)
+[[nodiscard]] inline dplane KLN_VEC_CALL operator-(dplane p) noexcept
+{
+    return {detail::xor_pd(p.p0_, detail::set_pd(-0.0, -0.0, -0.0, 0.0))};
+}
+/// @}
+} // namespace kln
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "detail/double.hpp"
+#include "point.hpp"
+
+namespace kln
+{
+/// \addtogroup double
+/// @{
+
+/// Double-precision counterpart of `kln::point`, with the same component
+/// layout $w\mathbf{e}_{123} + x\mathbf{e}_{032} + y\mathbf{e}_{013} +
+/// z\mathbf{e}_{021}$.
+class dpoint final
+{
+public:
+    dpoint() noexcept = default;
+
+    dpoint(detail::f64x4 p3) noexcept
+        : p3_{p3}
+    {}
+
+    /// Component-wise constructor (homogeneous coordinate is automatically
+    /// initialized to 1)
+    dpoint(double x, double y, double z) noexcept
+        : p3_{detail::set_pd(z, y, x, 1.0)}
+    {}
+
+    /// Widen a single-precision point
+    explicit dpoint(point p) noexcept
+        : p3_{detail::cvtps_pd(p.p3_)}
+    {}
+
+    /// Round to a single-precision point
+    [[nodiscard]] point as_float() const noexcept
+    {
+        return {detail::cvtpd_ps(p3_)};
+    }
+
+    /// Load four doubles with layout `(w, x, y, z)` where `w` occupies the
+    /// lowest address in memory.
+    void load(double const* data) noexcept
+    {
+        p3_ = detail::loadu_pd(data);
+    }
+
+    /// Store the contents into an array of four doubles
+    void store(double* data) const noexcept
+    {
+        detail::storeu_pd(data, p3_);
+    }
+
+    /// Normalize this point such that the homogeneous coordinate is 1
+    void normalize() noexcept
+    {
+        p3_ = detail::div_pd(p3_, KLN_SWIZZLE_PD(p3_, 0, 0, 0, 0));
+    }
+
+    [[nodiscard]] dpoint normalized() const noexcept
+    {
+        dpoint out = *this;
+        out.normalize();
+        return out;
+    }
+
+    void invert() noexcept
+    {
+        detail::f64x4 w = KLN_SWIZZLE_PD(p3_, 0, 0, 0, 0);
+        p3_             = detail::div_pd(p3_, detail::mul_pd(w, w));
+    }
+
+    [[nodiscard]] dpoint inverse() const noexcept
+    {
+        dpoint out = *this;
+        out.invert();
+        return out;
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL approx_eq(dpoint other,
+                                              double epsilon) const noexcept
+    {
+        return detail::all_near_pd(p3_, other.p3_, epsilon);
+    }
+
+    [[nodiscard]] double x() const noexcept
+    {
+        double out[4];
+        store(out);
+        return out[1];
+    }
+
+    [[nodiscard]] double e032() const noexcept
+    {
+        return x();
+    }
+
+    [[nodiscard]] double y() const noexcept
+    {
+        double out[4];
+        store(out);
+        return out[2];
+    }
+
+    [[nodiscard]] double e013() const noexcept
+    {
+        return y();
+    }
+
+    [[nodiscard]] double z() const noexcept
+    {
+        double out[4];
+        store(out);
+        return out[3];
+    }
+
+    [[nodiscard]] double e021() const noexcept
+    {
+        return z();
+    }
+
+    /// The homogeneous coordinate `w` is exactly $1$ when normalized.
+    [[nodiscard]] double w() const noexcept
+    {
+        return detail::first_pd(p3_);
+    }
+
+    [[nodiscard]] double e123() const noexcept
+    {
+        return w();
+    }
+
+    /// Point addition
+    dpoint& KLN_VEC_CALL operator+=(dpoint b) noexcept
+    {
+        p3_ = detail::add_pd(p3_, b.p3_);
+        return *this;
+    }
+
+    /// Point subtraction
+    dpoint& KLN_VEC_CALL operator-=(dpoint b) noexcept
+    {
+        p3_ = detail::sub_pd(p3_, b.p3_);
+        return *this;
+    }
+
+    /// Point uniform scale
+    dpoint& operator*=(double s) noexcept
+    {
+        p3_ = detail::mul_pd(p3_, detail::set1_pd(s));
+        return *this;
+    }
+
+    /// Point uniform inverse scale
+    dpoint& operator/=(double s) noexcept
+    {
+        p3_ = detail::div_pd(p3_, detail::set1_pd(s));
+        return *this;
+    }
+
+    detail::f64x4 p3_;
+};
+
+/// Point addition
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator+(dpoint a, dpoint b) noexcept
+{
+    return a += b;
+}
+
+/// Point subtraction
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator-(dpoint a, dpoint b) noexcept
+{
+    return a -= b;
+}
+
+/// Point uniform scale
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator*(dpoint p, double s) noexcept
+{
+    return p *= s;
+}
+
+/// Point uniform scale
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator*(double s, dpoint p) noexcept
+{
+    return p *= s;
+}
+
+/// Point uniform inverse scale
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator/(dpoint p, double s) noexcept
+{
+    return p /= s;
+}
+
+/// Unary minus (leaves homogeneous coordinate untouched)
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator-(dpoint p) noexcept
+{
+    return {detail::xor_pd(p.p3_, detail::set_pd(-0.0, -0.0, -0.0, 0.0))};
+}
+
+/// Reversion operator
+[[nodiscard]] inline dpoint KLN_VEC_CALL operator~(dpoint p) noexcept
+{
+    return {detail::xor_pd(p.p3_, detail::set1_pd(-0.0))};
+}
+/// @}
+} // namespace kln
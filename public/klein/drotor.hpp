@@ -0,0 +1,302 @@
+#pragma once
+
+#include "detail/double.hpp"
+#include "dline.hpp"
+#include "dmat.hpp"
+#include "dplane.hpp"
+#include "dpoint.hpp"
+#include "rotor.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+namespace kln
+{
+/// \addtogroup double
+/// @{
+
+/// Double-precision counterpart of `kln::rotor`, representing
+/// $a + b\mathbf{e}_{23} + c\mathbf{e}_{31} + d\mathbf{e}_{12}$.
+class drotor final
+{
+public:
+    drotor() noexcept = default;
+
+    /// Convenience constructor. Computes transcendentals and normalizes
+    /// rotation axis.
+    drotor(double ang_rad, double x, double y, double z) noexcept
+    {
+        double norm  = std::sqrt(x * x + y * y + z * z);
+        double half  = 0.5 * ang_rad;
+        double scale = std::sin(half) / norm;
+        p1_ = detail::set_pd(z * scale, y * scale, x * scale, std::cos(half));
+    }
+
+    drotor(detail::f64x4 p1) noexcept
+        : p1_{p1}
+    {}
+
+    /// Widen a single-precision rotor
+    explicit drotor(rotor r) noexcept
+        : p1_{detail::cvtps_pd(r.p1_)}
+    {}
+
+    /// Round to a single-precision rotor
+    [[nodiscard]] rotor as_float() const noexcept
+    {
+        return {detail::cvtpd_ps(p1_)};
+    }
+
+    /// Fast load operation for packed data that is already normalized, with
+    /// the same layout `(a, b, c, d)` as `kln::rotor::load_normalized`.
+    void load_normalized(double const* data) noexcept
+    {
+        p1_ = detail::loadu_pd(data);
+    }
+
+    /// Store the contents into an array of four doubles
+    void store(double* data) const noexcept
+    {
+        detail::storeu_pd(data, p1_);
+    }
+
+    /// Normalize a rotor such that $\mathbf{r}\widetilde{\mathbf{r}} = 1$.
+    void normalize() noexcept
+    {
+        p1_ = detail::div_pd(p1_, detail::sqrt_pd(detail::dp_bc(p1_, p1_)));
+    }
+
+    [[nodiscard]] drotor normalized() const noexcept
+    {
+        drotor out = *this;
+        out.normalize();
+        return out;
+    }
+
+    void invert() noexcept
+    {
+        p1_ = detail::div_pd(p1_, detail::dp_bc(p1_, p1_));
+        p1_ = detail::xor_pd(detail::set_pd(-0.0, -0.0, -0.0, 0.0), p1_);
+    }
+
+    [[nodiscard]] drotor inverse() const noexcept
+    {
+        drotor out = *this;
+        out.invert();
+        return out;
+    }
+
+    /// Constrains the rotor to traverse the shortest arc
+    void constrain() noexcept
+    {
+        detail::f64x4 mask = KLN_SWIZZLE_PD(
+            detail::and_pd(p1_, detail::set_sd(-0.0)), 0, 0, 0, 0);
+        p1_ = detail::xor_pd(mask, p1_);
+    }
+
+    [[nodiscard]] drotor constrained() const noexcept
+    {
+        drotor out = *this;
+        out.constrain();
+        return out;
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL operator==(drotor other) const noexcept
+    {
+        return detail::all_eq_pd(p1_, other.p1_);
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL approx_eq(drotor other,
+                                              double epsilon) const noexcept
+    {
+        return detail::all_near_pd(p1_, other.p1_, epsilon);
+    }
+
+    /// Converts the rotor to a 3x4 column-major matrix. The results of this
+    /// conversion are only defined if the rotor is normalized.
+    [[nodiscard]] dmat3x4 as_mat3x4() const noexcept
+    {
+        dmat3x4 out;
+        mat4x4_12<false, true>(p1_, nullptr, out.cols);
+        return out;
+    }
+
+    /// Converts the rotor to a 4x4 column-major matrix.
+    [[nodiscard]] dmat4x4 as_mat4x4() const noexcept
+    {
+        dmat4x4 out;
+        mat4x4_12<false, false>(p1_, nullptr, out.cols);
+        return out;
+    }
+
+    /// Conjugates a plane $p$ with this rotor and returns the result
+    /// $rp\widetilde{r}$.
+    [[nodiscard]] dplane KLN_VEC_CALL operator()(dplane const& p) const noexcept
+    {
+        dplane out;
+        detail::sw012<false, false>(&p.p0_, p1_, nullptr, &out.p0_);
+        return out;
+    }
+
+    /// Conjugates an array of planes with this rotor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(dplane* in,
+                                 dplane* out,
+                                 size_t count) const noexcept
+    {
+        detail::sw012<true, false>(&in->p0_, p1_, nullptr, &out->p0_, count);
+    }
+
+    /// Conjugates a line $\ell$ with this rotor and returns the result
+    /// $r\ell \widetilde{r}$.
+    [[nodiscard]] dline KLN_VEC_CALL operator()(dline const& l) const noexcept
+    {
+        dline out;
+        detail::swMM<false, false, true>(&l.p1_, p1_, nullptr, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates an array of lines with this rotor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(dline* in,
+                                 dline* out,
+                                 size_t count) const noexcept
+    {
+        detail::swMM<true, false, true>(
+            &in->p1_, p1_, nullptr, &out->p1_, count);
+    }
+
+    /// Conjugates a point $p$ with this rotor and returns the result
+    /// $rp\widetilde{r}$.
+    [[nodiscard]] dpoint KLN_VEC_CALL operator()(dpoint const& p) const noexcept
+    {
+        // NOTE: Conjugation of a plane and point with a rotor is identical
+        dpoint out;
+        detail::sw012<false, false>(&p.p3_, p1_, nullptr, &out.p3_);
+        return out;
+    }
+
+    /// Conjugates an array of points with this rotor. Aliasing is only
+    /// permitted when `in == out`.
+    void KLN_VEC_CALL operator()(dpoint* in,
+                                 dpoint* out,
+                                 size_t count) const noexcept
+    {
+        detail::sw012<true, false>(&in->p3_, p1_, nullptr, &out->p3_, count);
+    }
+
+    /// Rotor addition
+    drotor& KLN_VEC_CALL operator+=(drotor b) noexcept
+    {
+        p1_ = detail::add_pd(p1_, b.p1_);
+        return *this;
+    }
+
+    /// Rotor subtraction
+    drotor& KLN_VEC_CALL operator-=(drotor b) noexcept
+    {
+        p1_ = detail::sub_pd(p1_, b.p1_);
+        return *this;
+    }
+
+    /// Rotor uniform scale
+    drotor& operator*=(double s) noexcept
+    {
+        p1_ = detail::mul_pd(p1_, detail::set1_pd(s));
+        return *this;
+    }
+
+    /// Rotor uniform inverse scale
+    drotor& operator/=(double s) noexcept
+    {
+        p1_ = detail::div_pd(p1_, detail::set1_pd(s));
+        return *this;
+    }
+
+    [[nodiscard]] double scalar() const noexcept
+    {
+        return detail::first_pd(p1_);
+    }
+
+    [[nodiscard]] double e12() const noexcept
+    {
+        double out[4];
+        store(out);
+        return out[3];
+    }
+
+    [[nodiscard]] double e21() const noexcept
+    {
+        return -e12();
+    }
+
+    [[nodiscard]] double e31() const noexcept
+    {
+        double out[4];
+        store(out);
+        return out[2];
+    }
+
+    [[nodiscard]] double e13() const noexcept
+    {
+        return -e31();
+    }
+
+    [[nodiscard]] double e23() const noexcept
+    {
+        double out[4];
+        store(out);
+        return out[1];
+    }
+
+    [[nodiscard]] double e32() const noexcept
+    {
+        return -e23();
+    }
+
+    detail::f64x4 p1_;
+};
+
+/// Rotor addition
+[[nodiscard]] inline drotor KLN_VEC_CALL operator+(drotor a, drotor b) noexcept
+{
+    return a += b;
+}
+
+/// Rotor subtraction
+[[nodiscard]] inline drotor KLN_VEC_CALL operator-(drotor a, drotor b) noexcept
+{
+    return a -= b;
+}
+
+/// Rotor uniform scale
+[[nodiscard]] inline drotor KLN_VEC_CALL operator*(drotor r, double s) noexcept
+{
+    return r *= s;
+}
+
+/// Rotor uniform scale
+[[nodiscard]] inline drotor KLN_VEC_CALL operator*(double s, drotor r) noexcept
+{
+    return r *= s;
+}
+
+/// Rotor uniform inverse scale
+[[nodiscard]] inline drotor KLN_VEC_CALL operator/(drotor r, double s) noexcept
+{
+    return r /= s;
+}
+
+/// Reversion operator
+[[nodiscard]] inline drotor KLN_VEC_CALL operator~(drotor r) noexcept
+{
+    return {detail::xor_pd(r.p1_, detail::set_pd(-0.0, -0.0, -0.0, 0.0))};
+}
+
+/// Unary minus
+[[nodiscard]] inline drotor KLN_VEC_CALL operator-(drotor r) noexcept
+{
+    return {detail::xor_pd(r.p1_, detail::set1_pd(-0.0))};
+}
+/// @}
+} // namespace kln
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "detail/double.hpp"
+#include "dline.hpp"
+#include "dplane.hpp"
+#include "dpoint.hpp"
+#include "translator.hpp"
+
+#include <cmath>
+
+namespace kln
+{
+/// \addtogroup double
+/// @{
+
+/// Double-precision counterpart of `kln::translator`, representing
+/// $1 + a\mathbf{e}_{01} + b\mathbf{e}_{02} + c\mathbf{e}_{03}$.
+class dtranslator final
+{
+public:
+    dtranslator() noexcept = default;
+
+    /// Displacement of `delta` units along the axis $(x, y, z)$
+    dtranslator(double delta, double x, double y, double z) noexcept
+    {
+        double scale = -0.5 * delta / std::sqrt(x * x + y * y + z * z);
+        p2_ = detail::set_pd(z * scale, y * scale, x * scale, 0.0);
+    }
+
+    dtranslator(detail::f64x4 p2) noexcept
+        : p2_{p2}
+    {}
+
+    /// Widen a single-precision translator
+    explicit dtranslator(translator t) noexcept
+        : p2_{detail::cvtps_pd(t.p2_)}
+    {}
+
+    /// Round to a single-precision translator
+    [[nodiscard]] translator as_float() const noexcept
+    {
+        translator out;
+        out.p2_ = detail::cvtpd_ps(p2_);
+        return out;
+    }
+
+    /// Fast load operation for packed data that is already normalized, with
+    /// the same layout `(0, a, b, c)` as `kln::translator::load_normalized`.
+    void load_normalized(double const* data) noexcept
+    {
+        p2_ = detail::loadu_pd(data);
+    }
+
+    void invert() noexcept
+    {
+        p2_ = detail::xor_pd(detail::set_pd(-0.0, -0.0, -0.0, 0.0), p2_);
+    }
+
+    [[nodiscard]] dtranslator inverse() const noexcept
+    {
+        dtranslator out = *this;
+        out.invert();
+        return out;
+    }
+
+    [[nodiscard]] bool KLN_VEC_CALL approx_eq(dtranslator other,
+                                              double epsilon) const noexcept
+    {
+        return detail::all_near_pd(p2_, other.p2_, epsilon);
+    }
+
+    /// Conjugates a plane $p$ with this translator and returns the result
+    /// $tp\widetilde{t}$.
+    [[nodiscard]] dplane KLN_VEC_CALL operator()(dplane const& p) const noexcept
+    {
+        detail::f64x4 tmp = detail::blend_pd<1>(p2_, detail::set_sd(1.0));
+        return {detail::sw02(p.p0_, tmp)};
+    }
+
+    /// Conjugates a line $\ell$ with this translator and returns the result
+    /// $t\ell\widetilde{t}$.
+    [[nodiscard]] dline KLN_VEC_CALL operator()(dline const& l) const noexcept
+    {
+        dline out;
+        detail::swL2(l.p1_, l.p2_, p2_, &out.p1_);
+        return out;
+    }
+
+    /// Conjugates a point $p$ with this translator and returns the result
+    /// $tp\widetilde{t}$.
+    [[nodiscard]] dpoint KLN_VEC_CALL operator()(dpoint const& p) const noexcept
+    {
+        return {detail::sw32(p.p3_, p2_)};
+    }
+
+    /// Translator addition
+    dtranslator& KLN_VEC_CALL operator+=(dtranslator b) noexcept
+    {
+        p2_ = detail::add_pd(p2_, b.p2_);
+        return *this;
+    }
+
+    /// Translator subtraction
+    dtranslator& KLN_VEC_CALL operator-=(dtranslator b) noexcept
+    {
+        p2_ = detail::sub_pd(p2_, b.p2_);
+        return *this;
+    }
+
+    /// Translator uniform scale
+    dtranslator& operator*=(double s) noexcept
+    {
+        p2_ = detail::mul_pd(p2_, detail::set1_pd(s));
+        return *this;
+    }
+
+    /// Translator uniform inverse scale
+    dtranslator& operator/=(double s) noexcept
+    {
+        p2_ = detail::div_pd(p2_, detail::set1_pd(s));
+        return *this;
+    }
+
+    constexpr double scalar() const noexcept
+    {
+        return 1.0;
+    }
+
+    [[nodiscard]] double e01() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p2_);
+        return out[1];
+    }
+
+    [[nodiscard]] double e10() const noexcept
+    {
+        return -e01();
+    }
+
+    [[nodiscard]] double e02() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p2_);
+        return out[2];
+    }
+
+    [[nodiscard]] double e20() const noexcept
+    {
+        return -e02();
+    }
+
+    [[nodiscard]] double e03() const noexcept
+    {
+        double out[4];
+        detail::storeu_pd(out, p2_);
+        return out[3];
+    }
+
+    [[nodiscard]] double e30() const noexcept
+    {
+        return -e03();
+    }
+
+    detail::f64x4 p2_;
+};
+
+/// Translator addition
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator+(dtranslator a,
+                                                        dtranslator b) noexcept
+{
+    return a += b;
+}
+
+/// Translator subtraction
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator-(dtranslator a,
+                                                        dtranslator b) noexcept
+{
+    return a -= b;
+}
+
+/// Translator uniform scale
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator*(dtranslator t,
+                                                        double s) noexcept
+{
+    return t *= s;
+}
+
+/// Translator uniform scale
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator*(double s,
+                                                        dtranslator t) noexcept
+{
+    return t *= s;
+}
+
+/// Translator uniform inverse scale
+[[nodiscard]] inline dtranslator KLN_VEC_CALL operator/(dtranslator t,
+                                                        double s) noexcept
+{
+    return t /= s;
+}
+/// @}
+} // namespace kln
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "bundle.hpp"
 #include "line.hpp"
 #include "motor.hpp"
 #include "rotor.hpp"
@@ -54,6 +55,37 @@ namespace kln
     return out;
 }
 
+/// Take the logarithm of `count` motors, writing `count` lines to `out`.
+///
+/// Motors are processed eight at a time in SoA form (see `kln::log(motor_x8)`)
+/// so the transcendental evaluation is vectorized. The polynomial `sincos`
+/// and `atan2` approximations used have a max absolute error below $3 \times
+/// 10^{-7}$ radians, so results may differ from the single-motor `log` in the
+/// last bit or two.
+inline void log(motor const* in, line* out, size_t count) noexcept
+{
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        motor_x8 m;
+        m.load(in + i, n);
+        log(m).store(out + i, n);
+    }
+}
+
+/// Exponentiate `count` lines, writing `count` motors to `out`. See
+/// `log(motor const*, line*, size_t)` for details on precision.
+inline void exp(line const* in, motor* out, size_t count) noexcept
+{
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        line_x8 l;
+        l.load(in + i, n);
+        exp(l).store(out + i, n);
+    }
+}
+
 /// Compute the logarithm of the translator, producing an ideal line axis.
 /// In practice, the logarithm of a translator is simply the ideal partition
 /// (without the scalar $1$).
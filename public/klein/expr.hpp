@@ -0,0 +1,314 @@
+#pragma once
+
+#include "detail/projection.hpp"
+#include "geometric_product.hpp"
+#include "join.hpp"
+#include "meet.hpp"
+#include "projection.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace kln
+{
+/// \defgroup expr Lazy Expressions
+///
+/// With the regular operators, an expression like `(m3 * m2 * m1)(p)` or
+/// `project(p, a ^ b)` builds every intermediate motor, line, and plane in
+/// full and runs a separate kernel for each step. If the first operand is
+/// wrapped with `kln::lazy`, the operators instead record the expression as a
+/// tree whose shape is known at compile time. Nothing is computed until the
+/// expression is applied to an entity, passed to `project`, or converted to
+/// its result type, and the kernel is then picked for the tree as a whole.
+///
+/// - A product of rotors, translators, and motors that is applied to a point
+///   or direction conjugates by each factor in turn instead of composing the
+///   factors first. A point sandwich costs less than a motor product, and
+///   the rotor and translator sandwiches skip the components those factors
+///   don't have. Planes and lines are treated the same way when one side of
+///   the product is a rotor or translator. Two motors are still composed
+///   first, because for those entities that is the cheaper order.
+/// - `project(point, plane ^ plane)` runs one fused kernel. It never forms
+///   the line or the plane through the point.
+///
+/// Every other expression is evaluated with the regular operators.
+///
+/// ```cpp
+///     // Conjugates p by m1, then m2, then m3
+///     kln::point p2 = (kln::lazy(m3) * m2 * m1)(p);
+///
+///     // Foot of the perpendicular from p to the line where a and b meet
+///     kln::point q = kln::project(p, kln::lazy(a) ^ b);
+///
+///     // Conversion evaluates the product with the regular operators
+///     kln::motor m = kln::lazy(m3) * m2 * m1;
+/// ```
+///
+/// !!! tip
+///
+///     When many entities share one chain, pass arrays to the call
+///     operator. It composes the chain once and then runs the motor's
+///     array sandwich.
+
+/// \addtogroup expr
+/// @{
+namespace expr
+{
+    /// Common base of all expression nodes
+    struct node
+    {};
+
+    template <typename T>
+    struct is_expr : std::is_base_of<node, T>
+    {};
+
+    template <typename T>
+    struct is_motion : std::false_type
+    {};
+
+    template <>
+    struct is_motion<rotor> : std::true_type
+    {};
+
+    template <>
+    struct is_motion<translator> : std::true_type
+    {};
+
+    template <>
+    struct is_motion<motor> : std::true_type
+    {};
+
+    /// A leaf of the expression tree holding an entity by value
+    template <typename T>
+    class term final : public node
+    {
+    public:
+        using value_type = T;
+
+        explicit term(T const& v) noexcept
+            : value{v}
+        {}
+
+        [[nodiscard]] T const& eval() const noexcept
+        {
+            return value;
+        }
+
+        operator T() const noexcept
+        {
+            return value;
+        }
+
+        template <typename X>
+        [[nodiscard]] X operator()(X const& x) const noexcept
+        {
+            return value(x);
+        }
+
+        template <typename X>
+        void operator()(X* in, X* out, size_t count) const noexcept
+        {
+            value(in, out, count);
+        }
+
+        T value;
+    };
+
+    // Non-expression operands become leaves
+    template <typename T>
+    using wrap =
+        typename std::conditional<is_expr<T>::value, T, term<T>>::type;
+
+    template <typename L, typename R>
+    using enable_binary = typename std::
+        enable_if<is_expr<L>::value || is_expr<R>::value, int>::type;
+
+    // Whether applying lhs * rhs to an X should conjugate by rhs and then lhs
+    // instead of composing the two first. Only worthwhile for points and
+    // directions, or when one side isn't a full motor.
+    template <typename L, typename R, typename X>
+    struct nests
+        : std::integral_constant<
+              bool,
+              is_motion<typename L::value_type>::value
+                  && is_motion<typename R::value_type>::value
+                  && (std::is_same<X, point>::value
+                      || std::is_same<X, direction>::value
+                      || !std::is_same<typename L::value_type, motor>::value
+                      || !std::is_same<typename R::value_type, motor>::value)>
+    {};
+
+    /// Geometric product `lhs * rhs`
+    template <typename L, typename R>
+    class product final : public node
+    {
+    public:
+        using value_type = decltype(std::declval<L const&>().eval()
+                                    * std::declval<R const&>().eval());
+
+        product(L const& l, R const& r) noexcept
+            : lhs{l}
+            , rhs{r}
+        {}
+
+        [[nodiscard]] value_type eval() const noexcept
+        {
+            return lhs.eval() * rhs.eval();
+        }
+
+        operator value_type() const noexcept
+        {
+            return eval();
+        }
+
+        /// Conjugates `x` with the product
+        template <typename X>
+        [[nodiscard]] X operator()(X const& x) const noexcept
+        {
+            return apply(x, nests<L, R, X>{});
+        }
+
+        /// Conjugates an array with the product, which is composed once up
+        /// front. Aliasing is only permitted when `in == out`.
+        template <typename X>
+        void operator()(X* in, X* out, size_t count) const noexcept
+        {
+            eval()(in, out, count);
+        }
+
+        L lhs;
+        R rhs;
+
+    private:
+        template <typename X>
+        X apply(X const& x, std::true_type) const noexcept
+        {
+            return lhs(rhs(x));
+        }
+
+        template <typename X>
+        X apply(X const& x, std::false_type) const noexcept
+        {
+            return eval()(x);
+        }
+    };
+
+    /// Exterior product (meet) `lhs ^ rhs`
+    template <typename L, typename R>
+    class meet final : public node
+    {
+    public:
+        using value_type = decltype(std::declval<L const&>().eval()
+                                    ^ std::declval<R const&>().eval());
+
+        meet(L const& l, R const& r) noexcept
+            : lhs{l}
+            , rhs{r}
+        {}
+
+        [[nodiscard]] value_type eval() const noexcept
+        {
+            return lhs.eval() ^ rhs.eval();
+        }
+
+        operator value_type() const noexcept
+        {
+            return eval();
+        }
+
+        L lhs;
+        R rhs;
+    };
+
+    /// Regressive product (join) `lhs & rhs`
+    template <typename L, typename R>
+    class join final : public node
+    {
+    public:
+        using value_type = decltype(std::declval<L const&>().eval()
+                                    & std::declval<R const&>().eval());
+
+        join(L const& l, R const& r) noexcept
+            : lhs{l}
+            , rhs{r}
+        {}
+
+        [[nodiscard]] value_type eval() const noexcept
+        {
+            return lhs.eval() & rhs.eval();
+        }
+
+        operator value_type() const noexcept
+        {
+            return eval();
+        }
+
+        L lhs;
+        R rhs;
+    };
+
+    /// Evaluates an expression with the regular operators. Non-expression
+    /// arguments are returned as is.
+    template <typename T>
+    [[nodiscard]] auto eval(T const& t) noexcept -> decltype(t.eval())
+    {
+        return t.eval();
+    }
+
+    template <typename T>
+    [[nodiscard]] typename std::enable_if<!is_expr<T>::value, T const&>::type
+    eval(T const& t) noexcept
+    {
+        return t;
+    }
+
+    template <typename L, typename R, enable_binary<L, R> = 0>
+    [[nodiscard]] product<wrap<L>, wrap<R>> operator*(L const& l,
+                                                       R const& r) noexcept
+    {
+        return {wrap<L>(l), wrap<R>(r)};
+    }
+
+    template <typename L, typename R, enable_binary<L, R> = 0>
+    [[nodiscard]] meet<wrap<L>, wrap<R>> operator^(L const& l,
+                                                    R const& r) noexcept
+    {
+        return {wrap<L>(l), wrap<R>(r)};
+    }
+
+    template <typename L, typename R, enable_binary<L, R> = 0>
+    [[nodiscard]] join<wrap<L>, wrap<R>> operator&(L const& l,
+                                                    R const& r) noexcept
+    {
+        return {wrap<L>(l), wrap<R>(r)};
+    }
+} // namespace expr
+
+/// Begin a lazy expression with `value` as its first operand
+template <typename T>
+[[nodiscard]] expr::term<T> lazy(T const& value) noexcept
+{
+    return expr::term<T>{value};
+}
+
+/// Project a point onto the line where two planes meet with a single fused
+/// kernel
+[[nodiscard]] inline point KLN_VEC_CALL
+project(point a,
+        expr::meet<expr::term<plane>, expr::term<plane>> const& b) noexcept
+{
+    point out;
+    detail::projPTPP(a.p3_, b.lhs.value.p0_, b.rhs.value.p0_, out.p3_);
+    return out;
+}
+
+/// Projections involving any other expression evaluate the expression first
+template <typename A, typename B, expr::enable_binary<A, B> = 0>
+[[nodiscard]] auto project(A const& a, B const& b) noexcept
+    -> decltype(project(expr::eval(a), expr::eval(b)))
+{
+    return project(expr::eval(a), expr::eval(b));
+}
+/// @}
+} // namespace kln
@@ -226,6 +226,42 @@ namespace kln
     return out;
 }
 
+/// Compose `count` pairs of motors such that `out[i] = a[i] * b[i]`.
+///
+/// !!! tip
+///
+///     This is equivalent to a loop over `operator*` but amortizes the loop
+///     overhead and, with `KLEIN_AVX2`, composes two pairs of motors per
+///     iteration. Any of `a`, `b`, and `out` may alias.
+inline void KLN_VEC_CALL multiply(motor const* a,
+                                  motor const* b,
+                                  motor* out,
+                                  size_t count) noexcept
+{
+    detail::gpMM<false>(&a->p1_, &b->p1_, &out->p1_, count);
+}
+
+/// Compose a single motor with `count` motors such that `out[i] = a * b[i]`.
+/// The swizzles of `a` are computed once for the entire batch.
+inline void KLN_VEC_CALL multiply(motor const& a,
+                                  motor const* b,
+                                  motor* out,
+                                  size_t count) noexcept
+{
+    detail::gpMM<true>(&a.p1_, &b->p1_, &out->p1_, count);
+}
+
+/// Running product of `count` motors: `out[0] = in[0]` and
+/// `out[i] = out[i - 1] * in[i]`. This is the composition along a chain of
+/// transforms (e.g. a single limb of a skeleton) and is latency bound, since
+/// each product depends on the previous one. `in` and `out` may alias.
+inline void KLN_VEC_CALL prefix_product(motor const* in,
+                                        motor* out,
+                                        size_t count) noexcept
+{
+    detail::gpMM_prefix(&in->p1_, &out->p1_, count);
+}
+
 // Division operators
 
 [[nodiscard]] inline motor KLN_VEC_CALL operator/(plane a, plane b) noexcept
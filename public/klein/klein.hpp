@@ -3,13 +3,33 @@
 // 1. Representations of points, lines, planes, directions, rotors, translators,
 //    and motors as multivectors
 // 2. SSE-optimized operations between all the above
+// 3. Structure-of-arrays bundles of the above (point_x8, motor_x8, etc.) for
+//    processing eight entities in lock-step
+// 4. Interpolation and blending of rotors and motors
+// 5. Skeletal hierarchies with forward kinematics and skinning
+// 6. Double-precision counterparts (dpoint, dmotor, etc.) for large worlds
+// 7. Opt-in lazy expressions that fuse chains of products and projections
+// 8. Packed 12-byte motors and a memory-mappable animation clip format
+// 9. Convex volumes for batched frustum and convex hull culling
+// 10. Batched ray queries against planes and triangles
+// 11. Bounding volume hierarchies queried through instance motors
 
 #pragma once
 
+#include "blend.hpp"
+#include "bundle.hpp"
+#include "bvh.hpp"
+#include "clip.hpp"
+#include "convex_volume.hpp"
+#include "double.hpp"
 #include "exp_log.hpp"
+#include "expr.hpp"
 #include "geometric_product.hpp"
 #include "inner_product.hpp"
 #include "join.hpp"
 #include "meet.hpp"
+#include "packed.hpp"
 #include "projection.hpp"
+#include "ray.hpp"
+#include "skeleton.hpp"
 #include "util.hpp"
\ No newline at end of file
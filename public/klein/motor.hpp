@@ -600,5 +600,40 @@ public:
     __m128 flip = _mm_set_ps(-0.f, -0.f, -0.f, 0.f);
     return {_mm_xor_ps(m.p1_, flip), _mm_xor_ps(m.p2_, flip)};
 }
+
+/// Convert an array of motors to 3x4 column-major matrices. The result is the
+/// same as calling `motor::as_mat3x4` on each element, but four motors are
+/// converted at a time with the matrix entries computed in parallel across
+/// them. As with `motor::as_mat3x4`, the motors must be normalized.
+inline void to_mat3x4(motor const* in, mat3x4* out, size_t count) noexcept
+{
+    mat4x4_12<true, true, false>(&in->p1_, out->cols, count);
+}
+
+/// Convert an array of motors to 4x4 column-major matrices. See `to_mat3x4`.
+inline void to_mat4x4(motor const* in, mat4x4* out, size_t count) noexcept
+{
+    mat4x4_12<true, false, false>(&in->p1_, out->cols, count);
+}
+
+/// Equivalent to `to_mat3x4`, but `out` is written with non-temporal stores
+/// that bypass the cache, followed by a store fence.
+///
+/// !!! tip
+///
+///     Prefer this variant when `out` is write-combined memory such as a
+///     mapped GPU upload buffer, or any buffer that the CPU will not read
+///     back soon. Streaming thousands of matrices through the cache would
+///     otherwise evict data that is still needed.
+inline void stream_mat3x4(motor const* in, mat3x4* out, size_t count) noexcept
+{
+    mat4x4_12<true, true, true>(&in->p1_, out->cols, count);
+}
+
+/// Equivalent to `to_mat4x4`, with non-temporal stores. See `stream_mat3x4`.
+inline void stream_mat4x4(motor const* in, mat4x4* out, size_t count) noexcept
+{
+    mat4x4_12<true, false, true>(&in->p1_, out->cols, count);
+}
 } // namespace kln
   /// @}
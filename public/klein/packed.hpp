@@ -0,0 +1,307 @@
+#pragma once
+
+#include "blend.hpp"
+#include "detail/geometric_product.hpp"
+#include "detail/sse.hpp"
+#include "motor.hpp"
+#include "rotor.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace kln
+{
+/// \defgroup packed Packed Motors
+///
+/// A `kln::motor` occupies 32 bytes, which is more bandwidth than an
+/// animation clip storing a motor per joint per key can afford. A
+/// `kln::packed_motor` stores a normalized motor in 12 bytes:
+///
+/// - The rotor is stored with "smallest three" compression. The component
+///   with the largest magnitude is dropped (after flipping the sign of the
+///   rotor so that it is positive) and recovered on decode from the unit
+///   norm. The remaining three components lie in
+///   $[-1/\sqrt{2}, 1/\sqrt{2}]$ and are quantized to 15 bits each. The
+///   index of the dropped component occupies the two spare bits.
+/// - The translation is quantized to 16 bits per coordinate relative to a
+///   `kln::packed_range`, usually fit once to all the motors of a clip.
+///
+/// The rotational error is below $10^{-4}$ radians, and the translational
+/// error is half a quantization step, or about $2^{-17}$ times the extent of
+/// the range along each axis.
+///
+/// ```cpp
+///     // Offline: compress every key of a clip against a shared range
+///     kln::packed_range range{keys, key_count * joint_count};
+///     kln::pack(range, keys, packed, key_count * joint_count);
+///
+///     // Per frame: decode and interpolate two keys directly into a pose
+///     kln::unpack_nlerp(range,
+///                       packed + key * joint_count,
+///                       packed + (key + 1) * joint_count,
+///                       t,
+///                       pose.local(),
+///                       joint_count);
+/// ```
+///
+/// Decoding is branch free and is intended to run directly in the sampling
+/// loop. Packing presumes normalized motors. The sign of a decoded motor may
+/// differ from the motor that was packed, which encodes the same transform.
+
+/// \addtogroup packed
+/// @{
+
+/// A normalized motor compressed to 12 bytes. See the \ref packed group for
+/// the encoding.
+struct packed_motor
+{
+    /// Quantized rotor components with the index of the dropped component in
+    /// the most significant bit of the first two entries
+    uint16_t rotor[3];
+
+    /// Quantized translation relative to a `kln::packed_range`
+    uint16_t translation[3];
+};
+
+static_assert(sizeof(packed_motor) == 12, "packed_motor must be 12 bytes");
+
+namespace detail
+{
+    // Translator part of a normalized motor (the motor with its rotation
+    // factored out), as (0, e01, e02, e03)
+    KLN_INLINE __m128 KLN_VEC_CALL translator_part(motor m) noexcept
+    {
+        rotor r;
+        r.p1_ = m.p1_;
+        return (m * ~r).p2_;
+    }
+} // namespace detail
+
+/// The range of translations representable by a set of packed motors. The
+/// translation of every motor packed with a range is clamped to it.
+class packed_range final
+{
+public:
+    /// Represents the zero translation only
+    packed_range() noexcept
+    {
+        init(_mm_setzero_ps(), _mm_setzero_ps());
+    }
+
+    /// Translations with each coordinate between the corresponding
+    /// coordinates of `min` and `max`
+    packed_range(float min_x,
+                 float min_y,
+                 float min_z,
+                 float max_x,
+                 float max_y,
+                 float max_z) noexcept
+    {
+        init(_mm_set_ps(min_z, min_y, min_x, 0.f),
+             _mm_set_ps(max_z, max_y, max_x, 0.f));
+    }
+
+    /// The smallest range containing the translations of `count` normalized
+    /// motors
+    packed_range(motor const* motors, size_t count) noexcept
+    {
+        if (count == 0)
+        {
+            init(_mm_setzero_ps(), _mm_setzero_ps());
+            return;
+        }
+
+        // A translator stores half the negated displacement
+        __m128 to_displacement = _mm_set_ps(-2.f, -2.f, -2.f, 0.f);
+        __m128 lo              = _mm_mul_ps(
+            detail::translator_part(motors[0]), to_displacement);
+        __m128 hi = lo;
+        for (size_t i = 1; i != count; ++i)
+        {
+            __m128 t = _mm_mul_ps(
+                detail::translator_part(motors[i]), to_displacement);
+            lo = _mm_min_ps(lo, t);
+            hi = _mm_max_ps(hi, t);
+        }
+        init(lo, hi);
+    }
+
+    /// Decoded translator is origin_ + q * scale_ for the quantized
+    /// translation q in lanes 1 to 3. Lane 0 of each is zero.
+    __m128 origin_;
+    __m128 scale_;
+    /// Reciprocal of scale_, or zero where the range is empty
+    __m128 inv_scale_;
+
+private:
+    void KLN_VEC_CALL init(__m128 lo, __m128 hi) noexcept
+    {
+        // Translators hold -t / 2, so the translation at the lower bound
+        // maps to the quantized value 0 and the upper bound maps to 65535
+        __m128 half = _mm_set_ps(-0.5f, -0.5f, -0.5f, 0.f);
+        origin_     = _mm_mul_ps(lo, half);
+        scale_      = _mm_mul_ps(_mm_sub_ps(hi, lo),
+                            _mm_mul_ps(half, _mm_set1_ps(1.f / 65535.f)));
+        inv_scale_  = _mm_and_ps(_mm_cmpneq_ps(scale_, _mm_setzero_ps()),
+                                _mm_div_ps(_mm_set1_ps(1.f), scale_));
+    }
+};
+
+namespace detail
+{
+    // Per-lane mask ? a : b
+    KLN_INLINE __m128 KLN_VEC_CALL select(__m128 mask,
+                                          __m128 a,
+                                          __m128 b) noexcept
+    {
+#ifdef KLEIN_SSE_4_1
+        return _mm_blendv_ps(b, a, mask);
+#else
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+#endif
+    }
+
+    // Quantization step of the three stored rotor components
+    constexpr float packed_rotor_step = 1.41421356237f / 32767.f;
+    constexpr float packed_rotor_min  = -0.70710678118f;
+
+    KLN_INLINE void KLN_VEC_CALL pack(motor m,
+                                      packed_range const& range,
+                                      packed_motor& out) noexcept
+    {
+        float c[4];
+        _mm_storeu_ps(c, m.p1_);
+        int k    = 0;
+        float ak = std::abs(c[0]);
+        for (int i = 1; i != 4; ++i)
+        {
+            if (std::abs(c[i]) > ak)
+            {
+                k  = i;
+                ak = std::abs(c[i]);
+            }
+        }
+
+        // Flip the rotor so the dropped component is positive, then shift the
+        // components above it down a lane
+        __m128 v  = _mm_xor_ps(m.p1_, _mm_set1_ps(c[k] < 0.f ? -0.f : 0.f));
+        __m128 lt = _mm_castsi128_ps(
+            _mm_cmplt_epi32(_mm_set_epi32(3, 2, 1, 0), _mm_set1_epi32(k)));
+        v         = select(lt, v, KLN_SWIZZLE(v, 0, 3, 2, 1));
+
+        __m128 r = _mm_mul_ps(_mm_sub_ps(v, _mm_set1_ps(packed_rotor_min)),
+                              _mm_set1_ps(1.f / packed_rotor_step));
+        r = _mm_min_ps(_mm_max_ps(r, _mm_setzero_ps()), _mm_set1_ps(32767.f));
+
+        __m128 t = _mm_mul_ps(_mm_sub_ps(translator_part(m), range.origin_),
+                              range.inv_scale_);
+        t = _mm_min_ps(_mm_max_ps(t, _mm_setzero_ps()), _mm_set1_ps(65535.f));
+
+        alignas(16) int32_t qr[4];
+        alignas(16) int32_t qt[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(qr), _mm_cvtps_epi32(r));
+        _mm_store_si128(reinterpret_cast<__m128i*>(qt), _mm_cvtps_epi32(t));
+
+        out.rotor[0]       = static_cast<uint16_t>(qr[0] | (k & 1) << 15);
+        out.rotor[1]       = static_cast<uint16_t>(qr[1] | (k >> 1) << 15);
+        out.rotor[2]       = static_cast<uint16_t>(qr[2]);
+        out.translation[0] = static_cast<uint16_t>(qt[1]);
+        out.translation[1] = static_cast<uint16_t>(qt[2]);
+        out.translation[2] = static_cast<uint16_t>(qt[3]);
+    }
+
+    KLN_INLINE void KLN_VEC_CALL unpack(packed_motor const& in,
+                                        packed_range const& range,
+                                        motor& out) noexcept
+    {
+        // Load (r0, r1, r2, t0, t1, t2) without reading past the element
+        int32_t tail;
+        std::memcpy(&tail, in.translation + 1, sizeof(tail));
+        __m128i raw = _mm_unpacklo_epi64(
+            _mm_loadl_epi64(reinterpret_cast<__m128i const*>(&in)),
+            _mm_cvtsi32_si128(tail));
+
+        // The index of the dropped component is in the sign bits of r0 and r1
+        int bits = _mm_movemask_epi8(raw);
+        int k    = ((bits >> 1) & 1) | ((bits >> 2) & 2);
+
+        __m128i mask
+            = _mm_set_epi16(-1, -1, -1, -1, -1, 0x7fff, 0x7fff, 0x7fff);
+        raw          = _mm_and_si128(raw, mask);
+        __m128i zero = _mm_setzero_si128();
+        __m128 lo    = _mm_cvtepi32_ps(_mm_unpacklo_epi16(raw, zero));
+        __m128 hi    = _mm_cvtepi32_ps(_mm_unpackhi_epi16(raw, zero));
+
+        // (a, b, c, 0) and the recovered component w in every lane
+        float const s = packed_rotor_step;
+        float const o = packed_rotor_min;
+        __m128 v      = _mm_add_ps(_mm_mul_ps(lo, _mm_set_ps(0.f, s, s, s)),
+                              _mm_set_ps(0.f, o, o, o));
+        __m128 sq = _mm_mul_ps(v, v);
+        sq        = _mm_add_ps(sq, KLN_SWIZZLE(sq, 1, 0, 3, 2));
+        sq        = _mm_add_ps(sq, KLN_SWIZZLE(sq, 2, 3, 0, 1));
+        __m128 w  = _mm_sqrt_ps(
+            _mm_max_ps(_mm_sub_ps(_mm_set1_ps(1.f), sq), _mm_setzero_ps()));
+
+        // Lanes below k are in place, lane k is w, and lanes above k shift up
+        __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+        __m128i kk    = _mm_set1_epi32(k);
+        __m128 gt     = _mm_castsi128_ps(_mm_cmpgt_epi32(lanes, kk));
+        __m128 eq     = _mm_castsi128_ps(_mm_cmpeq_epi32(lanes, kk));
+        out.p1_ = select(eq, w, select(gt, KLN_SWIZZLE(v, 2, 1, 0, 3), v));
+
+        // (0, t0, t1, t2) scaled into a translator, composed with the rotor
+        __m128 t = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(1, 0, 3, 3));
+        t        = _mm_add_ps(_mm_mul_ps(t, range.scale_), range.origin_);
+        gpRT<true>(out.p1_, t, out.p2_);
+    }
+} // namespace detail
+
+/// Compress `count` normalized motors. Translations outside of `range` are
+/// clamped to it.
+inline void pack(packed_range const& range,
+                 motor const* in,
+                 packed_motor* out,
+                 size_t count) noexcept
+{
+    for (size_t i = 0; i != count; ++i)
+    {
+        detail::pack(in[i], range, out[i]);
+    }
+}
+
+/// Decompress `count` motors that were packed with `range`
+inline void unpack(packed_range const& range,
+                   packed_motor const* in,
+                   motor* out,
+                   size_t count) noexcept
+{
+    for (size_t i = 0; i != count; ++i)
+    {
+        detail::unpack(in[i], range, out[i]);
+    }
+}
+
+/// Decompress two arrays of `count` motors packed with `range` (typically
+/// consecutive keys of a clip) and write `out[i] = nlerp(a[i], b[i], t)`.
+/// Only the packed keys are read.
+inline void unpack_nlerp(packed_range const& range,
+                         packed_motor const* a,
+                         packed_motor const* b,
+                         float t,
+                         motor* out,
+                         size_t count) noexcept
+{
+    for (size_t i = 0; i != count; ++i)
+    {
+        motor ma;
+        motor mb;
+        detail::unpack(a[i], range, ma);
+        detail::unpack(b[i], range, mb);
+        out[i] = nlerp(ma, mb, t);
+    }
+}
+/// @}
+} // namespace kln
@@ -56,7 +56,8 @@ public:
         p0_ = _mm_loadu_ps(data);
     }
 
-    /// Normalize this plane $p$ such that $p \cdot p = 1$.
+    /// Normalize this plane $p$ such that $p \cdot p = 1$. All four
+    /// components are scaled so the plane itself is unchanged.
     ///
     /// In order to compute the cosine of the angle between planes via the
     /// inner product operator `|`, the planes must be normalized. Producing a
@@ -65,12 +66,7 @@ public:
     void normalize() noexcept
     {
         __m128 inv_norm = detail::rsqrt_nr1(detail::hi_dp_bc(p0_, p0_));
-#ifdef KLEIN_SSE_4_1
-        inv_norm = _mm_blend_ps(inv_norm, _mm_set_ss(1.f), 1);
-#else
-        inv_norm = _mm_add_ps(inv_norm, _mm_set_ss(1.f));
-#endif
-        p0_ = _mm_mul_ps(inv_norm, p0_);
+        p0_             = _mm_mul_ps(inv_norm, p0_);
     }
 
     /// Return a normalized copy of this plane.
@@ -0,0 +1,281 @@
+#pragma once
+
+#include "bundle.hpp"
+#include "float_x8.hpp"
+#include "join.hpp"
+#include "line.hpp"
+#include "plane.hpp"
+#include "point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+namespace kln
+{
+/// \defgroup ray Ray Queries
+///
+/// Batched intersection of rays, given as `kln::line`s, with planes and
+/// triangles. Eight rays are processed at a time in a `line_x8`, so a
+/// query against a single plane or triangle (or a list of triangles, each
+/// broadcast to all lanes) is straight-line SIMD across rays.
+///
+/// The hit of a ray $\ell$ with a plane $p$ is the meet $p\wedge\ell$. For
+/// a triangle $ABC$, the ray passes through the interior when the vertices
+/// lie on the same side of each of the planes $A\vee\ell$, $B\vee\ell$ and
+/// $C\vee\ell$ in turn. Concretely, the signs of $(A\vee\ell)\wedge B$,
+/// $(B\vee\ell)\wedge C$ and $(C\vee\ell)\wedge A$ agree. None of these
+/// intermediates need to be normalized. Only the hit points themselves are
+/// divided through, and only if they are requested.
+///
+/// The direction of a line $\ell$ is its $(\mathbf{e}_{23},
+/// \mathbf{e}_{31}, \mathbf{e}_{12})$ part $\mathbf{d}$, which for
+/// $\ell = P\vee Q$ points from $P$ to $Q$. The parameter of a hit $H$ is the
+/// $t$ for which $H = O + t\mathbf{d}$, measured from an origin $O$ on the
+/// line. If the query is given an array of (normalized) origins, hits with
+/// $t < 0$ are rejected, making the lines proper rays. Otherwise, $O$ is the
+/// point of the line nearest to the world origin and the parameter is only
+/// used to order hits. For a normalized line, $t$ is a distance.
+///
+/// ```cpp
+///     // Pick against a mesh from the camera
+///     kln::line rays[64];      // eye & (point on the near plane)
+///     kln::point origins[64];  // The eye, repeated
+///     float t[64];
+///     uint32_t index[64];
+///     kln::ray_hits hits{nullptr, t, nullptr};
+///     kln::intersect_closest(
+///         rays, origins, vertices, triangle_count, hits, index, 64);
+/// ```
+
+/// \addtogroup ray
+/// @{
+
+/// Output arrays of a batched ray query, each with an entry per ray. Any
+/// member may be null, in which case it is not written.
+struct ray_hits
+{
+    /// Bit `i % 32` of `mask[i / 32]` is set if the `i`-th ray hits. This
+    /// array needs `(count + 31) / 32` words.
+    uint32_t* mask;
+
+    /// Parameter of each hit along its ray, or infinity for a miss
+    float* t;
+
+    /// Normalized hit points. Entries of rays that miss are unspecified.
+    point* points;
+};
+
+namespace detail
+{
+    // Load a block of rays, along with the parameter of each origin
+    // relative to the point of the line nearest the world origin (whose
+    // parameter is zero, as it is perpendicular to the direction)
+    KLN_INLINE void load_rays(line const* rays,
+                              point const* origins,
+                              size_t n,
+                              line_x8& l,
+                              float_x8& t0) noexcept
+    {
+        l.load(rays, n);
+        if (origins)
+        {
+            point_x8 o;
+            o.load(origins, n);
+            t0 = o.e032 * l.e23 + o.e013 * l.e31 + o.e021 * l.e12;
+        }
+        else
+        {
+            t0 = float_x8{0.f};
+        }
+    }
+
+    // Parameters of the homogeneous points h on the lines l, as
+    // (h.d / w - t0) / (d.d) with a single reciprocal. Lanes where h is
+    // ideal (a line parallel to the plane) or behind the origin are set in
+    // the returned miss mask.
+    KLN_INLINE float_x8 ray_param(point_x8 const& h,
+                                  line_x8 const& l,
+                                  float_x8 t0,
+                                  bool clip,
+                                  float_x8& t) noexcept
+    {
+        float_x8 hd = h.e032 * l.e23 + h.e013 * l.e31 + h.e021 * l.e12;
+        float_x8 dd = l.e23 * l.e23 + l.e31 * l.e31 + l.e12 * l.e12;
+        t           = (hd - h.e123 * t0) * rcp_nr1(h.e123 * dd);
+        float_x8 miss = cmpeq(h.e123, float_x8{0.f});
+        if (clip)
+        {
+            miss = or_x8(miss, cmplt(t, float_x8{0.f}));
+        }
+        return miss;
+    }
+
+    // Side of the point b relative to the plane p in each lane, as the
+    // e0123 coefficient of p ^ b
+    KLN_INLINE float_x8 side(plane_x8 const& p, point b) noexcept
+    {
+        return p.e1 * b.x() + p.e2 * b.y() + p.e3 * b.z() + p.e0 * b.w();
+    }
+
+    // Lanes where the lines l miss the triangle abc, from the signs of the
+    // planes through each vertex and line evaluated at the next vertex
+    KLN_INLINE float_x8 triangle_miss(line_x8 const& l,
+                                      point a,
+                                      point b,
+                                      point c) noexcept
+    {
+        float_x8 sa = side(point_x8{a} & l, b);
+        float_x8 sb = side(point_x8{b} & l, c);
+        float_x8 sc = side(point_x8{c} & l, a);
+        float_x8 zero{0.f};
+        float_x8 neg = or_x8(or_x8(cmplt(sa, zero), cmplt(sb, zero)),
+                             cmplt(sc, zero));
+        float_x8 pos = or_x8(or_x8(cmplt(zero, sa), cmplt(zero, sb)),
+                             cmplt(zero, sc));
+        return and_x8(neg, pos);
+    }
+
+    KLN_INLINE void store_hits(ray_hits const& out,
+                               size_t i,
+                               size_t n,
+                               float_x8 miss,
+                               float_x8 t,
+                               point_x8& h) noexcept
+    {
+        if (out.mask)
+        {
+            store_mask(~movemask(miss), out.mask, i, n);
+        }
+        if (out.t)
+        {
+            float tt[8];
+            select(miss, float_x8{std::numeric_limits<float>::infinity()}, t)
+                .store(tt);
+            std::memcpy(out.t + i, tt, n * sizeof(float));
+        }
+        if (out.points)
+        {
+            h.normalize();
+            h.store(out.points + i, n);
+        }
+    }
+} // namespace detail
+
+/// Intersect `count` rays with the plane `p`. `origins` may be null. See
+/// the \ref ray group for the meaning of the origins and parameters.
+inline void intersect(line const* rays,
+                      point const* origins,
+                      plane p,
+                      ray_hits const& out,
+                      size_t count) noexcept
+{
+    plane_x8 px{p};
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        line_x8 l;
+        float_x8 t0;
+        detail::load_rays(rays + i, origins ? origins + i : nullptr, n, l, t0);
+        point_x8 h = px ^ l;
+        float_x8 t;
+        float_x8 miss = detail::ray_param(h, l, t0, origins != nullptr, t);
+        detail::store_hits(out, i, n, miss, t, h);
+    }
+}
+
+/// Intersect `count` rays with the triangle `abc`. Rays through an edge or
+/// vertex hit, and rays in the plane of the triangle miss. `origins` may be
+/// null.
+inline void intersect(line const* rays,
+                      point const* origins,
+                      point a,
+                      point b,
+                      point c,
+                      ray_hits const& out,
+                      size_t count) noexcept
+{
+    plane_x8 px{a & b & c};
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        line_x8 l;
+        float_x8 t0;
+        detail::load_rays(rays + i, origins ? origins + i : nullptr, n, l, t0);
+        point_x8 h = px ^ l;
+        float_x8 t;
+        float_x8 miss = detail::or_x8(
+            detail::ray_param(h, l, t0, origins != nullptr, t),
+            detail::triangle_miss(l, a, b, c));
+        detail::store_hits(out, i, n, miss, t, h);
+    }
+}
+
+/// Find the closest hit of each of `count` rays among `triangle_count`
+/// triangles, where triangle `j` has vertices `triangles[3 * j]` to
+/// `triangles[3 * j + 2]`. `index[i]` receives the index of the triangle
+/// hit by the `i`-th ray, or `0xffffffff` for a miss. `origins` and `index`
+/// may be null.
+///
+/// Each block of eight rays stays in registers while the triangles are
+/// streamed past it, so large triangle lists are best split into chunks
+/// that fit in cache.
+inline void intersect_closest(line const* rays,
+                              point const* origins,
+                              point const* triangles,
+                              size_t triangle_count,
+                              ray_hits const& out,
+                              uint32_t* index,
+                              size_t count) noexcept
+{
+    float_x8 inf{std::numeric_limits<float>::infinity()};
+    for (size_t i = 0; i < count; i += 8)
+    {
+        size_t n = count - i < 8 ? count - i : 8;
+        line_x8 l;
+        float_x8 t0;
+        detail::load_rays(rays + i, origins ? origins + i : nullptr, n, l, t0);
+
+        // Triangle indices are carried in the bits of a float lane so they
+        // can be blended along with the parameters
+        float_x8 best_t = inf;
+        float_x8 best_j{_mm_castsi128_ps(_mm_set1_epi32(-1)),
+                        _mm_castsi128_ps(_mm_set1_epi32(-1))};
+        point_x8 best_h{0.f, 0.f, 0.f};
+        for (size_t j = 0; j != triangle_count; ++j)
+        {
+            point const* v = triangles + 3 * j;
+            point_x8 h     = plane_x8{v[0] & v[1] & v[2]} ^ l;
+            float_x8 t;
+            float_x8 miss = detail::or_x8(
+                detail::ray_param(h, l, t0, origins != nullptr, t),
+                detail::triangle_miss(l, v[0], v[1], v[2]));
+            float_x8 closer
+                = detail::cmplt(detail::select(miss, inf, t), best_t);
+            if (!detail::any(closer))
+            {
+                continue;
+            }
+            __m128 jj = _mm_castsi128_ps(
+                _mm_set1_epi32(static_cast<int32_t>(j)));
+            best_t      = detail::select(closer, t, best_t);
+            best_j      = detail::select(closer, float_x8{jj, jj}, best_j);
+            best_h.e123 = detail::select(closer, h.e123, best_h.e123);
+            best_h.e032 = detail::select(closer, h.e032, best_h.e032);
+            best_h.e013 = detail::select(closer, h.e013, best_h.e013);
+            best_h.e021 = detail::select(closer, h.e021, best_h.e021);
+        }
+
+        detail::store_hits(out, i, n, detail::cmpeq(best_t, inf), best_t,
+                           best_h);
+        if (index)
+        {
+            float jj[8];
+            best_j.store(jj);
+            std::memcpy(index + i, jj, n * sizeof(uint32_t));
+        }
+    }
+}
+/// @}
+} // namespace kln
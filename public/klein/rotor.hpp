@@ -511,5 +511,31 @@ public:
     return {_mm_xor_ps(r.p1_, _mm_set1_ps(-0.f))};
 }
 
+/// Convert an array of normalized rotors to 3x4 column-major matrices. See
+/// the motor overload of `to_mat3x4`.
+inline void to_mat3x4(rotor const* in, mat3x4* out, size_t count) noexcept
+{
+    mat4x4_12<false, true, false>(&in->p1_, out->cols, count);
+}
+
+/// Convert an array of rotors to 4x4 column-major matrices.
+inline void to_mat4x4(rotor const* in, mat4x4* out, size_t count) noexcept
+{
+    mat4x4_12<false, false, false>(&in->p1_, out->cols, count);
+}
+
+/// Equivalent to `to_mat3x4`, with non-temporal stores. See the motor
+/// overload of `stream_mat3x4`.
+inline void stream_mat3x4(rotor const* in, mat3x4* out, size_t count) noexcept
+{
+    mat4x4_12<false, true, true>(&in->p1_, out->cols, count);
+}
+
+/// Equivalent to `to_mat4x4`, with non-temporal stores.
+inline void stream_mat4x4(rotor const* in, mat4x4* out, size_t count) noexcept
+{
+    mat4x4_12<false, false, true>(&in->p1_, out->cols, count);
+}
+
 } // namespace kln
 /// @}
@@ -0,0 +1,339 @@
+#pragma once
+
+#include "detail/matrix.hpp"
+#include "detail/sandwich.hpp"
+#include "direction.hpp"
+#include "geometric_product.hpp"
+#include "mat3x4.hpp"
+#include "mat4x4.hpp"
+#include "motor.hpp"
+#include "point.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kln
+{
+/// \defgroup skeleton Skeletal Hierarchies
+///
+/// A `kln::skeleton` describes a joint hierarchy for forward kinematics. It
+/// stores, for each joint, the offset back to its parent joint and the
+/// motor taking model space to the joint's bind space (the inverse bind
+/// pose). Joints must be sorted so that every parent precedes its children.
+/// With that ordering, world motors can be computed from local motors in a
+/// single forward pass where each parent's world motor has already been
+/// written (and is typically still in cache) by the time its children read
+/// it.
+///
+/// A `kln::pose` binds a skeleton to per-instance arrays of local and world
+/// motors. Neither type owns memory. The joint data of a skeleton is shared
+/// by every pose referencing it, and the caller chooses where the per-instance
+/// arrays reside.
+///
+/// ```cpp
+///     // Root 0 with children 1 and 2, and joint 3 a child of joint 2
+///     uint16_t parent_offsets[4] = {0, 1, 2, 1};
+///     kln::motor inv_bind[4] = {...};
+///     kln::skeleton skel{parent_offsets, inv_bind, 4};
+///
+///     kln::motor local[4] = {...}; // Sampled from an animation clip
+///     kln::motor world[4];
+///     kln::pose p{skel, local, world};
+///     p.evaluate(character_root);
+///
+///     kln::mat3x4 skin[4];
+///     p.skinning(skin);
+/// ```
+///
+/// !!! tip
+///
+///     For many instances of the same skeleton, lay out the local and world
+///     motors of consecutive instances contiguously and use the array
+///     overloads of `kln::evaluate` and `kln::skinning`. Every pass then
+///     streams through memory sequentially.
+
+/// \addtogroup skeleton
+/// @{
+
+/// Non-owning view of a joint hierarchy sorted parent-before-child.
+class skeleton final
+{
+public:
+    skeleton() noexcept = default;
+
+    /// `parent_offsets[i]` is the distance from joint `i` back to its parent
+    /// (so the parent of joint `i` is `i - parent_offsets[i]`). Roots have an
+    /// offset of zero. `inv_bind_poses` may be `nullptr`, in which case the
+    /// bind pose is the identity for every joint.
+    skeleton(uint16_t const* parent_offsets,
+             motor const* inv_bind_poses,
+             size_t size) noexcept
+        : parent_offsets_{parent_offsets}
+        , inv_bind_poses_{inv_bind_poses}
+        , size_{size}
+    {}
+
+    /// Number of joints
+    [[nodiscard]] size_t size() const noexcept
+    {
+        return size_;
+    }
+
+    [[nodiscard]] uint16_t const* parent_offsets() const noexcept
+    {
+        return parent_offsets_;
+    }
+
+    [[nodiscard]] motor const* inv_bind_poses() const noexcept
+    {
+        return inv_bind_poses_;
+    }
+
+    /// Returns true if every parent offset refers to an earlier joint in the
+    /// skeleton. The evaluation routines do not check this.
+    [[nodiscard]] bool valid() const noexcept
+    {
+        for (size_t i = 0; i != size_; ++i)
+        {
+            if (parent_offsets_[i] > i)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Compute `world[i] = world[parent(i)] * local[i]` for every joint,
+    /// with `world[root] = root * local[root]`. `world` may alias `local`.
+    void evaluate(motor const& root,
+                  motor const* local,
+                  motor* world) const noexcept
+    {
+        for (size_t i = 0; i != size_; ++i)
+        {
+            uint16_t offset = parent_offsets_[i];
+            motor parent    = offset == 0 ? root : world[i - offset];
+            world[i]        = parent * local[i];
+        }
+    }
+
+    /// Write the skinning motors `world[i] * inv_bind_poses[i]`, which map
+    /// bind-pose vertices to their animated positions.
+    void skinning(motor const* world, motor* out) const noexcept
+    {
+        if (inv_bind_poses_ == nullptr)
+        {
+            for (size_t i = 0; i != size_; ++i)
+            {
+                out[i] = world[i];
+            }
+            return;
+        }
+        for (size_t i = 0; i != size_; ++i)
+        {
+            out[i] = world[i] * inv_bind_poses_[i];
+        }
+    }
+
+    /// Write skinning matrices as 3x4 column-major matrices (the usual
+    /// layout for upload to a skinning shader). World motors must be
+    /// normalized.
+    void skinning(motor const* world, mat3x4* out) const noexcept
+    {
+        skin_matrices<true>(world, out->cols);
+    }
+
+    /// Write skinning matrices as 4x4 column-major matrices.
+    void skinning(motor const* world, mat4x4* out) const noexcept
+    {
+        skin_matrices<false>(world, out->cols);
+    }
+
+private:
+    template <bool Normalized>
+    void skin_matrices(motor const* world, __m128* out) const noexcept
+    {
+        if (inv_bind_poses_ == nullptr)
+        {
+            mat4x4_12<true, Normalized, false>(&world->p1_, out, size_);
+            return;
+        }
+
+        // Compose four joints at a time so the conversion can run across
+        // all four lanes.
+        motor m[4];
+        for (size_t i = 0; i < size_; i += 4)
+        {
+            size_t n = size_ - i < 4 ? size_ - i : 4;
+            for (size_t j = 0; j != n; ++j)
+            {
+                m[j] = world[i + j] * inv_bind_poses_[i + j];
+            }
+            mat4x4_12<true, Normalized, false>(&m->p1_, out + 4 * i, n);
+        }
+    }
+
+    uint16_t const* parent_offsets_ = nullptr;
+    motor const* inv_bind_poses_    = nullptr;
+    size_t size_                    = 0;
+};
+
+/// Non-owning view of a single instance of a skeleton: a local motor per
+/// joint (relative to its parent) and the evaluated world motor per joint.
+class pose final
+{
+public:
+    pose() noexcept = default;
+
+    /// `local` and `world` must each hold `skel.size()` motors. The same
+    /// array may be passed for both if the local motors need not be kept.
+    pose(skeleton const& skel, motor* local, motor* world) noexcept
+        : skeleton_{&skel}
+        , local_{local}
+        , world_{world}
+    {}
+
+    [[nodiscard]] skeleton const& skel() const noexcept
+    {
+        return *skeleton_;
+    }
+
+    [[nodiscard]] motor* local() const noexcept
+    {
+        return local_;
+    }
+
+    [[nodiscard]] motor* world() const noexcept
+    {
+        return world_;
+    }
+
+    /// Propagate local motors to world motors, placing all roots relative to
+    /// `root` (e.g. the character's transform).
+    void evaluate(motor const& root) const noexcept
+    {
+        skeleton_->evaluate(root, local_, world_);
+    }
+
+    /// Propagate local motors to world motors in model space
+    void evaluate() const noexcept
+    {
+        evaluate(motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+    }
+
+    /// See `skeleton::skinning`. The pose must have been evaluated.
+    void skinning(motor* out) const noexcept
+    {
+        skeleton_->skinning(world_, out);
+    }
+
+    void skinning(mat3x4* out) const noexcept
+    {
+        skeleton_->skinning(world_, out);
+    }
+
+    void skinning(mat4x4* out) const noexcept
+    {
+        skeleton_->skinning(world_, out);
+    }
+
+private:
+    skeleton const* skeleton_ = nullptr;
+    motor* local_             = nullptr;
+    motor* world_             = nullptr;
+};
+
+/// Evaluate `count` instances of a skeleton whose local and world motors are
+/// stored back to back (instance `i` occupies
+/// `[i * skel.size(), (i + 1) * skel.size())`). `roots[i]` places the roots
+/// of instance `i`.
+inline void evaluate(skeleton const& skel,
+                     motor const* roots,
+                     motor const* local,
+                     motor* world,
+                     size_t count) noexcept
+{
+    size_t stride = skel.size();
+    for (size_t i = 0; i != count; ++i)
+    {
+        skel.evaluate(roots[i], local + i * stride, world + i * stride);
+    }
+}
+
+/// Write skinning matrices for `count` instances laid out as in
+/// `evaluate(skeleton const&, motor const*, motor const*, motor*, size_t)`.
+inline void skinning(skeleton const& skel,
+                     motor const* world,
+                     mat3x4* out,
+                     size_t count) noexcept
+{
+    size_t stride = skel.size();
+    for (size_t i = 0; i != count; ++i)
+    {
+        skel.skinning(world + i * stride, out + i * stride);
+    }
+}
+
+/// Skin `count` vertices with up to four joint influences each, writing the
+/// transformed positions (and optionally normals) to an output vertex
+/// buffer.
+///
+/// For each vertex, the four influencing skinning motors (see
+/// `skeleton::skinning`) are blended with the given weights and normalized
+/// (dual quaternion skinning), and the blended motor is applied directly to
+/// the position and normal. Influences are aligned to the hemisphere of the
+/// first influence before blending, since $m$ and $-m$ encode the same
+/// transform but would otherwise cancel. No intermediate motor or matrix
+/// arrays are written.
+///
+/// - `joints`: skinning motor per joint
+/// - `indices`: four joint indices per vertex. Unused influences must still
+///   reference a valid joint, with a weight of zero.
+/// - `weights`: four weights per vertex, typically summing to one
+/// - `normals` or `out_normals` may be `nullptr` to skip normals
+///
+/// Outputs may alias their corresponding inputs.
+inline void skin(motor const* joints,
+                 uint16_t const* indices,
+                 float const* weights,
+                 point const* positions,
+                 direction const* normals,
+                 point* out_positions,
+                 direction* out_normals,
+                 size_t count) noexcept
+{
+    __m128 sign_mask = _mm_set1_ps(-0.f);
+    for (size_t i = 0; i != count; ++i)
+    {
+        uint16_t const* idx = indices + 4 * i;
+        float const* w      = weights + 4 * i;
+
+        motor const& ref = joints[idx[0]];
+        __m128 w0        = _mm_set1_ps(w[0]);
+        __m128 p1        = _mm_mul_ps(ref.p1_, w0);
+        __m128 p2        = _mm_mul_ps(ref.p2_, w0);
+        for (size_t k = 1; k != 4; ++k)
+        {
+            motor const& m = joints[idx[k]];
+            __m128 sign = _mm_and_ps(detail::dp_bc(ref.p1_, m.p1_), sign_mask);
+            __m128 wk   = _mm_xor_ps(_mm_set1_ps(w[k]), sign);
+            p1          = _mm_add_ps(p1, _mm_mul_ps(m.p1_, wk));
+            p2          = _mm_add_ps(p2, _mm_mul_ps(m.p2_, wk));
+        }
+        motor blended{p1, p2};
+        blended.normalize();
+
+        __m128 in = positions[i].p3_;
+        detail::sw312<false, true>(
+            &in, blended.p1_, &blended.p2_, &out_positions[i].p3_);
+
+        if (normals != nullptr && out_normals != nullptr)
+        {
+            in = normals[i].p3_;
+            detail::sw312<false, false>(
+                &in, blended.p1_, nullptr, &out_normals[i].p3_);
+        }
+    }
+}
+/// @}
+} // namespace kln
@@ -2,6 +2,7 @@
 
 #include "detail/matrix.hpp"
 #include "line.hpp"
+#include "mat3x4.hpp"
 #include "mat4x4.hpp"
 #include "plane.hpp"
 #include "point.hpp"
@@ -90,6 +91,22 @@ public:
         return out;
     }
 
+    /// Converts the translator to a 3x4 column-major matrix.
+    [[nodiscard]] mat3x4 as_mat3x4() const noexcept
+    {
+        mat3x4 out;
+        mat4x4_2<false>(&p2_, out.cols, 1);
+        return out;
+    }
+
+    /// Converts the translator to a 4x4 column-major matrix.
+    [[nodiscard]] mat4x4 as_mat4x4() const noexcept
+    {
+        mat4x4 out;
+        mat4x4_2<false>(&p2_, out.cols, 1);
+        return out;
+    }
+
     /// Conjugates a plane $p$ with this translator and returns the result
     /// $tp\widetilde{t}$.
     [[nodiscard]] plane KLN_VEC_CALL operator()(plane const& p) const noexcept
@@ -271,5 +288,33 @@ public:
 {
     return t / static_cast<float>(s);
 }
+
+/// Convert an array of translators to 3x4 column-major matrices. See the
+/// motor overload of `to_mat3x4`.
+inline void to_mat3x4(translator const* in, mat3x4* out, size_t count) noexcept
+{
+    mat4x4_2<false>(&in->p2_, out->cols, count);
+}
+
+/// Convert an array of translators to 4x4 column-major matrices.
+inline void to_mat4x4(translator const* in, mat4x4* out, size_t count) noexcept
+{
+    mat4x4_2<false>(&in->p2_, out->cols, count);
+}
+
+/// Equivalent to `to_mat3x4`, with non-temporal stores. See the motor
+/// overload of `stream_mat3x4`.
+inline void
+stream_mat3x4(translator const* in, mat3x4* out, size_t count) noexcept
+{
+    mat4x4_2<true>(&in->p2_, out->cols, count);
+}
+
+/// Equivalent to `to_mat4x4`, with non-temporal stores.
+inline void
+stream_mat4x4(translator const* in, mat4x4* out, size_t count) noexcept
+{
+    mat4x4_2<true>(&in->p2_, out->cols, count);
+}
 } // namespace kln
 /// @}
@@ -0,0 +1,660 @@
+#include "codegen.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+struct layout_lane
+{
+    uint32_t blade;
+    float sign;
+};
+
+// Basis blade and orientation of each lane of the four partitions. Blades are
+// bitfields with e0 in the least significant bit.
+constexpr layout_lane layouts[4][4] = {
+    // p0: (e0, e1, e2, e3)
+    {{0b1, 1.f}, {0b10, 1.f}, {0b100, 1.f}, {0b1000, 1.f}},
+    // p1: (1, e23, e31, e12)
+    {{0, 1.f}, {0b1100, 1.f}, {0b1010, -1.f}, {0b110, 1.f}},
+    // p2: (e0123, e01, e02, e03)
+    {{0b1111, 1.f}, {0b11, 1.f}, {0b101, 1.f}, {0b1001, 1.f}},
+    // p3: (e123, e032, e013, e021)
+    {{0b1110, 1.f}, {0b1101, -1.f}, {0b1011, 1.f}, {0b111, -1.f}}};
+
+// Splits a variable such as "b2" into its register "b" and lane 2
+std::pair<std::string, uint32_t> split_var(std::string const& var)
+{
+    if (var.size() < 2 || var.back() < '0' || var.back() > '3')
+    {
+        throw std::runtime_error("Variable " + var
+                                 + " must end with a lane index from 0 to 3");
+    }
+    return {var.substr(0, var.size() - 1),
+            static_cast<uint32_t>(var.back() - '0')};
+}
+
+std::string literal(float f)
+{
+    std::ostringstream os;
+    os.precision(9);
+    os << f;
+    std::string out = os.str();
+    if (out.find_first_of(".e") == std::string::npos)
+    {
+        out += '.';
+    }
+    return out + 'f';
+}
+
+std::string blade_name(uint32_t blade)
+{
+    std::string out = "e";
+    for (uint32_t i = 0; i != 4; ++i)
+    {
+        if (blade & (1 << i))
+        {
+            out += static_cast<char>('0' + i);
+        }
+    }
+    return blade == 0 ? "scalar" : out;
+}
+} // namespace
+
+simd_target parse_target(std::string const& name)
+{
+    if (name == "sse3")
+    {
+        return simd_target::sse3;
+    }
+    else if (name == "sse41")
+    {
+        return simd_target::sse41;
+    }
+    else if (name == "avx2")
+    {
+        return simd_target::avx2;
+    }
+    throw std::runtime_error("Unknown target " + name
+                             + " (expected sse3, sse41, or avx2)");
+}
+
+kernel::kernel(mv const& result,
+               std::vector<uint32_t> const& partitions,
+               simd_target target)
+    : target_{target}
+    , partitions_{partitions}
+{
+    std::set<uint32_t> covered;
+    for (uint32_t p : partitions_)
+    {
+        if (p > 3)
+        {
+            throw std::runtime_error("Partitions range from p0 to p3");
+        }
+        for (layout_lane const& l : layouts[p])
+        {
+            covered.insert(l.blade);
+        }
+    }
+
+    // Collect the input registers up front so that they are ordered by name
+    std::set<std::string> registers;
+    for (auto&& [blade, p] : result.terms)
+    {
+        if (covered.count(blade) == 0 && !p.terms.empty())
+        {
+            throw std::runtime_error("Result has a " + blade_name(blade)
+                                     + " component outside the outputs");
+        }
+        for (auto&& [m, f] : p.terms)
+        {
+            for (uint32_t id = 0; id != m.size(); ++id)
+            {
+                if (m.exponent(id) != 0)
+                {
+                    registers.insert(split_var(var_name(id)).first);
+                }
+            }
+        }
+    }
+    inputs_.assign(registers.begin(), registers.end());
+
+    for (uint32_t p : partitions_)
+    {
+        std::string out = "p" + std::to_string(p) + "_out";
+        if (registers.count(out) != 0)
+        {
+            throw std::runtime_error("Input register " + out
+                                     + " clashes with an output");
+        }
+
+        std::array<std::vector<term>, 4> lanes;
+        for (uint32_t i = 0; i != 4; ++i)
+        {
+            auto it = result.terms.find(layouts[p][i].blade);
+            if (it == result.terms.end())
+            {
+                continue;
+            }
+
+            for (auto&& [m, f] : it->second.terms)
+            {
+                if (f != 0.f)
+                {
+                    lanes[i].push_back({factors(m), f * layouts[p][i].sign});
+                }
+            }
+        }
+        outputs_.push_back(build(lanes));
+    }
+}
+
+uint32_t kernel::input_register(std::string const& name)
+{
+    auto it = std::find(inputs_.begin(), inputs_.end(), name);
+    return static_cast<uint32_t>(it - inputs_.begin());
+}
+
+std::vector<kernel::factor> kernel::factors(mon const& m)
+{
+    std::vector<factor> out;
+    for (uint32_t id = 0; id != m.size(); ++id)
+    {
+        int deg = m.exponent(id);
+        if (deg == 0)
+        {
+            continue;
+        }
+        else if (deg < 0)
+        {
+            throw std::runtime_error("Cannot generate code for " + var_name(id)
+                                     + "^" + std::to_string(deg));
+        }
+
+        auto [reg, lane] = split_var(var_name(id));
+        for (int i = 0; i != deg; ++i)
+        {
+            out.push_back({input_register(reg), lane});
+        }
+    }
+
+    std::sort(out.begin(), out.end(), [](factor lhs, factor rhs) {
+        return lhs.reg < rhs.reg || (lhs.reg == rhs.reg && lhs.lane < rhs.lane);
+    });
+    return out;
+}
+
+uint32_t kernel::push(op const& o)
+{
+    std::array<uint32_t, 8> key{
+        static_cast<uint32_t>(o.code), o.args[0], o.args[1], o.args[2]};
+    if (o.code == op_code::constant)
+    {
+        std::memcpy(&key[4], o.constant.data(), sizeof(o.constant));
+    }
+    else
+    {
+        std::copy(o.lanes.begin(), o.lanes.end(), key.begin() + 4);
+    }
+
+    auto it = memo_.find(key);
+    if (it != memo_.end())
+    {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(ops_.size());
+    ops_.push_back(o);
+    memo_.emplace(key, id);
+    return id;
+}
+
+uint32_t kernel::swizzle(uint32_t reg, std::array<uint32_t, 4> const& lanes)
+{
+    return push({op_code::swizzle, {reg, 0, 0}, lanes, {}});
+}
+
+uint32_t kernel::product(uint32_t lhs, uint32_t rhs)
+{
+    // Multiplication commutes, so normalize the operand order for the memo
+    return push(
+        {op_code::mul, {std::min(lhs, rhs), std::max(lhs, rhs), 0}, {}, {}});
+}
+
+uint32_t kernel::build(std::array<std::vector<term>, 4> const& lanes)
+{
+    // Bucket the terms of each lane by the registers they multiply
+    // (including multiplicity) so that a column of terms, one from each lane,
+    // has the same shape and can be evaluated as one vector product.
+    std::map<std::vector<uint32_t>, std::array<std::vector<term>, 4>> shapes;
+    for (uint32_t i = 0; i != 4; ++i)
+    {
+        for (term const& t : lanes[i])
+        {
+            std::vector<uint32_t> shape;
+            for (factor f : t.factors)
+            {
+                shape.push_back(f.reg);
+            }
+            shapes[shape][i].push_back(t);
+        }
+    }
+
+    struct column
+    {
+        // One lane pattern per factor
+        std::vector<std::pair<uint32_t, std::array<uint32_t, 4>>> factors;
+        std::array<float, 4> f;
+        uint32_t present;
+    };
+    std::vector<column> columns;
+
+    for (auto& [shape, shape_lanes] : shapes)
+    {
+        for (auto& l : shape_lanes)
+        {
+            // Line up terms across lanes by their factor lanes so that
+            // matching swizzles recur
+            std::sort(l.begin(), l.end(), [](term const& lhs, term const& rhs) {
+                for (size_t k = 0; k != lhs.factors.size(); ++k)
+                {
+                    if (lhs.factors[k].lane != rhs.factors[k].lane)
+                    {
+                        return lhs.factors[k].lane < rhs.factors[k].lane;
+                    }
+                }
+                return false;
+            });
+        }
+
+        for (size_t row = 0;; ++row)
+        {
+            column c{{}, {0.f, 0.f, 0.f, 0.f}, 0};
+            for (uint32_t k = 0; k != shape.size(); ++k)
+            {
+                c.factors.push_back({shape[k], {0, 1, 2, 3}});
+            }
+
+            for (uint32_t i = 0; i != 4; ++i)
+            {
+                if (row < shape_lanes[i].size())
+                {
+                    term const& t = shape_lanes[i][row];
+                    c.f[i]        = t.f;
+                    c.present |= 1 << i;
+                    for (size_t k = 0; k != t.factors.size(); ++k)
+                    {
+                        c.factors[k].second[i] = t.factors[k].lane;
+                    }
+                }
+            }
+
+            if (c.present == 0)
+            {
+                break;
+            }
+            columns.push_back(c);
+        }
+    }
+
+    auto negative = [](column const& c) {
+        for (uint32_t i = 0; i != 4; ++i)
+        {
+            if ((c.present & (1 << i)) && c.f[i] != -1.f)
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // Start with a column that doesn't need its sign flipped if possible
+    std::stable_partition(columns.begin(), columns.end(), [&](column const& c) {
+        return !negative(c);
+    });
+
+    bool has_acc = false;
+    uint32_t acc = 0;
+
+    for (column const& c : columns)
+    {
+        if (c.factors.empty())
+        {
+            uint32_t k = push({op_code::constant, {}, {}, c.f});
+            if (has_acc)
+            {
+                k = push({op_code::add, {acc, k, 0}, {}, {}});
+            }
+            acc     = k;
+            has_acc = true;
+            continue;
+        }
+
+        bool unit          = true;
+        uint32_t flip_mask = 0;
+        for (uint32_t i = 0; i != 4; ++i)
+        {
+            if (c.present & (1 << i))
+            {
+                unit = unit && (c.f[i] == 1.f || c.f[i] == -1.f);
+                flip_mask |= c.f[i] < 0.f ? 1 << i : 0;
+            }
+        }
+        bool partial = c.present != 0b1111;
+        bool scale   = !unit || (partial && target_ == simd_target::sse3);
+
+        std::vector<uint32_t> values;
+        for (auto const& [reg, pattern] : c.factors)
+        {
+            values.push_back(swizzle(reg, pattern));
+        }
+
+        // Unit coefficients are applied to the first factor. Columns with
+        // all lanes negated are subtracted from the accumulator instead.
+        bool subtract = false;
+        if (!scale)
+        {
+            if (partial)
+            {
+                values[0] = push({op_code::blend_zero,
+                                  {values[0], 0, 0},
+                                  {~c.present & 0b1111},
+                                  {}});
+            }
+
+            if (flip_mask == c.present && has_acc)
+            {
+                subtract = true;
+            }
+            else if (flip_mask != 0)
+            {
+                values[0] = push(
+                    {op_code::flip, {values[0], 0, 0}, {flip_mask}, {}});
+            }
+        }
+
+        // With FMA, the last multiplication is fused with the accumulation
+        bool fuse = target_ == simd_target::avx2 && has_acc
+                    && (scale || values.size() > 1);
+
+        uint32_t v = values[0];
+        for (size_t k = 1; k + 1 < values.size(); ++k)
+        {
+            v = product(v, values[k]);
+        }
+
+        uint32_t last = values.back();
+        if (scale)
+        {
+            if (values.size() > 1)
+            {
+                v = product(v, values.back());
+            }
+            last = push({op_code::constant, {}, {}, c.f});
+        }
+        else if (values.size() == 1)
+        {
+            fuse = false;
+        }
+
+        if (fuse)
+        {
+            acc = push({subtract ? op_code::fnmadd : op_code::fmadd,
+                        {v, last, acc},
+                        {},
+                        {}});
+            continue;
+        }
+
+        if (scale || values.size() > 1)
+        {
+            v = scale ? push({op_code::mul, {v, last, 0}, {}, {}})
+                      : product(v, last);
+        }
+
+        if (has_acc)
+        {
+            acc = push(
+                {subtract ? op_code::sub : op_code::add, {acc, v, 0}, {}, {}});
+        }
+        else
+        {
+            acc = v;
+        }
+        has_acc = true;
+    }
+
+    if (!has_acc)
+    {
+        acc = push({op_code::constant, {}, {}, {0.f, 0.f, 0.f, 0.f}});
+    }
+    return acc;
+}
+
+std::vector<std::array<float, 4>>
+kernel::eval(std::vector<std::array<float, 4>> const& in) const
+{
+    if (in.size() != inputs_.size())
+    {
+        throw std::runtime_error("Expected " + std::to_string(inputs_.size())
+                                 + " input registers");
+    }
+
+    std::vector<std::array<float, 4>> values(ops_.size());
+    for (size_t i = 0; i != ops_.size(); ++i)
+    {
+        op const& o                   = ops_[i];
+        std::array<float, 4> const* a = nullptr;
+        std::array<float, 4> const* b = nullptr;
+        std::array<float, 4> const* c = nullptr;
+        if (o.code != op_code::swizzle && o.code != op_code::constant)
+        {
+            a = &values[o.args[0]];
+            b = &values[o.args[1]];
+            c = &values[o.args[2]];
+        }
+
+        for (uint32_t j = 0; j != 4; ++j)
+        {
+            float& out = values[i][j];
+            switch (o.code)
+            {
+                case op_code::swizzle:
+                    out = in[o.args[0]][o.lanes[j]];
+                    break;
+                case op_code::constant:
+                    out = o.constant[j];
+                    break;
+                case op_code::mul:
+                    out = (*a)[j] * (*b)[j];
+                    break;
+                case op_code::add:
+                    out = (*a)[j] + (*b)[j];
+                    break;
+                case op_code::sub:
+                    out = (*a)[j] - (*b)[j];
+                    break;
+                case op_code::flip:
+                    out = (o.lanes[0] & (1 << j)) ? -(*a)[j] : (*a)[j];
+                    break;
+                case op_code::blend_zero:
+                    out = (o.lanes[0] & (1 << j)) ? 0.f : (*a)[j];
+                    break;
+                case op_code::fmadd:
+                    out = (*a)[j] * (*b)[j] + (*c)[j];
+                    break;
+                case op_code::fnmadd:
+                    out = (*c)[j] - (*a)[j] * (*b)[j];
+                    break;
+            }
+        }
+    }
+
+    std::vector<std::array<float, 4>> out;
+    for (uint32_t id : outputs_)
+    {
+        out.push_back(values[id]);
+    }
+    return out;
+}
+
+void kernel::emit(std::ostream& os, std::string const& name) const
+{
+    static char const xyzw[] = "xyzw";
+
+    // Name each value. Identity swizzles are the input register itself.
+    std::vector<std::string> names(ops_.size());
+    uint32_t temps     = 0;
+    uint32_t constants = 0;
+    for (size_t i = 0; i != ops_.size(); ++i)
+    {
+        op const& o = ops_[i];
+        if (o.code == op_code::swizzle)
+        {
+            names[i] = inputs_[o.args[0]];
+            if (o.lanes != std::array<uint32_t, 4>{0, 1, 2, 3})
+            {
+                names[i] += '_';
+                for (uint32_t lane : o.lanes)
+                {
+                    names[i] += xyzw[lane];
+                }
+            }
+        }
+        else if (o.code == op_code::constant)
+        {
+            names[i] = "k" + std::to_string(constants++);
+        }
+        else
+        {
+            names[i] = "t" + std::to_string(temps++);
+        }
+    }
+
+    auto mask_constant = [](uint32_t mask, char const* on) {
+        std::string out = "_mm_set_ps(";
+        for (uint32_t j = 4; j-- != 0;)
+        {
+            out += (mask & (1 << j)) ? on : "0.f";
+            out += j == 0 ? ")" : ", ";
+        }
+        return out;
+    };
+
+    os << "KLN_INLINE void KLN_VEC_CALL " << name << '(';
+    for (size_t i = 0; i != inputs_.size(); ++i)
+    {
+        os << "__m128 " << inputs_[i] << ", ";
+    }
+    for (size_t i = 0; i != partitions_.size(); ++i)
+    {
+        os << "__m128& " << (partitions_.size() > 1 ? "KLN_RESTRICT " : "")
+           << 'p' << partitions_[i] << "_out"
+           << (i + 1 == partitions_.size() ? ")\n" : ", ");
+    }
+    os << "{\n";
+
+    for (size_t i = 0; i != ops_.size(); ++i)
+    {
+        op const& o = ops_[i];
+        std::string a, b, c;
+        if (o.code != op_code::swizzle && o.code != op_code::constant)
+        {
+            a = names[o.args[0]];
+            b = names[o.args[1]];
+            c = names[o.args[2]];
+        }
+
+        if (o.code == op_code::swizzle
+            && o.lanes == std::array<uint32_t, 4>{0, 1, 2, 3})
+        {
+            continue;
+        }
+
+        os << "    __m128 " << names[i] << " = ";
+        switch (o.code)
+        {
+            case op_code::swizzle:
+                if (target_ == simd_target::avx2)
+                {
+                    os << "_mm_permute_ps(" << inputs_[o.args[0]]
+                       << ", _MM_SHUFFLE(";
+                }
+                else
+                {
+                    os << "KLN_SWIZZLE(" << inputs_[o.args[0]] << ", ";
+                }
+                os << o.lanes[3] << ", " << o.lanes[2] << ", " << o.lanes[1]
+                   << ", " << o.lanes[0]
+                   << (target_ == simd_target::avx2 ? "))" : ")");
+                break;
+            case op_code::constant:
+                if (o.constant[0] == o.constant[1]
+                    && o.constant[0] == o.constant[2]
+                    && o.constant[0] == o.constant[3])
+                {
+                    os << "_mm_set1_ps(" << literal(o.constant[0]) << ')';
+                }
+                else
+                {
+                    os << "_mm_set_ps(" << literal(o.constant[3]) << ", "
+                       << literal(o.constant[2]) << ", "
+                       << literal(o.constant[1]) << ", "
+                       << literal(o.constant[0]) << ')';
+                }
+                break;
+            case op_code::mul:
+                os << "_mm_mul_ps(" << a << ", " << b << ')';
+                break;
+            case op_code::add:
+                os << "_mm_add_ps(" << a << ", " << b << ')';
+                break;
+            case op_code::sub:
+                os << "_mm_sub_ps(" << a << ", " << b << ')';
+                break;
+            case op_code::flip:
+                os << "_mm_xor_ps(" << a << ", ";
+                if (o.lanes[0] == 1)
+                {
+                    os << "_mm_set_ss(-0.f)";
+                }
+                else if (o.lanes[0] == 0b1111)
+                {
+                    os << "_mm_set1_ps(-0.f)";
+                }
+                else
+                {
+                    os << mask_constant(o.lanes[0], "-0.f");
+                }
+                os << ')';
+                break;
+            case op_code::blend_zero:
+                os << "_mm_blend_ps(" << a << ", _mm_setzero_ps(), 0b";
+                for (uint32_t j = 4; j-- != 0;)
+                {
+                    os << ((o.lanes[0] & (1 << j)) ? '1' : '0');
+                }
+                os << ')';
+                break;
+            case op_code::fmadd:
+                os << "_mm_fmadd_ps(" << a << ", " << b << ", " << c << ')';
+                break;
+            case op_code::fnmadd:
+                os << "_mm_fnmadd_ps(" << a << ", " << b << ", " << c << ')';
+                break;
+        }
+        os << ";\n";
+    }
+
+    for (size_t i = 0; i != partitions_.size(); ++i)
+    {
+        os << "    p" << partitions_[i] << "_out = " << names[outputs_[i]]
+           << ";\n";
+    }
+    os << "}\n";
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "ga.hpp"
+
+#include <array>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Instruction sets the code generator can target
+//     sse3:  swizzles with shufps, zero lanes by multiplying with a constant
+//     sse41: as sse3, but lanes are zeroed with blendps
+//     avx2:  swizzles with vpermilps and products accumulate with FMA
+enum class simd_target
+{
+    sse3,
+    sse41,
+    avx2
+};
+
+// Accepts "sse3", "sse41", or "avx2". Throws std::runtime_error otherwise.
+simd_target parse_target(std::string const& name);
+
+// Straight-line SIMD kernel over 4-wide float registers, generated from the
+// result of a symbolic expression. Every variable in the expression must be
+// named with a register prefix followed by a lane index from 0 to 3 (so
+// a0, a1, a2, a3 are the lanes of the input register a). Each output is one
+// of the partitions
+//     LSB --> MSB
+// p0: (e0, e1, e2, e3)
+// p1: (1, e23, e31, e12)
+// p2: (e0123, e01, e02, e03)
+// p3: (e123, e032, e013, e021)
+//
+// The coefficient of every output lane is split into columns of monomials
+// with the same register degrees, so that each column is a product of
+// swizzled inputs scaled by a per-lane constant. Swizzles and partial
+// products shared between columns and outputs are computed once.
+class kernel
+{
+public:
+    enum class op_code
+    {
+        // Lanes of an input register after a swizzle
+        swizzle,
+        // Four constant lanes
+        constant,
+        mul,
+        add,
+        sub,
+        // Flip the sign of the lanes in mask
+        flip,
+        // Clear the lanes in mask
+        blend_zero,
+        // a * b + c
+        fmadd,
+        // c - a * b
+        fnmadd
+    };
+
+    struct op
+    {
+        op_code code;
+        // Input register for swizzle, otherwise the operand value ids
+        uint32_t args[3];
+        // Lane pattern for swizzle, lane mask for flip and blend_zero
+        std::array<uint32_t, 4> lanes;
+        std::array<float, 4> constant;
+    };
+
+    // Throws std::runtime_error if a variable can't be mapped to a register
+    // lane, a monomial has a negative exponent, or the result has a
+    // component outside the requested partitions.
+    kernel(mv const& result,
+           std::vector<uint32_t> const& partitions,
+           simd_target target);
+
+    // Evaluate the kernel in scalar code. Inputs are given in the order of
+    // inputs(), and outputs are returned in the order of the partitions.
+    std::vector<std::array<float, 4>>
+    eval(std::vector<std::array<float, 4>> const& in) const;
+
+    // Emit the kernel as a KLN_INLINE function in the style of the
+    // detail/x86 headers
+    void emit(std::ostream& os, std::string const& name) const;
+
+    std::vector<std::string> const& inputs() const noexcept
+    {
+        return inputs_;
+    }
+
+    std::vector<op> const& ops() const noexcept
+    {
+        return ops_;
+    }
+
+private:
+    struct factor
+    {
+        uint32_t reg;
+        uint32_t lane;
+    };
+
+    struct term
+    {
+        std::vector<factor> factors;
+        float f;
+    };
+
+    uint32_t input_register(std::string const& name);
+    std::vector<factor> factors(mon const& m);
+    uint32_t push(op const& o);
+    uint32_t swizzle(uint32_t reg, std::array<uint32_t, 4> const& lanes);
+    uint32_t product(uint32_t lhs, uint32_t rhs);
+    uint32_t build(std::array<std::vector<term>, 4> const& lanes);
+
+    simd_target target_;
+    std::vector<std::string> inputs_;
+    std::vector<uint32_t> partitions_;
+    std::vector<op> ops_;
+    // Value id of each output, in the order of the partitions
+    std::vector<uint32_t> outputs_;
+    // Common subexpressions keyed on the code, args, and lanes or constant
+    std::map<std::array<uint32_t, 8>, uint32_t> memo_;
+};
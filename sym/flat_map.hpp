@@ -0,0 +1,241 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Hash map with open addressing. Entries are stored densely in insertion
+// order and a power-of-two table of linear-probed slots indexes into them,
+// so lookups touch a single contiguous array and iteration is a plain vector
+// walk. Erasing moves the last entry into the hole, which invalidates
+// iterators to the last entry only.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class flat_map
+{
+public:
+    using value_type     = std::pair<K, V>;
+    using iterator       = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    iterator begin() noexcept
+    {
+        return entries_.begin();
+    }
+
+    iterator end() noexcept
+    {
+        return entries_.end();
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return entries_.begin();
+    }
+
+    const_iterator end() const noexcept
+    {
+        return entries_.end();
+    }
+
+    const_iterator cbegin() const noexcept
+    {
+        return entries_.cbegin();
+    }
+
+    const_iterator cend() const noexcept
+    {
+        return entries_.cend();
+    }
+
+    size_t size() const noexcept
+    {
+        return entries_.size();
+    }
+
+    bool empty() const noexcept
+    {
+        return entries_.empty();
+    }
+
+    void clear() noexcept
+    {
+        entries_.clear();
+        hashes_.clear();
+        slots_.assign(slots_.size(), 0);
+    }
+
+    void reserve(size_t count)
+    {
+        entries_.reserve(count);
+        hashes_.reserve(count);
+        if (count * 4 > slots_.size() * 3)
+        {
+            rehash(capacity_for(count));
+        }
+    }
+
+    iterator find(K const& key) noexcept
+    {
+        size_t slot = lookup(key, Hash{}(key));
+        return slots_.empty() || slots_[slot] == 0
+                   ? end()
+                   : begin() + (slots_[slot] - 1);
+    }
+
+    const_iterator find(K const& key) const noexcept
+    {
+        size_t slot = lookup(key, Hash{}(key));
+        return slots_.empty() || slots_[slot] == 0
+                   ? end()
+                   : begin() + (slots_[slot] - 1);
+    }
+
+    std::pair<iterator, bool> emplace(K const& key, V value)
+    {
+        size_t hash = Hash{}(key);
+        size_t slot = lookup(key, hash);
+        if (!slots_.empty() && slots_[slot] != 0)
+        {
+            return {begin() + (slots_[slot] - 1), false};
+        }
+
+        if ((entries_.size() + 1) * 4 > slots_.size() * 3)
+        {
+            rehash(capacity_for(entries_.size() + 1));
+            slot = lookup(key, hash);
+        }
+
+        entries_.emplace_back(key, std::move(value));
+        hashes_.push_back(hash);
+        slots_[slot] = static_cast<uint32_t>(entries_.size());
+        return {end() - 1, true};
+    }
+
+    V& operator[](K const& key)
+    {
+        return emplace(key, V{}).first->second;
+    }
+
+    // Returns an iterator to the entry that took the place of the erased one
+    // (or end() if the last entry was erased)
+    iterator erase(const_iterator it) noexcept
+    {
+        uint32_t index = static_cast<uint32_t>(it - cbegin());
+        unlink(index);
+
+        uint32_t last = static_cast<uint32_t>(entries_.size() - 1);
+        if (index != last)
+        {
+            slots_[find_slot(last)] = index + 1;
+            entries_[index]         = std::move(entries_[last]);
+            hashes_[index]          = hashes_[last];
+        }
+        entries_.pop_back();
+        hashes_.pop_back();
+        return begin() + index;
+    }
+
+    // Removes every entry for which pred(entry) is true
+    template <typename P>
+    void erase_if(P pred) noexcept
+    {
+        for (auto it = begin(); it != end();)
+        {
+            if (pred(*it))
+            {
+                it = erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+private:
+    static size_t capacity_for(size_t count) noexcept
+    {
+        size_t out = 16;
+        while (count * 4 > out * 3)
+        {
+            out *= 2;
+        }
+        return out;
+    }
+
+    // Slot holding key, or the empty slot where it would be inserted
+    size_t lookup(K const& key, size_t hash) const noexcept
+    {
+        if (slots_.empty())
+        {
+            return 0;
+        }
+
+        size_t mask = slots_.size() - 1;
+        size_t slot = hash & mask;
+        while (slots_[slot] != 0)
+        {
+            uint32_t index = slots_[slot] - 1;
+            if (hashes_[index] == hash && entries_[index].first == key)
+            {
+                break;
+            }
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    // Slot referring to the entry at index
+    size_t find_slot(uint32_t index) const noexcept
+    {
+        size_t mask = slots_.size() - 1;
+        size_t slot = hashes_[index] & mask;
+        while (slots_[slot] != index + 1)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    // Remove the slot for the entry at index, shifting back any entries in
+    // the same probe run so that no tombstones are needed
+    void unlink(uint32_t index) noexcept
+    {
+        size_t mask = slots_.size() - 1;
+        size_t hole = find_slot(index);
+        size_t next = (hole + 1) & mask;
+        while (slots_[next] != 0)
+        {
+            size_t home = hashes_[slots_[next] - 1] & mask;
+            if (((next - home) & mask) >= ((next - hole) & mask))
+            {
+                slots_[hole] = slots_[next];
+                hole         = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots_[hole] = 0;
+    }
+
+    void rehash(size_t capacity)
+    {
+        slots_.assign(capacity, 0);
+        size_t mask = capacity - 1;
+        for (uint32_t i = 0; i != entries_.size(); ++i)
+        {
+            size_t slot = hashes_[i] & mask;
+            while (slots_[slot] != 0)
+            {
+                slot = (slot + 1) & mask;
+            }
+            slots_[slot] = i + 1;
+        }
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<size_t> hashes_;
+    // 0 marks an empty slot, otherwise the entry index + 1
+    std::vector<uint32_t> slots_;
+};
@@ -1,5 +1,6 @@
 #include "ga.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <immintrin.h>
 
@@ -16,6 +17,36 @@ algebra::algebra(uint32_t p, uint32_t q, uint32_t r)
 {
     assert(dim_ < 32
            && "Exceeded maximum metric size that can fit in a 32-bit integer");
+
+    if (dim_ > max_table_dim)
+    {
+        return;
+    }
+
+    uint32_t count = 1 << dim_;
+    bool has_dual  = p_ == 3 && q_ == 0 && r_ == 1;
+    mul_table_.resize(count * count);
+    ext_table_.resize(count * count);
+    dot_table_.resize(count * count);
+    if (has_dual)
+    {
+        reg_table_.resize(count * count);
+    }
+
+    for (uint32_t lhs = 0; lhs != count; ++lhs)
+    {
+        for (uint32_t rhs = 0; rhs != count; ++rhs)
+        {
+            uint32_t i    = (lhs << dim_) | rhs;
+            mul_table_[i] = compute_mul(lhs, rhs);
+            ext_table_[i] = compute_ext(lhs, rhs);
+            dot_table_[i] = compute_dot(lhs, rhs);
+            if (has_dual)
+            {
+                reg_table_[i] = compute_reg(lhs, rhs);
+            }
+        }
+    }
 }
 
 bool algebra::operator==(algebra const& other) const noexcept
@@ -24,6 +55,30 @@ bool algebra::operator==(algebra const& other) const noexcept
 }
 
 int32_t algebra::mul(uint32_t lhs, uint32_t rhs) const noexcept
+{
+    return mul_table_.empty() ? compute_mul(lhs, rhs)
+                              : mul_table_[(lhs << dim_) | rhs];
+}
+
+int32_t algebra::ext(uint32_t lhs, uint32_t rhs) const noexcept
+{
+    return ext_table_.empty() ? compute_ext(lhs, rhs)
+                              : ext_table_[(lhs << dim_) | rhs];
+}
+
+int32_t algebra::reg(uint32_t lhs, uint32_t rhs) const noexcept
+{
+    return reg_table_.empty() ? compute_reg(lhs, rhs)
+                              : reg_table_[(lhs << dim_) | rhs];
+}
+
+int32_t algebra::dot(uint32_t lhs, uint32_t rhs) const noexcept
+{
+    return dot_table_.empty() ? compute_dot(lhs, rhs)
+                              : dot_table_[(lhs << dim_) | rhs];
+}
+
+int32_t algebra::compute_mul(uint32_t lhs, uint32_t rhs) const noexcept
 {
     if (lhs == 0 && rhs == 0)
     {
@@ -42,8 +97,8 @@ int32_t algebra::mul(uint32_t lhs, uint32_t rhs) const noexcept
 
     for (uint32_t i = 0; i != dim_; ++i)
     {
-        uint8_t index = dim_ - i - 1;
-        uint8_t bit   = 1 << index;
+        uint32_t index = dim_ - i - 1;
+        uint32_t bit   = 1u << index;
         bool lhs_e    = (lhs & bit) > 0;
         bool rhs_e    = (rhs & bit) > 0;
 
@@ -73,7 +128,7 @@ int32_t algebra::mul(uint32_t lhs, uint32_t rhs) const noexcept
     return factor * ((lhs ^ rhs) + 1);
 }
 
-int32_t algebra::ext(uint32_t lhs, uint32_t rhs) const noexcept
+int32_t algebra::compute_ext(uint32_t lhs, uint32_t rhs) const noexcept
 {
     if ((lhs & rhs) > 0)
     {
@@ -148,7 +203,7 @@ int32_t algebra::dual(uint32_t in) const noexcept
     }
 }
 
-int32_t algebra::reg(uint32_t lhs, uint32_t rhs) const noexcept
+int32_t algebra::compute_reg(uint32_t lhs, uint32_t rhs) const noexcept
 {
     int32_t lhs_j = dual(lhs);
     int32_t rhs_j = dual(rhs);
@@ -159,7 +214,7 @@ int32_t algebra::reg(uint32_t lhs, uint32_t rhs) const noexcept
         factor *= -1;
     }
 
-    int32_t ext_j = ext(std::abs(lhs_j) - 1, std::abs(rhs_j) - 1);
+    int32_t ext_j = compute_ext(std::abs(lhs_j) - 1, std::abs(rhs_j) - 1);
     if (ext_j < 0)
     {
         factor *= -1;
@@ -175,7 +230,7 @@ int32_t algebra::reg(uint32_t lhs, uint32_t rhs) const noexcept
 
 // The inner product contracts indices between the LHS and RHS producing an
 // element that is "most unlike" the lower-graded element.
-int32_t algebra::dot(uint32_t lhs, uint32_t rhs) const noexcept
+int32_t algebra::compute_dot(uint32_t lhs, uint32_t rhs) const noexcept
 {
     if (lhs == 0 || rhs == 0)
     {
@@ -183,7 +238,7 @@ int32_t algebra::dot(uint32_t lhs, uint32_t rhs) const noexcept
     }
 
     // Reuse the existing geometric product to compute the inner product
-    int32_t g = mul(lhs, rhs);
+    int32_t g = compute_mul(lhs, rhs);
     if (g == 0)
     {
         return 0;
@@ -214,12 +269,8 @@ mv::mv(algebra const& a) noexcept
 
 mv& mv::push(uint32_t e, poly const& p) noexcept
 {
-    auto it = terms.find(e);
-    if (it == terms.end())
-    {
-        terms.emplace(e, p);
-    }
-    else
+    auto [it, inserted] = terms.emplace(e, p);
+    if (!inserted)
     {
         it->second += p;
 
@@ -303,143 +354,64 @@ mv operator+(mv const& lhs, mv const& rhs) noexcept
     return out;
 }
 
-mv& mv::operator*=(mv const& other) noexcept
+mv& mv::operator*=(mv const& other)
 {
     mv result = *this * other;
     std::swap(terms, result.terms);
     return *this;
 }
 
-mv operator*(mv const& lhs, mv const& rhs) noexcept
+mv operator*(mv const& lhs, mv const& rhs)
 {
-    mv out{*lhs.algebra_};
-
-    for (auto&& [e1, p1] : lhs.terms)
-    {
-        for (auto&& [e2, p2] : rhs.terms)
-        {
-            int32_t result = lhs.algebra_->mul(e1, e2);
-            if (result != 0)
-            {
-                uint32_t e = std::abs(result) - 1;
-                auto it    = out.terms.find(e);
-
-                poly p12 = p1 * p2;
-
-                if (it == out.terms.end())
-                {
-                    it = out.terms.emplace(e, poly{}).first;
-                }
-
-                if (result < 0)
-                {
-                    it->second += -p12;
-                }
-                else
-                {
-                    it->second += p12;
-                }
-            }
-        }
-    }
-
-    return out.prune();
+    algebra const& a = *lhs.algebra_;
+    return mv::combine(
+        lhs, rhs, [&a](uint32_t e1, uint32_t e2) { return a.mul(e1, e2); });
 }
 
-mv& mv::operator^=(mv const& other) noexcept
+mv& mv::operator^=(mv const& other)
 {
     mv result = *this ^ other;
     std::swap(terms, result.terms);
     return *this;
 }
 
-mv operator^(mv const& lhs, mv const& rhs) noexcept
+mv operator^(mv const& lhs, mv const& rhs)
 {
-    mv out{*lhs.algebra_};
-
-    for (auto&& [e1, p1] : lhs.terms)
-    {
-        for (auto&& [e2, p2] : rhs.terms)
-        {
-            int32_t result = lhs.algebra_->ext(e1, e2);
-            if (result != 0)
-            {
-                uint32_t e = std::abs(result) - 1;
-                auto it    = out.terms.find(e);
-
-                poly p12 = p1 * p2;
-
-                if (it == out.terms.end())
-                {
-                    it = out.terms.emplace(e, poly{}).first;
-                }
-
-                if (result < 0)
-                {
-                    it->second += -p12;
-                }
-                else
-                {
-                    it->second += p12;
-                }
-            }
-        }
-    }
-
-    return out.prune();
+    algebra const& a = *lhs.algebra_;
+    return mv::combine(
+        lhs, rhs, [&a](uint32_t e1, uint32_t e2) { return a.ext(e1, e2); });
 }
 
-mv& mv::operator&=(mv const& other) noexcept
+mv& mv::operator&=(mv const& other)
 {
     mv result = *this & other;
     std::swap(terms, result.terms);
     return *this;
 }
 
-mv operator&(mv const& lhs, mv const& rhs) noexcept
+mv operator&(mv const& lhs, mv const& rhs)
 {
-    mv out{*lhs.algebra_};
-
-    for (auto&& [e1, p1] : lhs.terms)
-    {
-        for (auto&& [e2, p2] : rhs.terms)
-        {
-            int32_t result = lhs.algebra_->reg(e1, e2);
-            if (result != 0)
-            {
-                uint32_t e = std::abs(result) - 1;
-                auto it    = out.terms.find(e);
-
-                poly p12 = p1 * p2;
-
-                if (it == out.terms.end())
-                {
-                    it = out.terms.emplace(e, poly{}).first;
-                }
-
-                if (result < 0)
-                {
-                    it->second += -p12;
-                }
-                else
-                {
-                    it->second += p12;
-                }
-            }
-        }
-    }
-
-    return out.prune();
+    algebra const& a = *lhs.algebra_;
+    return mv::combine(
+        lhs, rhs, [&a](uint32_t e1, uint32_t e2) { return a.reg(e1, e2); });
 }
 
-mv& mv::operator|=(mv const& other) noexcept
+mv& mv::operator|=(mv const& other)
 {
     mv result = *this | other;
     std::swap(terms, result.terms);
     return *this;
 }
 
-mv operator|(mv const& lhs, mv const& rhs) noexcept
+mv operator|(mv const& lhs, mv const& rhs)
+{
+    algebra const& a = *lhs.algebra_;
+    return mv::combine(
+        lhs, rhs, [&a](uint32_t e1, uint32_t e2) { return a.dot(e1, e2); });
+}
+
+template <typename Op>
+mv mv::combine(mv const& lhs, mv const& rhs, Op op)
 {
     mv out{*lhs.algebra_};
 
@@ -447,27 +419,11 @@ mv operator|(mv const& lhs, mv const& rhs) noexcept
     {
         for (auto&& [e2, p2] : rhs.terms)
         {
-            int32_t result = lhs.algebra_->dot(e1, e2);
+            int32_t result = op(e1, e2);
             if (result != 0)
             {
                 uint32_t e = std::abs(result) - 1;
-                auto it    = out.terms.find(e);
-
-                poly p12 = p1 * p2;
-
-                if (it == out.terms.end())
-                {
-                    it = out.terms.emplace(e, poly{}).first;
-                }
-
-                if (result < 0)
-                {
-                    it->second += -p12;
-                }
-                else
-                {
-                    it->second += p12;
-                }
+                out.terms[e].add_product(p1, p2, result < 0 ? -1.f : 1.f);
             }
         }
     }
@@ -477,43 +433,37 @@ mv operator|(mv const& lhs, mv const& rhs) noexcept
 
 mv& mv::prune()
 {
-    // Remove empty terms
-    for (auto it = terms.begin(); it != terms.end();)
+    // Remove cancelled monomials, then empty terms
+    for (auto& [e, p] : terms)
     {
-        if (it->second.terms.empty())
-        {
-            it = terms.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
+        p.prune();
     }
+    terms.erase_if([](auto const& term) { return term.second.terms.empty(); });
     return *this;
 }
 
-std::ostream& operator<<(std::ostream& os,
-                         std::map<uint32_t, poly>::const_iterator const& it) noexcept
+namespace
+{
+void print(std::ostream& os, uint32_t e, poly const& p) noexcept
 {
-    os << it->second;
+    os << p;
 
-    if (it->first == 0)
+    if (e == 0)
     {
-        return os;
+        return;
     }
 
     os << " e";
 
     for (size_t i = 0; i != 9; ++i)
     {
-        if ((it->first & (1 << i)) > 0)
+        if ((e & (1 << i)) > 0)
         {
             os << i;
         }
     }
-
-    return os;
 }
+} // namespace
 
 std::ostream& operator<<(std::ostream& os, mv const& m) noexcept
 {
@@ -523,14 +473,22 @@ std::ostream& operator<<(std::ostream& os, mv const& m) noexcept
         return os;
     }
 
-    auto it = m.terms.cbegin();
-    os << it;
-    ++it;
+    std::vector<uint32_t> blades;
+    blades.reserve(m.terms.size());
+    for (auto&& [e, p] : m.terms)
+    {
+        blades.push_back(e);
+    }
+    std::sort(blades.begin(), blades.end(), elem_comp{});
 
-    for (; it != m.terms.cend(); ++it)
+    for (size_t i = 0; i != blades.size(); ++i)
     {
-        os << " + " << it;
+        if (i != 0)
+        {
+            os << " + ";
+        }
+        print(os, blades[i], m.terms.find(blades[i])->second);
     }
 
     return os;
-}
\ No newline at end of file
+}
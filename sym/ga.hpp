@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <iostream>
+#include <vector>
 
 uint32_t popcnt(uint32_t i);
 
@@ -43,11 +44,29 @@ public:
         return (1 << dim_) - 1;
     }
 
+    // Algebras up to this dimension precompute Cayley tables for mul, ext,
+    // reg, and dot so that each product of two basis blades is a single
+    // lookup. Larger algebras compute each product bit by bit.
+    static constexpr uint32_t max_table_dim = 8;
+
 private:
+    int32_t compute_mul(uint32_t lhs, uint32_t rhs) const noexcept;
+    int32_t compute_ext(uint32_t lhs, uint32_t rhs) const noexcept;
+    int32_t compute_reg(uint32_t lhs, uint32_t rhs) const noexcept;
+    int32_t compute_dot(uint32_t lhs, uint32_t rhs) const noexcept;
+
     uint32_t p_;
     uint32_t q_;
     uint32_t r_;
     uint32_t dim_;
+
+    // Indexed by (lhs << dim_) | rhs. Empty if dim_ > max_table_dim. The
+    // regressive product table is only populated for P(R*_{3, 0, 1}) since
+    // the dual map is specialized for it.
+    std::vector<int32_t> mul_table_;
+    std::vector<int32_t> ext_table_;
+    std::vector<int32_t> reg_table_;
+    std::vector<int32_t> dot_table_;
 };
 
 struct elem_comp
@@ -84,31 +103,37 @@ public:
     mv& operator~() && noexcept;
     mv& operator+=(mv const& other) noexcept;
     mv& operator-=(mv const& other) noexcept;
-    mv& operator*=(mv const& other) noexcept;
-    mv& operator^=(mv const& other) noexcept;
-    mv& operator&=(mv const& other) noexcept;
-    mv& operator|=(mv const& other) noexcept;
+    mv& operator*=(mv const& other);
+    mv& operator^=(mv const& other);
+    mv& operator&=(mv const& other);
+    mv& operator|=(mv const& other);
 
     mv& push(uint32_t e, poly const& p) noexcept;
 
-    // Map from basis blade to polynomial
-    std::map<uint32_t, poly, elem_comp> terms;
+    // Map from basis blade to polynomial. Iteration order is unspecified;
+    // blades are printed in the order given by elem_comp.
+    flat_map<uint32_t, poly> terms;
 
 private:
     // Remove terms that are exactly zero
     mv& prune();
 
+    // Accumulate the product of every pair of blades using the table lookup
+    // op(lhs_blade, rhs_blade) encoded as in algebra::mul
+    template <typename Op>
+    static mv combine(mv const& lhs, mv const& rhs, Op op);
+
     friend mv operator+(mv const& lhs, mv const& rhs) noexcept;
-    friend mv operator*(mv const& lhs, mv const& rhs) noexcept;
-    friend mv operator^(mv const& lhs, mv const& rhs) noexcept;
-    friend mv operator&(mv const& lhs, mv const& rhs) noexcept;
-    friend mv operator|(mv const& lhs, mv const& rhs) noexcept;
+    friend mv operator*(mv const& lhs, mv const& rhs);
+    friend mv operator^(mv const& lhs, mv const& rhs);
+    friend mv operator&(mv const& lhs, mv const& rhs);
+    friend mv operator|(mv const& lhs, mv const& rhs);
     algebra const* algebra_ = nullptr;
 };
 
 mv operator+(mv const& lhs, mv const& rhs) noexcept;
-mv operator*(mv const& lhs, mv const& rhs) noexcept;
-mv operator^(mv const& lhs, mv const& rhs) noexcept;
-mv operator&(mv const& lhs, mv const& rhs) noexcept;
-mv operator|(mv const& lhs, mv const& rhs) noexcept;
+mv operator*(mv const& lhs, mv const& rhs);
+mv operator^(mv const& lhs, mv const& rhs);
+mv operator&(mv const& lhs, mv const& rhs);
+mv operator|(mv const& lhs, mv const& rhs);
 std::ostream& operator<<(std::ostream& os, mv const& m) noexcept;
\ No newline at end of file
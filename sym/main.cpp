@@ -2,6 +2,19 @@
 #include "parser.hpp"
 #include "repl.hpp"
 
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+static int usage()
+{
+    std::cerr << "Usage: klein_shell [--script <file> [--jobs <count>]]\n";
+    return 1;
+}
+
 int main(int argc, char** argv)
 {
     // std::string test = "4e0 + (b + c) * e102";
@@ -10,7 +23,60 @@ int main(int argc, char** argv)
     // std::cout << tokenize(test, a);
     // mv mv1 = parse("(e23 + 2e012) * (2 - 3e01)", pga);
     // std::cout << mv1 << std::endl;
+    char const* script = nullptr;
+    uint32_t jobs      = std::thread::hardware_concurrency();
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--script") == 0 && i + 1 < argc)
+        {
+            script = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc)
+        {
+            // std::stoul skips leading whitespace and negates a leading
+            // minus sign, so require the count to start with a digit
+            std::string count = argv[++i];
+            if (count.empty() || count[0] < '0' || count[0] > '9')
+            {
+                return usage();
+            }
+            size_t pos = 0;
+            unsigned long value;
+            try
+            {
+                value = std::stoul(count, &pos);
+            }
+            catch (std::logic_error const&)
+            {
+                // std::invalid_argument or std::out_of_range
+                return usage();
+            }
+            if (pos != count.size() || value > UINT32_MAX)
+            {
+                return usage();
+            }
+            jobs = static_cast<uint32_t>(value);
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
     repl r;
-    r.run();
+    if (script)
+    {
+        std::ifstream file{script};
+        if (!file)
+        {
+            std::cerr << "Unable to open " << script << '\n';
+            return 1;
+        }
+        r.run_script(file, jobs);
+    }
+    else
+    {
+        r.run();
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 #include <cassert>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 #include <stdexcept>
 #include <vector>
 
@@ -199,18 +200,21 @@ std::vector<token> tokenize(std::string const& input, algebra const& algebra_)
             t.type = token_type::number;
             t.num  = tokenize_number(it, input.end());
         }
-        else if (it != input.end() - 1)
+        else if (c == 'e' && it != input.end() - 1 && std::isdigit(*(it + 1)))
         {
-            if (c == 'e' && std::isdigit(*(it + 1)))
-            {
-                t.type = token_type::element;
-                t.e    = tokenize_element(it, input.end(), algebra_);
-            }
-            else
-            {
-                t.type = token_type::identifier;
-                t.id   = tokenize_identifier(it, input.end());
-            }
+            t.type = token_type::element;
+            t.e    = tokenize_element(it, input.end(), algebra_);
+        }
+        else if (std::isalpha(c))
+        {
+            t.type = token_type::identifier;
+            t.id   = tokenize_identifier(it, input.end());
+        }
+        else
+        {
+            // Stop here rather than looping on a character that no token
+            // consumes, which would take down a whole batch of scripts
+            throw std::runtime_error(std::string{"Unexpected character "} + c);
         }
         out.emplace_back(t);
     }
@@ -221,6 +225,65 @@ std::vector<token> tokenize(std::string const& input, algebra const& algebra_)
     return out;
 }
 
+// Returns the closing delimiter matching an opening one just before it, or
+// end if it is missing
+static std::vector<token>::const_iterator
+find_close(std::vector<token>::const_iterator it,
+           std::vector<token>::const_iterator end)
+{
+    int depth = 1;
+    for (; it != end && it->type != token_type::eof; ++it)
+    {
+        if (it->type == token_type::delimiter)
+        {
+            depth += it->delimiter == '(' ? 1 : -1;
+            if (depth == 0)
+            {
+                return it;
+            }
+        }
+    }
+    return end;
+}
+
+// Spells out a token range so that identical subexpressions get the same key
+// regardless of whitespace
+static std::string cache_key(std::vector<token>::const_iterator it,
+                             std::vector<token>::const_iterator end)
+{
+    std::string out;
+    for (; it != end && it->type != token_type::eof; ++it)
+    {
+        switch (it->type)
+        {
+        case token_type::element:
+            out += it->e.negative ? "-e" : "e";
+            out += std::to_string(it->e.value);
+            break;
+        case token_type::number:
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &it->num, sizeof(bits));
+            out += '#' + std::to_string(bits);
+            break;
+        }
+        case token_type::identifier:
+            out.append(it->id.data, it->id.size);
+            break;
+        case token_type::delimiter:
+            out += it->delimiter;
+            break;
+        case token_type::op:
+            out += it->op;
+            break;
+        default:
+            break;
+        }
+        out += ' ';
+    }
+    return out;
+}
+
 // Parsing Grammar
 //
 // An expr is a sum or difference of terms
@@ -236,11 +299,13 @@ std::vector<token> tokenize(std::string const& input, algebra const& algebra_)
 
 static mv parse_expr(std::vector<token>::const_iterator& it,
                      std::vector<token>::const_iterator end,
-                     algebra const& a);
+                     algebra const& a,
+                     mv_cache* cache);
 
 static mv parse_factor(std::vector<token>::const_iterator& it,
                        std::vector<token>::const_iterator end,
-                       algebra const& a)
+                       algebra const& a,
+                       mv_cache* cache)
 {
     bool negate  = false;
     bool reverse = false;
@@ -316,7 +381,30 @@ static mv parse_factor(std::vector<token>::const_iterator& it,
     else if (it->type == token_type::delimiter && it->delimiter == '(')
     {
         ++it;
-        mv result = parse_expr(it, end, a);
+        std::string key;
+        std::vector<token>::const_iterator close = end;
+        std::shared_ptr<mv const> cached;
+        if (cache && (close = find_close(it, end)) != end)
+        {
+            key    = cache_key(it, close);
+            cached = cache->find(key);
+        }
+
+        mv result;
+        if (cached)
+        {
+            result = *cached;
+            it     = close;
+        }
+        else
+        {
+            result = parse_expr(it, end, a, cache);
+            if (cache && !key.empty())
+            {
+                cache->insert(key, result);
+            }
+        }
+
         if (it->type == token_type::delimiter && it->delimiter == ')')
         {
             ++it;
@@ -345,61 +433,66 @@ static mv parse_factor(std::vector<token>::const_iterator& it,
 
 static mv parse_dot_factor(std::vector<token>::const_iterator& it,
                            std::vector<token>::const_iterator end,
-                           algebra const& a)
+                           algebra const& a,
+                           mv_cache* cache)
 {
-    mv out = parse_factor(it, end, a);
+    mv out = parse_factor(it, end, a, cache);
     while (it != end && it->type == token_type::op && it->op == '|')
     {
         ++it;
-        out |= parse_factor(it, end, a);
+        out |= parse_factor(it, end, a, cache);
     }
     return out;
 }
 
 static mv parse_reg_factor(std::vector<token>::const_iterator& it,
                            std::vector<token>::const_iterator end,
-                           algebra const& a)
+                           algebra const& a,
+                           mv_cache* cache)
 {
-    mv out = parse_dot_factor(it, end, a);
+    mv out = parse_dot_factor(it, end, a, cache);
     while (it != end && it->type == token_type::op && it->op == '&')
     {
         ++it;
-        out &= parse_dot_factor(it, end, a);
+        out &= parse_dot_factor(it, end, a, cache);
     }
     return out;
 }
 
 static mv parse_ext_factor(std::vector<token>::const_iterator& it,
                            std::vector<token>::const_iterator end,
-                           algebra const& a)
+                           algebra const& a,
+                           mv_cache* cache)
 {
-    mv out = parse_reg_factor(it, end, a);
+    mv out = parse_reg_factor(it, end, a, cache);
     while (it != end && it->type == token_type::op && it->op == '^')
     {
         ++it;
-        out ^= parse_reg_factor(it, end, a);
+        out ^= parse_reg_factor(it, end, a, cache);
     }
     return out;
 }
 
 static mv parse_term(std::vector<token>::const_iterator& it,
                      std::vector<token>::const_iterator end,
-                     algebra const& a)
+                     algebra const& a,
+                     mv_cache* cache)
 {
-    mv out = parse_ext_factor(it, end, a);
+    mv out = parse_ext_factor(it, end, a, cache);
     while (it != end && it->type == token_type::op && it->op == '*')
     {
         ++it;
-        out *= parse_ext_factor(it, end, a);
+        out *= parse_ext_factor(it, end, a, cache);
     }
     return out;
 }
 
 static mv parse_expr(std::vector<token>::const_iterator& it,
                      std::vector<token>::const_iterator end,
-                     algebra const& a)
+                     algebra const& a,
+                     mv_cache* cache)
 {
-    mv out = parse_term(it, end, a);
+    mv out = parse_term(it, end, a, cache);
 
     while (it != end && it->type != token_type::eof)
     {
@@ -408,12 +501,12 @@ static mv parse_expr(std::vector<token>::const_iterator& it,
             if (it->op == '+')
             {
                 ++it;
-                out += parse_term(it, end, a);
+                out += parse_term(it, end, a, cache);
             }
             else if (it->op == '-')
             {
                 ++it;
-                out -= parse_term(it, end, a);
+                out -= parse_term(it, end, a, cache);
             }
             else
             {
@@ -434,10 +527,45 @@ static mv parse_expr(std::vector<token>::const_iterator& it,
     return out;
 }
 
-mv parse(std::string const& input, algebra const& algebra_)
+mv parse(std::string const& input, algebra const& algebra_, mv_cache* cache)
 {
     std::vector<token> tokens = tokenize(input, algebra_);
 
+    std::string key;
+    if (cache)
+    {
+        key = cache_key(tokens.cbegin(), tokens.cend());
+        if (auto cached = cache->find(key))
+        {
+            return *cached;
+        }
+    }
+
     auto it = tokens.cbegin();
-    return parse_expr(it, tokens.cend(), algebra_);
+    mv out  = parse_expr(it, tokens.cend(), algebra_, cache);
+    if (cache)
+    {
+        cache->insert(key, out);
+    }
+    return out;
+}
+
+std::shared_ptr<mv const> mv_cache::find(std::string const& key) const
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : it->second;
+}
+
+void mv_cache::insert(std::string const& key, mv const& value)
+{
+    auto entry = std::make_shared<mv const>(value);
+    std::lock_guard<std::mutex> lock{mutex_};
+    entries_.emplace(key, std::move(entry));
+}
+
+size_t mv_cache::size() const
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    return entries_.size();
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "ga.hpp"
 
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 enum class token_type
@@ -48,4 +52,22 @@ std::ostream& operator<<(std::ostream& os, std::vector<token> const& tokens);
 
 std::vector<token> tokenize(std::string const& input, algebra const& algebra_);
 
-mv parse(std::string const& input, algebra const& a);
+// Thread-safe memo of evaluated expressions, keyed on their tokens. Identical
+// parenthesized subexpressions (and whole inputs) share a single stored
+// multivector, so a subexpression repeated across many inputs is only
+// evaluated once. A cache must only be used with a single algebra.
+class mv_cache
+{
+public:
+    std::shared_ptr<mv const> find(std::string const& key) const;
+    void insert(std::string const& key, mv const& value);
+    size_t size() const;
+
+private:
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<mv const>> entries_;
+};
+
+mv parse(std::string const& input,
+         algebra const& a,
+         mv_cache* cache = nullptr);
@@ -1,101 +1,91 @@
 #include "poly.hpp"
 
-mon& mon::push(std::string var, int deg) noexcept
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace
 {
-    if (deg == 0)
-    {
-        return *this;
-    }
+var_table& default_table()
+{
+    static var_table out;
+    return out;
+}
 
-    auto it = factors.find(var);
-    if (it == factors.end())
-    {
-        factors.emplace(var, deg);
-    }
-    else
-    {
-        if (it->second + deg == 0)
-        {
-            factors.erase(it);
-        }
-        else
-        {
-            it->second += deg;
-        }
-    }
+thread_local var_table* current_table = nullptr;
 
-    return *this;
+var_table& current()
+{
+    return current_table ? *current_table : default_table();
 }
 
-int mon::degree() const noexcept
+[[noreturn]] void exponent_overflow()
 {
-    int out = 0;
-    for (auto&& [v, d] : factors)
-    {
-        out += d;
-    }
-    return out;
+    throw std::runtime_error(
+        "Exponent out of range (maximum magnitude is "
+        + std::to_string(std::numeric_limits<int16_t>::max()) + ")");
 }
 
-bool operator==(mon const& lhs, mon const& rhs) noexcept
+int16_t checked_exponent(int deg)
 {
-    if (lhs.factors.size() != rhs.factors.size())
+    if (deg < std::numeric_limits<int16_t>::min()
+        || deg > std::numeric_limits<int16_t>::max())
     {
-        return false;
+        exponent_overflow();
     }
+    return static_cast<int16_t>(deg);
+}
 
-    auto lhs_it = lhs.factors.begin();
-    auto rhs_it = rhs.factors.begin();
+// (name, degree) pairs of a monomial sorted by name
+using factor_list = std::vector<std::pair<std::string const*, int>>;
 
-    while (lhs_it != lhs.factors.end() && rhs_it != rhs.factors.end())
+factor_list sorted_factors(mon const& m)
+{
+    factor_list out;
+    for (uint32_t i = 0; i != m.size(); ++i)
     {
-        if (lhs_it->first != rhs_it->first)
+        int deg = m.exponent(i);
+        if (deg != 0)
         {
-            return false;
+            out.emplace_back(&var_name(i), deg);
         }
-
-        if (lhs_it->second != rhs_it->second)
-        {
-            return false;
-        }
-        ++lhs_it;
-        ++rhs_it;
     }
-    return true;
+    std::sort(out.begin(), out.end(), [](auto const& lhs, auto const& rhs) {
+        return *lhs.first < *rhs.first;
+    });
+    return out;
 }
 
-// Graded lexical comparison (grlex)
-bool operator<(mon const& lhs, mon const& rhs) noexcept
+// Graded lexical comparison (grlex) of two sorted factor lists
+bool grlex_less(int lhs_d,
+                factor_list const& lhs,
+                int rhs_d,
+                factor_list const& rhs) noexcept
 {
-    int lhs_d = lhs.degree();
-    int rhs_d = rhs.degree();
-    if (lhs_d < rhs_d)
-    {
-        return true;
-    }
-    else if (lhs_d > rhs_d)
+    if (lhs_d != rhs_d)
     {
-        return false;
+        return lhs_d < rhs_d;
     }
 
-    auto lhs_it = lhs.factors.begin();
-    auto rhs_it = rhs.factors.begin();
+    auto lhs_it = lhs.begin();
+    auto rhs_it = rhs.begin();
 
-    while (lhs_it != lhs.factors.end() || rhs_it != rhs.factors.end())
+    while (lhs_it != lhs.end() || rhs_it != rhs.end())
     {
-        if (lhs_it == lhs.factors.end())
+        if (lhs_it == lhs.end())
         {
             return true;
         }
-        else if (rhs_it == rhs.factors.end())
+        else if (rhs_it == rhs.end())
         {
             return false;
         }
-        else if (lhs_it->first < rhs_it->first)
+        else if (*lhs_it->first < *rhs_it->first)
         {
             return true;
         }
-        else if (rhs_it->first < lhs_it->first)
+        else if (*rhs_it->first < *lhs_it->first)
         {
             return false;
         }
@@ -111,37 +101,190 @@ bool operator<(mon const& lhs, mon const& rhs) noexcept
         ++rhs_it;
     }
 
-    // Unreachable
     return false;
 }
+} // namespace
+
+uint32_t var_table::intern(std::string const& var)
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    auto it = ids_.find(var);
+    if (it != ids_.end())
+    {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(names_.size());
+    names_.push_back(var);
+    ids_.emplace(var, id);
+    return id;
+}
+
+int32_t var_table::find(std::string const& var) const noexcept
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+
+    auto it = ids_.find(var);
+    return it == ids_.end() ? -1 : static_cast<int32_t>(it->second);
+}
+
+std::string const& var_table::name(uint32_t id) const noexcept
+{
+    std::lock_guard<std::mutex> lock{mutex_};
+    return names_[id];
+}
+
+var_scope::var_scope(var_table& table) noexcept
+    : previous_{current_table}
+{
+    current_table = &table;
+}
+
+var_scope::~var_scope()
+{
+    current_table = previous_;
+}
+
+uint32_t intern(std::string const& var)
+{
+    return current().intern(var);
+}
+
+int32_t find_var(std::string const& var) noexcept
+{
+    return current().find(var);
+}
+
+std::string const& var_name(uint32_t id) noexcept
+{
+    return current().name(id);
+}
+
+mon& mon::push(std::string const& var, int deg)
+{
+    return push(intern(var), deg);
+}
+
+mon& mon::push(uint32_t var, int deg)
+{
+    if (var < inline_vars)
+    {
+        exponents_[var] = checked_exponent(exponents_[var] + deg);
+        return *this;
+    }
+
+    size_t i = var - inline_vars;
+    if (i >= spill_.size())
+    {
+        spill_.resize(i + 1);
+    }
+    spill_[i] = checked_exponent(spill_[i] + deg);
+    while (!spill_.empty() && spill_.back() == 0)
+    {
+        spill_.pop_back();
+    }
+    return *this;
+}
+
+int mon::degree() const noexcept
+{
+    int out = 0;
+    for (int16_t d : exponents_)
+    {
+        out += d;
+    }
+    for (int16_t d : spill_)
+    {
+        out += d;
+    }
+    return out;
+}
 
-mon& mon::operator*=(mon const& other) noexcept
+int mon::exponent(uint32_t var) const noexcept
 {
-    for (auto&& [v, d] : other.factors)
+    if (var < inline_vars)
     {
-        auto it = factors.find(v);
+        return exponents_[var];
+    }
+    size_t i = var - inline_vars;
+    return i < spill_.size() ? spill_[i] : 0;
+}
+
+int mon::exponent(std::string const& var) const noexcept
+{
+    int32_t id = find_var(var);
+    return id < 0 ? 0 : exponent(static_cast<uint32_t>(id));
+}
+
+size_t mon::hash() const noexcept
+{
+    uint64_t words[sizeof(exponents_) / 8];
+    std::memcpy(words, exponents_.data(), sizeof(words));
 
-        if (it == factors.end())
+    uint64_t out = 0;
+    for (uint64_t w : words)
+    {
+        out = (out ^ w) * 0x9e3779b97f4a7c15ull;
+        out ^= out >> 29;
+    }
+    for (int16_t d : spill_)
+    {
+        out = (out ^ static_cast<uint16_t>(d)) * 0x9e3779b97f4a7c15ull;
+        out ^= out >> 29;
+    }
+    return static_cast<size_t>(out);
+}
+
+bool operator==(mon const& lhs, mon const& rhs) noexcept
+{
+    return lhs.exponents_ == rhs.exponents_ && lhs.spill_ == rhs.spill_;
+}
+
+bool operator<(mon const& lhs, mon const& rhs) noexcept
+{
+    return grlex_less(
+        lhs.degree(), sorted_factors(lhs), rhs.degree(), sorted_factors(rhs));
+}
+
+mon& mon::operator*=(mon const& other)
+{
+    // Sum in a wider type and check for overflow once at the end, keeping
+    // the common case a straight-line loop
+    bool overflow = false;
+    for (size_t i = 0; i != inline_vars; ++i)
+    {
+        int deg       = exponents_[i] + other.exponents_[i];
+        exponents_[i] = static_cast<int16_t>(deg);
+        overflow |= exponents_[i] != deg;
+    }
+
+    if (!other.spill_.empty())
+    {
+        if (spill_.size() < other.spill_.size())
         {
-            factors.emplace(v, d);
+            spill_.resize(other.spill_.size());
         }
-        else
+        for (size_t i = 0; i != other.spill_.size(); ++i)
         {
-            if (it->second + d == 0)
-            {
-                factors.erase(it);
-            }
-            else
-            {
-                it->second += d;
-            }
+            int deg   = spill_[i] + other.spill_[i];
+            spill_[i] = static_cast<int16_t>(deg);
+            overflow |= spill_[i] != deg;
+        }
+        while (!spill_.empty() && spill_.back() == 0)
+        {
+            spill_.pop_back();
         }
     }
 
+    if (overflow)
+    {
+        exponent_overflow();
+    }
     return *this;
 }
 
-mon operator*(mon const& lhs, mon const& rhs) noexcept
+mon operator*(mon const& lhs, mon const& rhs)
 {
     mon out = lhs;
     out *= rhs;
@@ -150,12 +293,8 @@ mon operator*(mon const& lhs, mon const& rhs) noexcept
 
 poly& poly::push(mon const& m, float f) noexcept
 {
-    auto it = terms.find(m);
-    if (it == terms.end())
-    {
-        terms.emplace(m, f);
-    }
-    else
+    auto [it, inserted] = terms.emplace(m, f);
+    if (!inserted)
     {
         if (it->second + f == 0.f)
         {
@@ -194,22 +333,7 @@ poly& poly::operator+=(poly const& other) noexcept
 {
     for (auto&& [m, f] : other.terms)
     {
-        auto it = terms.find(m);
-        if (it == terms.end())
-        {
-            terms.emplace(m, f);
-        }
-        else
-        {
-            if (it->second + f == 0.f)
-            {
-                terms.erase(it);
-            }
-            else
-            {
-                it->second += f;
-            }
-        }
+        push(m, f);
     }
     return *this;
 }
@@ -221,79 +345,79 @@ poly operator+(poly const& lhs, poly const& rhs) noexcept
     return out;
 }
 
-poly operator*(poly const& lhs, poly const& rhs) noexcept
+poly& poly::add_product(poly const& lhs, poly const& rhs, float scale)
 {
-    poly out;
-
     for (auto&& [m1, f1] : lhs.terms)
     {
-        poly t;
-
         for (auto&& [m2, f2] : rhs.terms)
         {
-            if (f1 * f2 != 0.f)
+            float f = scale * f1 * f2;
+            if (f != 0.f)
             {
-                auto m = m1 * m2;
-                t.terms[m] += f1 * f2;
+                terms[m1 * m2] += f;
             }
         }
-
-        out += t;
     }
+    return *this;
+}
 
-    return out;
+poly& poly::prune() noexcept
+{
+    terms.erase_if([](auto const& term) { return term.second == 0.f; });
+    return *this;
 }
 
-poly& poly::operator*=(poly const& other) noexcept
+poly operator*(poly const& lhs, poly const& rhs)
+{
+    poly out;
+    out.add_product(lhs, rhs, 1.f);
+    return out.prune();
+}
+
+poly& poly::operator*=(poly const& other)
 {
     poly temp = *this * other;
     std::swap(terms, temp.terms);
     return *this;
 }
 
-std::ostream&
-operator<<(std::ostream& os,
-           std::map<std::string, int>::const_iterator const& it) noexcept
+namespace
+{
+void print(std::ostream& os, factor_list const& factors)
 {
-    if (it->second == 0)
+    for (size_t i = 0; i != factors.size(); ++i)
     {
-        return os;
-    }
+        if (i != 0)
+        {
+            os << ' ';
+        }
 
-    os << it->first;
-    if (it->second != 1)
-    {
-        os << '^' << it->second;
+        os << *factors[i].first;
+        if (factors[i].second != 1)
+        {
+            os << '^' << factors[i].second;
+        }
     }
-    return os;
 }
 
-std::ostream& operator<<(std::ostream& os,
-                         std::map<mon, float>::const_iterator const& it) noexcept
+void print(std::ostream& os, float f, factor_list const& factors)
 {
-    if (it->second == -1.f)
+    if (f == -1.f)
     {
         os << '-';
     }
-    else if (it->second != 1.f)
+    else if (f != 1.f)
     {
-        os << it->second;
+        os << f;
     }
 
-    if (it->first.factors.empty())
-    {
-        return os;
-    }
-
-    auto factor = it->first.factors.cbegin();
-    os << factor;
-    ++factor;
-
-    for (; factor != it->first.factors.cend(); ++factor)
-    {
-        os << ' ' << factor;
-    }
+    print(os, factors);
+}
+} // namespace
 
+std::ostream& operator<<(std::ostream& os, mon const& m) noexcept
+{
+    print(os, sorted_factors(m));
     return os;
 }
 
@@ -304,20 +428,37 @@ std::ostream& operator<<(std::ostream& os, poly const& p) noexcept
         return os;
     }
 
-    bool multi = p.terms.size() > 1;
+    // Sort once on precomputed keys rather than through operator<
+    struct key
+    {
+        int degree;
+        factor_list factors;
+        float f;
+    };
+    std::vector<key> keys;
+    keys.reserve(p.terms.size());
+    for (auto&& [m, f] : p.terms)
+    {
+        keys.push_back({m.degree(), sorted_factors(m), f});
+    }
+    std::sort(keys.begin(), keys.end(), [](key const& lhs, key const& rhs) {
+        return grlex_less(lhs.degree, lhs.factors, rhs.degree, rhs.factors);
+    });
+
+    bool multi = keys.size() > 1;
 
     if (multi)
     {
         os << '(';
     }
 
-    auto it = p.terms.cbegin();
-    os << it;
-    ++it;
-
-    for (; it != p.terms.cend(); ++it)
+    for (size_t i = 0; i != keys.size(); ++i)
     {
-        os << " + " << it;
+        if (i != 0)
+        {
+            os << " + ";
+        }
+        print(os, keys[i].f, keys[i].factors);
     }
 
     if (multi)
@@ -1,24 +1,102 @@
 #pragma once
 
+#include "flat_map.hpp"
+
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <iostream>
-#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Names of the variables used in a session, interned to small integer ids in
+// order of first appearance. Monomials index their exponents by these ids, so
+// a table must outlive every polynomial built while it is current.
+class var_table
+{
+public:
+    // Returns the id of the named variable, assigning a new one if needed
+    uint32_t intern(std::string const& var);
+
+    // Returns the id of the named variable, or -1 if it was never interned
+    int32_t find(std::string const& var) const noexcept;
+
+    // Returns the name of an interned variable
+    std::string const& name(uint32_t id) const noexcept;
+
+private:
+    mutable std::mutex mutex_;
+    // A deque keeps references returned by name stable
+    std::deque<std::string> names_;
+    std::unordered_map<std::string, uint32_t> ids_;
+};
+
+// Makes a table current on the calling thread until the scope ends. Threads
+// without a current table share a process-wide default one.
+class var_scope
+{
+public:
+    explicit var_scope(var_table& table) noexcept;
+    ~var_scope();
+
+    var_scope(var_scope const&) = delete;
+    var_scope& operator=(var_scope const&) = delete;
+
+private:
+    var_table* previous_;
+};
+
+// Equivalent to the var_table members on the current table
+uint32_t intern(std::string const& var);
+int32_t find_var(std::string const& var) noexcept;
+std::string const& var_name(uint32_t id) noexcept;
 
 class mon
 {
 public:
-    // Map from variable to degree
-    // A map is used here so that traversal order is deterministic
-    std::map<std::string, int> factors;
+    // Number of variables whose exponents are stored inline
+    static constexpr size_t inline_vars = 32;
 
-    mon& operator*=(mon const& other) noexcept;
+    mon& operator*=(mon const& other);
 
     // Multiply the monomial by a named variable with degree
-    mon& push(std::string var, int deg = 1) noexcept;
+    mon& push(std::string const& var, int deg = 1);
+
+    // Multiply the monomial by an interned variable with degree. Throws
+    // std::runtime_error if the resulting exponent is out of range.
+    mon& push(uint32_t var, int deg = 1);
 
     int degree() const noexcept;
+
+    // Ids below this bound may have a nonzero exponent
+    size_t size() const noexcept
+    {
+        return inline_vars + spill_.size();
+    }
+
+    // Degree of the interned variable in this monomial
+    int exponent(uint32_t var) const noexcept;
+
+    // Degree of the named variable in this monomial
+    int exponent(std::string const& var) const noexcept;
+
+    size_t hash() const noexcept;
+
+private:
+    // Exponents are indexed by interned id. The first ids are packed into a
+    // fixed block so that multiplying, comparing, and hashing monomials over
+    // few variables are straight-line loops over 64 bytes. Later ids spill
+    // to the heap, with trailing zeros trimmed so that equal monomials have
+    // equal storage.
+    std::array<int16_t, inline_vars> exponents_{};
+    std::vector<int16_t> spill_;
+
+    friend bool operator==(mon const& lhs, mon const& rhs) noexcept;
 };
 
-mon operator*(mon const& lhs, mon const& rhs) noexcept;
+mon operator*(mon const& lhs, mon const& rhs);
 
 namespace std
 {
@@ -27,43 +105,41 @@ struct hash<mon>
 {
     size_t operator()(mon const& in) const noexcept
     {
-        size_t out = 0;
-        size_t k;
-        if constexpr (sizeof(void*) == 8)
-        {
-            k = 0x517cc1b727220a95;
-        }
-        else
-        {
-            k = 0x9e3779b9;
-        }
-
-        for (auto&& [var, deg] : in.factors)
-        {
-            out ^= std::hash<std::string>{}(var) + k + (out >> 2) + (out << 6);
-            out ^= std::hash<int>{}(deg) + k + (out >> 2) + (out << 6);
-        }
-        return out;
+        return in.hash();
     }
 };
 } // namespace std
 
 bool operator==(mon const& lhs, mon const& rhs) noexcept;
+
+// Graded lexical order over variable names (not ids), so that printing is
+// independent of the order in which variables were interned
 bool operator<(mon const& lhs, mon const& rhs) noexcept;
 
 class poly
 {
 public:
-    // Map from monomial to scalar coefficient
-    std::map<mon, float> terms;
+    // Map from monomial to scalar coefficient. Iteration order is
+    // unspecified; terms are printed in graded lexical order.
+    flat_map<mon, float> terms;
 
     poly& push(mon const& m, float f = 1.f) noexcept;
     poly& operator+=(poly const& other) noexcept;
-    poly& operator*=(poly const& other) noexcept;
+    poly& operator*=(poly const& other);
+
+    // Accumulate scale * lhs * rhs without forming the product separately.
+    // Terms that cancel are left in place with a zero coefficient until
+    // prune() is called, so that repeated accumulation stays cheap.
+    poly& add_product(poly const& lhs, poly const& rhs, float scale);
+
+    // Remove terms with a zero coefficient
+    poly& prune() noexcept;
+
     poly operator-() const& noexcept;
     poly& operator-() && noexcept;
 };
 
 poly operator+(poly const& lhs, poly const& rhs) noexcept;
-poly operator*(poly const& lhs, poly const& rhs) noexcept;
-std::ostream& operator<<(std::ostream& os, poly const& p) noexcept;
\ No newline at end of file
+poly operator*(poly const& lhs, poly const& rhs);
+std::ostream& operator<<(std::ostream& os, mon const& m) noexcept;
+std::ostream& operator<<(std::ostream& os, poly const& p) noexcept;
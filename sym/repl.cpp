@@ -1,9 +1,15 @@
 #include "repl.hpp"
 
+#include "codegen.hpp"
 #include "parser.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 enum codes
 {
@@ -11,69 +17,197 @@ enum codes
     key_down = 80,
 };
 
-void repl::run()
+namespace
 {
-    // Allow specification of algebra
-    algebra a{3, 0, 1};
-    for (std::string line; std::getline(std::cin, line);)
+// .codegen <target> <name> <partitions> = <expression>
+//
+// Evaluates the expression and prints a kernel named <name> that computes it
+// for the given comma-separated output partitions (e.g. p1,p2).
+void codegen(std::string const& line,
+             algebra const& a,
+             mv_cache* cache,
+             std::ostream& out)
+{
+    size_t eq = line.find('=');
+    if (eq == std::string::npos)
     {
-        if (line.empty())
+        throw std::runtime_error(
+            "Usage: .codegen <target> <name> <partitions> = <expression>");
+    }
+
+    std::istringstream args{line.substr(0, eq)};
+    std::string command, target, name, outputs;
+    args >> command >> target >> name >> outputs;
+    if (outputs.empty())
+    {
+        throw std::runtime_error(
+            "Usage: .codegen <target> <name> <partitions> = <expression>");
+    }
+
+    std::vector<uint32_t> partitions;
+    std::istringstream list{outputs};
+    for (std::string p; std::getline(list, p, ',');)
+    {
+        if (p.size() != 2 || p[0] != 'p' || p[1] < '0' || p[1] > '3')
+        {
+            throw std::runtime_error("Unknown partition " + p);
+        }
+        partitions.push_back(static_cast<uint32_t>(p[1] - '0'));
+    }
+
+    std::string expression = line.substr(eq + 1);
+    kernel k{parse(expression, a, cache), partitions, parse_target(target)};
+    out << "//" << expression << '\n';
+    k.emit(out, name);
+}
+
+// Evaluates a line other than .break, writing results to out and errors to
+// err. Lines are independent of each other, so any number of them may be
+// evaluated concurrently with a shared cache.
+void evaluate(std::string const& line,
+              algebra const& a,
+              mv_cache* cache,
+              std::ostream& out,
+              std::ostream& err)
+{
+    if (line.empty())
+    {
+        out << std::endl;
+        return;
+    }
+
+    // Skip lines that only contain whitespace or commas
+    bool should_parse  = false;
+    bool issue_command = false;
+    for (auto c : line)
+    {
+        if (std::isspace(c))
         {
-            std::cout << std::endl;
             continue;
         }
+        else if (c == '#')
+        {
+            // Lines that begin with a # are comments
+            // Echo them in the output
+            out << line;
+            break;
+        }
+        else if (c == '.')
+        {
+            // Lines that start with a . are commands
+            issue_command = true;
+            break;
+        }
+        else
+        {
+            should_parse = true;
+        }
+    }
 
-        // Skip lines that only contain whitespace or commas
-        bool should_parse  = false;
-        bool issue_command = false;
-        for (auto c : line)
+    if (issue_command)
+    {
+        // TODO replace with an actual command parser
+        if (line.compare(0, 8, ".codegen") == 0)
         {
-            if (std::isspace(c))
-            {
-                continue;
-            }
-            else if (c == '#')
-            {
-                // Lines that begin with a # are comments
-                // Echo them in the output
-                std::cout << line;
-                break;
-            }
-            else if (c == '.')
+            try
             {
-                // Lines that start with a . are commands
-                issue_command = true;
-                break;
+                codegen(line, a, cache, out);
             }
-            else
+            catch (const std::runtime_error& e)
             {
-                should_parse = true;
+                err << e.what() << '\n';
             }
         }
+        return;
+    }
+    else if (!should_parse)
+    {
+        out << std::endl;
+        return;
+    }
+
+    try
+    {
+        mv result = parse(line, a, cache);
+        out << result << std::endl;
+    }
+    catch (const std::runtime_error& e)
+    {
+        err << e.what() << '\n';
+    }
+}
+} // namespace
 
-        if (issue_command)
+void repl::run()
+{
+    // Allow specification of algebra
+    algebra a{3, 0, 1};
+    var_table vars;
+    var_scope scope{vars};
+    mv_cache cache;
+    for (std::string line; std::getline(std::cin, line);)
+    {
+        if (line == ".break")
         {
-            // TODO replace with an actual command parser
-            if (line == ".break")
-            {
-                break_lines = !break_lines;
-            }
+            break_lines = !break_lines;
             continue;
         }
-        else if (!should_parse)
+        evaluate(line, a, &cache, std::cout, std::cerr);
+    }
+}
+
+void repl::run_script(std::istream& script, uint32_t jobs)
+{
+    algebra a{3, 0, 1};
+    var_table vars;
+    var_scope scope{vars};
+    mv_cache cache;
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(script, line);)
+    {
+        if (line == ".break")
         {
-            std::cout << std::endl;
+            break_lines = !break_lines;
             continue;
         }
+        lines.push_back(std::move(line));
+    }
 
-        try
-        {
-            mv result = parse(line, a);
-            std::cout << result << std::endl;
-        }
-        catch (const std::runtime_error& e)
+    // Workers claim lines in order and buffer the output of each one so that
+    // it can be printed in the original order
+    std::vector<std::string> out(lines.size());
+    std::vector<std::string> err(lines.size());
+    std::atomic<size_t> next{0};
+    auto work = [&] {
+        var_scope worker_scope{vars};
+        for (size_t i = next++; i < lines.size(); i = next++)
         {
-            std::cerr << e.what() << '\n';
+            std::ostringstream out_stream;
+            std::ostringstream err_stream;
+            evaluate(lines[i], a, &cache, out_stream, err_stream);
+            out[i] = out_stream.str();
+            err[i] = err_stream.str();
         }
+    };
+
+    jobs = std::max(
+        1u, static_cast<uint32_t>(std::min<size_t>(jobs, lines.size())));
+    std::vector<std::thread> workers;
+    for (uint32_t i = 1; i < jobs; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& t : workers)
+    {
+        t.join();
+    }
+
+    for (size_t i = 0; i != lines.size(); ++i)
+    {
+        std::cout << out[i];
+        std::cerr << err[i];
     }
-}
\ No newline at end of file
+    std::cout.flush();
+}
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <cstdint>
+#include <iostream>
+
 class repl
 {
 public:
+    // Evaluate lines from stdin one at a time
     void run();
 
+    // Read a whole script up front and evaluate its lines on the given number
+    // of threads. Parenthesized subexpressions repeated across lines are
+    // evaluated once. Output is printed in the original line order.
+    void run_script(std::istream& script, uint32_t jobs);
+
 private:
     bool break_lines = false;
 };
\ No newline at end of file
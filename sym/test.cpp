@@ -1,6 +1,7 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
+#include "codegen.hpp"
 #include "ga.hpp"
 #include "parser.hpp"
 #include "poly.hpp"
@@ -18,8 +19,54 @@ TEST_CASE("monomial-product")
     // ab
     mon m3 = m1 * m2;
 
-    CHECK_EQ(m3.factors["a"], 1);
-    CHECK_EQ(m3.factors["b"], 1);
+    CHECK_EQ(m3.exponent("a"), 1);
+    CHECK_EQ(m3.exponent("b"), 1);
+}
+
+TEST_CASE("monomial-storage")
+{
+    var_table vars;
+    var_scope scope{vars};
+
+    // Variables past the inline block spill to the heap
+    mon m1;
+    mon m2;
+    for (int i = 0; i != 70; ++i)
+    {
+        m1.push("x" + std::to_string(i));
+        m2.push("x" + std::to_string(69 - i));
+    }
+    CHECK_EQ(m1.degree(), 70);
+    CHECK(m1 == m2);
+    CHECK_EQ(std::hash<mon>{}(m1), std::hash<mon>{}(m2));
+
+    // Cancelling the spilled variables leaves the inline ones
+    mon m3 = m1;
+    for (size_t i = mon::inline_vars; i != 70; ++i)
+    {
+        m3.push("x" + std::to_string(i), -1);
+    }
+    mon m4;
+    for (size_t i = 0; i != mon::inline_vars; ++i)
+    {
+        m4.push("x" + std::to_string(i));
+    }
+    CHECK(m3 == m4);
+
+    mon a;
+    a.push("a", 130);
+    CHECK_EQ((a * a).exponent("a"), 260);
+
+    bool threw = false;
+    try
+    {
+        a.push("a", 32767);
+    }
+    catch (std::runtime_error const&)
+    {
+        threw = true;
+    }
+    CHECK(threw);
 }
 
 TEST_CASE("polynomial")
@@ -77,6 +124,20 @@ TEST_CASE("polynomial")
         CHECK_EQ(p3.terms.find(a2)->second, 1.f);
         CHECK_EQ(p3.terms.find(b2)->second, -1.f);
     }
+
+    SUBCASE("cancellation")
+    {
+        // (a + b)(a - b) - a^2 + b^2 leaves nothing behind
+        poly p3 = p1 * p2;
+        p3.push(a2, -1.f);
+        p3.push(b2, 1.f);
+        CHECK(p3.terms.empty());
+
+        // Erased terms can be inserted again
+        p3 += p1;
+        CHECK_EQ(p3.terms.size(), 2);
+        CHECK_EQ(p3.terms.find(b)->second, 1.f);
+    }
 }
 
 TEST_CASE("ga")
@@ -225,4 +286,90 @@ TEST_CASE("parser")
         CHECK_EQ(mv1.terms[0b100].terms.begin()->second, 37.f);
         CHECK_EQ(mv1.terms[0b1000].terms.begin()->second, 376.f);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("parse-cache")
+{
+    algebra pga{3, 0, 1};
+    mv_cache cache;
+
+    mv mv1 = parse("(1 + 2e12) * (a e1 + b e2) * (1 - 2e12)", pga, &cache);
+    CHECK_EQ(cache.size(), 4);
+
+    // Whitespace doesn't affect the key, and the shared rotor is reused
+    mv mv2 = parse("(1+2e12)*(a e1 + b e2)*(1-2e12)", pga, &cache);
+    CHECK_EQ(cache.size(), 4);
+    mv mv3 = parse("(1 + 2e12) * c e3 * (1 - 2e12)", pga, &cache);
+    CHECK_EQ(cache.size(), 5);
+
+    mv expected = parse("(1 + 2e12) * (a e1 + b e2) * (1 - 2e12)", pga);
+    REQUIRE_EQ(mv1.terms.size(), expected.terms.size());
+    REQUIRE_EQ(mv2.terms.size(), expected.terms.size());
+    for (auto&& [e, p] : expected.terms)
+    {
+        for (auto&& [m, f] : p.terms)
+        {
+            CHECK_EQ(mv1.terms[e].terms[m], f);
+            CHECK_EQ(mv2.terms[e].terms[m], f);
+        }
+    }
+    CHECK_EQ(mv3.terms.size(), 1);
+}
+
+TEST_CASE("codegen")
+{
+    algebra pga{3, 0, 1};
+
+    // Conjugate a point with a motor
+    mv symbolic = parse(
+        "(b0 + b1 e23 + b2 e31 + b3 e12 + c1 e01 + c2 e02 + c3 e03 + c0 e0123)"
+        " * (a0 e123 + a1 e032 + a2 e013 + a3 e021)"
+        " * (b0 - b1 e23 - b2 e31 - b3 e12 - c1 e01 - c2 e02 - c3 e03 + c0 "
+        "e0123)",
+        pga);
+    mv numeric = parse("(1 + 2e23 + 3e31 + 4e12 + 5e01 + 6e02 + 7e03 + 8e0123)"
+                       " * (e123 - e032 + e013 + 2e021)"
+                       " * (1 - 2e23 - 3e31 - 4e12 - 5e01 - 6e02 - 7e03 + "
+                       "8e0123)",
+                       pga);
+
+    // p3: (e123, e032, e013, e021)
+    float expected[4] = {numeric.terms[0b1110].terms.begin()->second,
+                         -numeric.terms[0b1101].terms.begin()->second,
+                         numeric.terms[0b1011].terms.begin()->second,
+                         -numeric.terms[0b111].terms.begin()->second};
+
+    for (simd_target target :
+         {simd_target::sse3, simd_target::sse41, simd_target::avx2})
+    {
+        kernel k{symbolic, {3}, target};
+        REQUIRE_EQ(k.inputs().size(), 3);
+
+        auto out = k.eval({{1.f, -1.f, 1.f, 2.f},
+                           {1.f, 2.f, 3.f, 4.f},
+                           {8.f, 5.f, 6.f, 7.f}});
+        REQUIRE_EQ(out.size(), 1);
+        for (size_t i = 0; i != 4; ++i)
+        {
+            CHECK_EQ(out[0][i], doctest::Approx(expected[i]));
+        }
+    }
+
+    SUBCASE("invalid-output")
+    {
+        // A rotor product has no vector component
+        mv rotors = parse(
+            "(a0 + a1 e23 + a2 e31 + a3 e12) * (b0 + b1 e23 + b2 e31 + b3 e12)",
+            pga);
+        bool threw = false;
+        try
+        {
+            kernel k{rotors, {0}, simd_target::sse41};
+        }
+        catch (std::runtime_error const&)
+        {
+            threw = true;
+        }
+        CHECK(threw);
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+// Assertions and utilities shared between test files
+
+#include <doctest/doctest.h>
+
+#include <klein/klein.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// Bit i of a mask of 32-bit words
+inline bool bit(uint32_t const* mask, size_t i)
+{
+    return (mask[i / 32] >> (i % 32) & 1u) != 0;
+}
+
+inline void check_point(kln::point a, kln::point b)
+{
+    CHECK_EQ(a.x(), doctest::Approx(b.x()));
+    CHECK_EQ(a.y(), doctest::Approx(b.y()));
+    CHECK_EQ(a.z(), doctest::Approx(b.z()));
+    CHECK_EQ(a.w(), doctest::Approx(b.w()));
+}
+
+inline void check_plane(kln::plane a, kln::plane b)
+{
+    CHECK_EQ(a.x(), doctest::Approx(b.x()));
+    CHECK_EQ(a.y(), doctest::Approx(b.y()));
+    CHECK_EQ(a.z(), doctest::Approx(b.z()));
+    CHECK_EQ(a.d(), doctest::Approx(b.d()));
+}
+
+inline void check_line(kln::line a, kln::line b)
+{
+    CHECK_EQ(a.e01(), doctest::Approx(b.e01()));
+    CHECK_EQ(a.e02(), doctest::Approx(b.e02()));
+    CHECK_EQ(a.e03(), doctest::Approx(b.e03()));
+    CHECK_EQ(a.e23(), doctest::Approx(b.e23()));
+    CHECK_EQ(a.e31(), doctest::Approx(b.e31()));
+    CHECK_EQ(a.e12(), doctest::Approx(b.e12()));
+}
+
+inline void check_motor(kln::motor a, kln::motor b)
+{
+    CHECK_EQ(a.scalar(), doctest::Approx(b.scalar()));
+    CHECK_EQ(a.e23(), doctest::Approx(b.e23()));
+    CHECK_EQ(a.e31(), doctest::Approx(b.e31()));
+    CHECK_EQ(a.e12(), doctest::Approx(b.e12()));
+    CHECK_EQ(a.e01(), doctest::Approx(b.e01()));
+    CHECK_EQ(a.e02(), doctest::Approx(b.e02()));
+    CHECK_EQ(a.e03(), doctest::Approx(b.e03()));
+    CHECK_EQ(a.e0123(), doctest::Approx(b.e0123()));
+}
+
+// Compare motors by their action on a point, since packing may flip the sign
+inline void check_action(kln::motor a, kln::motor b, float eps)
+{
+    kln::point p{0.5f, -1.f, 2.f};
+    kln::point pa = a(p);
+    kln::point pb = b(p);
+    CHECK_EQ(pa.x(), doctest::Approx(pb.x()).epsilon(eps));
+    CHECK_EQ(pa.y(), doctest::Approx(pb.y()).epsilon(eps));
+    CHECK_EQ(pa.z(), doctest::Approx(pb.z()).epsilon(eps));
+}
@@ -0,0 +1,387 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+namespace
+{
+struct bundle_data
+{
+    bundle_data()
+    {
+        for (size_t i = 0; i != 8; ++i)
+        {
+            float f = static_cast<float>(i);
+            points[i] = point{f - 3.f, 0.5f * f + 1.f, 2.f - f};
+            points2[i] = point{-f, 1.f + f * f * 0.1f, f - 4.f};
+            planes[i] = plane{1.f + f, -2.f, 0.5f * f, 3.f - f};
+            planes2[i] = plane{-1.f, f - 2.f, 2.f, f};
+            lines[i] = line{f, -1.f, 2.f, 1.f - f, 0.3f * f, 2.f};
+            rotor r{0.3f * f + 0.1f, 1.f, -f, 2.f};
+            translator t{1.f + f, -2.f, f, 0.5f};
+            motors[i] = r * t;
+            motors2[i] = translator{2.f, 1.f, 0.f, f} * rotor{-f, 0.f, 1.f, f};
+        }
+        // Include a pure translation and an ideal line to exercise the
+        // degenerate exp/log branches
+        motors[5] = motor{translator{3.f, 1.f, -1.f, 2.f}};
+        lines[6]  = line{1.f, 2.f, -3.f, 0.f, 0.f, 0.f};
+
+        p.load(points);
+        p2.load(points2);
+        pl.load(planes);
+        pl2.load(planes2);
+        l.load(lines);
+        m.load(motors);
+        m2.load(motors2);
+    }
+
+    point points[8];
+    point points2[8];
+    plane planes[8];
+    plane planes2[8];
+    line lines[8];
+    motor motors[8];
+    motor motors2[8];
+
+    point_x8 p;
+    point_x8 p2;
+    plane_x8 pl;
+    plane_x8 pl2;
+    line_x8 l;
+    motor_x8 m;
+    motor_x8 m2;
+};
+} // namespace
+
+TEST_CASE("bundle-load-store")
+{
+    bundle_data d;
+    point points[8];
+    motor motors[8];
+    d.p.store(points);
+    d.m.store(motors);
+    for (size_t i = 0; i != 8; ++i)
+    {
+        check_point(points[i], d.points[i]);
+        check_motor(motors[i], d.motors[i]);
+        check_line(d.l[i], d.lines[i]);
+        check_plane(d.pl[i], d.planes[i]);
+    }
+
+    SUBCASE("partial")
+    {
+        point_x8 p;
+        p.load(d.points, 3);
+        point out[8];
+        out[3] = point{9.f, 9.f, 9.f};
+        p.store(out, 3);
+        check_point(out[2], d.points[2]);
+        CHECK_EQ(out[3].x(), 9.f);
+        CHECK_EQ(p.w()[3], 0.f);
+    }
+
+    SUBCASE("broadcast")
+    {
+        motor_x8 m{d.motors[2]};
+        check_motor(m[7], d.motors[2]);
+    }
+}
+
+TEST_CASE("bundle-sandwich")
+{
+    bundle_data d;
+    point_x8 p   = d.m(d.p);
+    plane_x8 pl  = d.m(d.pl);
+    line_x8 l    = d.m(d.l);
+    for (size_t i = 0; i != 8; ++i)
+    {
+        check_point(p[i], d.motors[i](d.points[i]));
+        check_plane(pl[i], d.motors[i](d.planes[i]));
+        check_line(l[i], d.motors[i](d.lines[i]));
+    }
+}
+
+TEST_CASE("bundle-apply")
+{
+    // Eleven entities to cover a full block and a partial tail
+    bundle_data d;
+    size_t const count = 11;
+    motor motors[count];
+    point points[count];
+    plane planes[count];
+    line lines[count];
+    direction dirs[count];
+    uint32_t idx[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        motors[i] = d.motors[i % 8];
+        points[i] = d.points2[i % 8];
+        planes[i] = d.planes2[(i + 3) % 8];
+        lines[i]  = d.lines[(i + 1) % 8];
+        dirs[i]   = direction{1.f, static_cast<float>(i), -2.f};
+        idx[i]    = static_cast<uint32_t>((i * 5) % count);
+    }
+
+    point p_out[count];
+    plane pl_out[count];
+    line l_out[count];
+    direction d_out[count];
+    apply(motors, points, p_out, count);
+    apply(motors, planes, pl_out, count);
+    apply(motors, lines, l_out, count);
+    apply(motors, dirs, d_out, count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        check_point(p_out[i], motors[i](points[i]));
+        check_plane(pl_out[i], motors[i](planes[i]));
+        check_line(l_out[i], motors[i](lines[i]));
+        direction expected = motors[i](dirs[i]);
+        CHECK_EQ(d_out[i].x(), doctest::Approx(expected.x()));
+        CHECK_EQ(d_out[i].y(), doctest::Approx(expected.y()));
+        CHECK_EQ(d_out[i].z(), doctest::Approx(expected.z()));
+    }
+
+    SUBCASE("indexed")
+    {
+        apply(motors, idx, points, p_out, count);
+        apply(motors, idx, planes, pl_out, count);
+        apply(motors, idx, lines, l_out, count);
+        apply(motors, idx, dirs, d_out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            motor const& m = motors[idx[i]];
+            check_point(p_out[i], m(points[i]));
+            check_plane(pl_out[i], m(planes[i]));
+            check_line(l_out[i], m(lines[i]));
+            CHECK_EQ(d_out[i].y(), doctest::Approx(m(dirs[i]).y()));
+        }
+    }
+
+    SUBCASE("in-place")
+    {
+        point copy[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            copy[i] = points[i];
+        }
+        apply(motors, copy, copy, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            check_point(copy[i], motors[i](points[i]));
+        }
+    }
+}
+
+TEST_CASE("bundle-products")
+{
+    bundle_data d;
+    motor_x8 mm  = d.m * d.m2;
+    motor_x8 pp  = d.pl * d.pl2;
+    line_x8 meet = d.pl ^ d.pl2;
+    point_x8 pl  = d.pl ^ d.l;
+    line_x8 join = d.p & d.p2;
+    plane_x8 pj  = d.p & d.l;
+    float_x8 ip  = d.pl | d.pl2;
+    line_x8 ppt  = d.pl | d.p;
+    plane_x8 pll = d.pl | d.l;
+    plane_x8 lpl = d.l | d.pl;
+    plane_x8 ptl = d.p | d.l;
+    float_x8 ll  = d.l | d.l;
+    for (size_t i = 0; i != 8; ++i)
+    {
+        check_motor(mm[i], d.motors[i] * d.motors2[i]);
+        check_motor(pp[i], d.planes[i] * d.planes2[i]);
+        check_line(meet[i], d.planes[i] ^ d.planes2[i]);
+        check_point(pl[i], d.planes[i] ^ d.lines[i]);
+        check_line(join[i], d.points[i] & d.points2[i]);
+        check_plane(pj[i], d.points[i] & d.lines[i]);
+        CHECK_EQ(ip[i], doctest::Approx(d.planes[i] | d.planes2[i]));
+        check_line(ppt[i], d.planes[i] | d.points[i]);
+        check_plane(pll[i], d.planes[i] | d.lines[i]);
+        check_plane(lpl[i], d.lines[i] | d.planes[i]);
+        check_plane(ptl[i], d.points[i] | d.lines[i]);
+        CHECK_EQ(ll[i], doctest::Approx(d.lines[i] | d.lines[i]));
+    }
+}
+
+TEST_CASE("bundle-meet-join")
+{
+    bundle_data d;
+    size_t const count = 11;
+    plane a[count];
+    plane b[count];
+    plane c[count];
+    line lines[count];
+    point p[count];
+    point q[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        a[i]     = d.planes[i % 8];
+        b[i]     = d.planes2[i % 8];
+        c[i]     = plane{1.f, 2.f, static_cast<float>(i) - 0.5f, 0.5f};
+        lines[i] = d.lines[i % 6]; // Skip the ideal line
+        p[i]     = d.points[i % 8];
+        q[i]     = d.points2[(i + 2) % 8];
+    }
+
+    line l_out[count];
+    point p_out[count];
+    point v_out[count];
+    line j_out[count];
+
+    SUBCASE("unnormalized")
+    {
+        meet(a, b, l_out, count);
+        meet(a, lines, p_out, count);
+        meet(a, b, c, v_out, count);
+        join(p, q, j_out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            check_line(l_out[i], a[i] ^ b[i]);
+            check_point(p_out[i], a[i] ^ lines[i]);
+            check_point(v_out[i], c[i] ^ (a[i] ^ b[i]));
+            check_line(j_out[i], p[i] & q[i]);
+        }
+    }
+
+    SUBCASE("normalized")
+    {
+        meet(a, b, l_out, count, true);
+        meet(a, lines, p_out, count, true);
+        meet(a, b, c, v_out, count, true);
+        join(p, q, j_out, count, true);
+        for (size_t i = 0; i != count; ++i)
+        {
+            check_line(l_out[i], (a[i] ^ b[i]).normalized());
+            check_point(p_out[i], (a[i] ^ lines[i]).normalized());
+            check_point(v_out[i], (c[i] ^ (a[i] ^ b[i])).normalized());
+            check_line(j_out[i], (p[i] & q[i]).normalized());
+        }
+    }
+}
+
+TEST_CASE("bundle-normalize-distance")
+{
+    bundle_data d;
+    size_t const count = 11;
+    point points[count];
+    plane planes[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float w   = 0.5f + static_cast<float>(i);
+        points[i] = d.points[i % 8] * (i % 2 == 0 ? w : -w);
+        planes[i] = d.planes2[i % 8] * w;
+    }
+
+    float dist[count];
+    plane p = d.planes[3];
+    signed_distance(p, points, dist, count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        point q = d.points[i % 8];
+        CHECK_EQ(dist[i], doctest::Approx((p ^ q).e0123() / p.norm()));
+    }
+
+    line l = d.lines[2] * 3.f;
+    distance(l, points, dist, count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        point q = d.points[i % 8];
+        CHECK_EQ(dist[i], doctest::Approx((q & l.normalized()).norm()));
+    }
+
+    normalize(points, count);
+    normalize(planes, count);
+    for (size_t i = 0; i != count; ++i)
+    {
+        check_point(points[i], d.points[i % 8]);
+        plane expected = d.planes2[i % 8];
+        check_plane(planes[i], expected * (1.f / expected.norm()));
+        CHECK_EQ(planes[i].norm(), doctest::Approx(1.f));
+    }
+}
+
+TEST_CASE("bundle-linear")
+{
+    bundle_data d;
+    point_x8 p  = d.p + d.p2 * 2.f;
+    line_x8 l   = -d.l - d.l;
+    motor_x8 rm = ~d.m;
+    for (size_t i = 0; i != 8; ++i)
+    {
+        check_point(p[i], d.points[i] + d.points2[i] * 2.f);
+        check_line(l[i], -d.lines[i] - d.lines[i]);
+        check_motor(rm[i], ~d.motors[i]);
+    }
+}
+
+TEST_CASE("bundle-normalize")
+{
+    bundle_data d;
+    point_x8 p = (d.p * 3.f).normalized();
+    line_x8 l  = d.l.normalized();
+    motor_x8 m = (d.m * 2.5f).normalized();
+    plane_x8 pl = d.pl.normalized();
+    for (size_t i = 0; i != 8; ++i)
+    {
+        check_point(p[i], d.points[i]);
+        if (i != 6)
+        {
+            check_line(l[i], d.lines[i].normalized());
+        }
+        check_motor(m[i], d.motors[i].normalized());
+        CHECK_EQ((pl[i] | pl[i]), doctest::Approx(1.f));
+        CHECK_EQ(pl.d()[i] * d.planes[i].norm(),
+                 doctest::Approx(d.planes[i].d()));
+    }
+}
+
+TEST_CASE("bundle-exp-log")
+{
+    bundle_data d;
+    line_x8 l  = log(d.m);
+    motor_x8 m = exp(l);
+    motor_x8 e = exp(d.l);
+    for (size_t i = 0; i != 8; ++i)
+    {
+        check_line(l[i], log(d.motors[i]));
+        check_motor(m[i], d.motors[i]);
+        check_motor(e[i], exp(d.lines[i]));
+    }
+}
+
+TEST_CASE("bundle-sincos-atan2")
+{
+    float angles[8];
+    for (size_t j = 0; j != 64; ++j)
+    {
+        for (size_t i = 0; i != 8; ++i)
+        {
+            angles[i] = -100.f + static_cast<float>(j * 8 + i) * 0.39f;
+        }
+        float_x8 u;
+        u.load(angles);
+        float_x8 s;
+        float_x8 c;
+        detail::sincos(u, s, c);
+        float_x8 a = detail::atan2(s, c);
+        for (size_t i = 0; i != 8; ++i)
+        {
+            float x = angles[i];
+            CHECK_LT(std::abs(s[i] - std::sin(x)), 2e-7f);
+            CHECK_LT(std::abs(c[i] - std::cos(x)), 2e-7f);
+            CHECK_LT(std::abs(a[i] - std::atan2(std::sin(x), std::cos(x))),
+                     5e-7f);
+        }
+    }
+
+    float_x8 zero{0.f};
+    CHECK_EQ(detail::atan2(zero, zero)[0], 0.f);
+    CHECK_EQ(detail::atan2(float_x8{1.f}, zero)[0],
+             doctest::Approx(kln::pi * 0.5f));
+    CHECK_EQ(detail::atan2(zero, float_x8{-1.f})[0], doctest::Approx(kln::pi));
+}
@@ -0,0 +1,251 @@
+#include <doctest/doctest.h>
+
+#include <klein/klein.hpp>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace kln;
+
+namespace
+{
+float const radius = 0.25f;
+
+// Spheres of a fixed radius scattered through a 10 x 10 x 4 region
+struct test_scene
+{
+    static constexpr size_t count = 200;
+
+    test_scene()
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            float f    = static_cast<float>(i);
+            centers[i] = point{5.f * std::sin(1.3f * f),
+                               5.f * std::cos(0.7f * f),
+                               std::fmod(0.37f * f, 4.f)};
+            lo[i]      = point{centers[i].x() - radius,
+                          centers[i].y() - radius,
+                          centers[i].z() - radius};
+            hi[i]      = point{centers[i].x() + radius,
+                          centers[i].y() + radius,
+                          centers[i].z() + radius};
+        }
+        nodes.resize(bvh::max_nodes(count));
+        size_t node_count
+            = bvh::build(lo, hi, count, nodes.data(), indices, 3);
+        tree = bvh{nodes.data(), node_count, indices};
+    }
+
+    point centers[count];
+    point lo[count];
+    point hi[count];
+    std::vector<bvh_node> nodes;
+    uint32_t indices[count];
+    bvh tree;
+};
+
+constexpr size_t test_scene::count;
+
+float distance(point a, point b)
+{
+    float dx = a.x() - b.x();
+    float dy = a.y() - b.y();
+    float dz = a.z() - b.z();
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+// Parameter of the first hit of the ray o + t d with a sphere, or infinity
+float ray_sphere(point o, line ray, point c)
+{
+    float dx = ray.e23();
+    float dy = ray.e31();
+    float dz = ray.e12();
+    float ox = o.x() - c.x();
+    float oy = o.y() - c.y();
+    float oz = o.z() - c.z();
+    float a  = dx * dx + dy * dy + dz * dz;
+    float b  = dx * ox + dy * oy + dz * oz;
+    float cc = ox * ox + oy * oy + oz * oz - radius * radius;
+    float disc = b * b - a * cc;
+    float t    = (-b - std::sqrt(disc)) / a;
+    return disc < 0.f || t < 0.f ? std::numeric_limits<float>::infinity() : t;
+}
+
+motor test_instance()
+{
+    return translator{3.f, 1.f, -2.f, 0.5f} * rotor{1.1f, 0.3f, 1.f, -0.4f};
+}
+} // namespace
+
+TEST_CASE("bvh-build")
+{
+    test_scene s;
+    CHECK_LE(s.tree.size(), bvh::max_nodes(test_scene::count));
+
+    bool seen[test_scene::count] = {};
+    for (size_t i = 0; i != test_scene::count; ++i)
+    {
+        REQUIRE(s.indices[i] < test_scene::count);
+        seen[s.indices[i]] = true;
+    }
+    for (size_t i = 0; i != test_scene::count; ++i)
+    {
+        CHECK(seen[i]);
+    }
+
+    bvh_node const& root = s.tree.nodes()[0];
+    CHECK_LE(root.min[0], -5.f + radius);
+    CHECK_GE(root.max[1], 5.f - radius);
+
+    // Every leaf box contains the boxes of its primitives
+    for (size_t i = 0; i != s.tree.size(); ++i)
+    {
+        bvh_node const& n = s.tree.nodes()[i];
+        CHECK_LE(n.count, 3u);
+        for (uint32_t j = 0; j != n.count; ++j)
+        {
+            point c = s.centers[s.indices[n.offset + j]];
+            CHECK_LE(n.min[0], c.x() - radius);
+            CHECK_GE(n.max[2], c.z() + radius);
+        }
+    }
+
+    CHECK_EQ(bvh::build(nullptr, 0, nullptr, nullptr), size_t{0});
+    CHECK_EQ(bvh{}.raycast(point{}, line{0.f, 0.f, 0.f, 1.f, 0.f, 0.f},
+                           [](uint32_t, point const&, line const&) {
+                               return 0.f;
+                           }),
+             std::numeric_limits<float>::infinity());
+}
+
+TEST_CASE("bvh-raycast")
+{
+    test_scene s;
+    motor m     = test_instance();
+    size_t hits = 0;
+
+    for (size_t k = 0; k != 16; ++k)
+    {
+        float f = static_cast<float>(k);
+        point origin{-8.f + 0.3f * f, 0.5f * f - 4.f, 2.f};
+        line ray = origin & point{6.f, 4.f - 0.4f * f, 1.5f + 0.1f * f};
+
+        float expected = std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i != test_scene::count; ++i)
+        {
+            expected
+                = std::min(expected, ray_sphere(origin, ray, s.centers[i]));
+        }
+
+        auto hit = [&](uint32_t i, point const& o, line const& r) {
+            return ray_sphere(o, r, s.centers[i]);
+        };
+        float t = s.tree.raycast(origin, ray, hit);
+        CHECK_EQ(t, expected);
+        hits += std::isinf(t) ? 0 : 1;
+
+        // The same ray in world space against the instance
+        float tw = s.tree.raycast(m, m(origin), m(ray), hit);
+        if (std::isinf(expected))
+        {
+            CHECK(std::isinf(tw));
+        }
+        else
+        {
+            CHECK_EQ(tw, doctest::Approx(expected).epsilon(1e-3));
+        }
+
+        // Every sphere the line passes through is reported
+        std::vector<bool> reported(test_scene::count);
+        s.tree.intersect(m, m(ray), [&](uint32_t i, line const&) {
+            reported[i] = true;
+        });
+        for (size_t i = 0; i != test_scene::count; ++i)
+        {
+            if (ray_sphere(origin, ray, s.centers[i]) < 1e30f)
+            {
+                CHECK(reported[i]);
+            }
+        }
+    }
+    CHECK_GT(hits, size_t{4});
+}
+
+TEST_CASE("bvh-nearest")
+{
+    test_scene s;
+    motor m = test_instance();
+
+    for (size_t k = 0; k != 16; ++k)
+    {
+        float f = static_cast<float>(k);
+        point p{3.f * std::cos(f), 0.6f * f - 5.f, 0.25f * f};
+
+        float expected = std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i != test_scene::count; ++i)
+        {
+            expected = std::min(expected, distance(p, s.centers[i]));
+        }
+
+        auto dist = [&](uint32_t i, point const& q) {
+            return distance(q, s.centers[i]);
+        };
+        CHECK_EQ(s.tree.nearest(p, 100.f, dist), expected);
+        CHECK_EQ(s.tree.nearest(m, m(p), 100.f, dist),
+                 doctest::Approx(expected).epsilon(1e-3));
+        CHECK_EQ(s.tree.nearest(p, 1e-3f, dist), 1e-3f);
+    }
+}
+
+TEST_CASE("bvh-split")
+{
+    test_scene s;
+    motor m = test_instance();
+    plane p{1.f, 2.f, -0.5f, 0.7f};
+
+    int reported[test_scene::count] = {};
+    size_t classified                = 0;
+    s.tree.split(m, m(p), [&](uint32_t i, int side, plane const& local) {
+        ++reported[i];
+        float d = (local ^ s.centers[i]).e0123();
+        if (side != 0)
+        {
+            ++classified;
+            CHECK_GT(d * static_cast<float>(side), 0.f);
+        }
+    });
+    for (size_t i = 0; i != test_scene::count; ++i)
+    {
+        CHECK_EQ(reported[i], 1);
+    }
+    CHECK_GT(classified, test_scene::count / 2);
+}
+
+TEST_CASE("bvh-grazing")
+{
+    // Rays along the x axis lying on the y = 0 face of a unit cube, and in
+    // the plane of a flat box around the quad z = 0, 0 <= x, y <= 1
+    for (float depth : {1.f, 0.f})
+    {
+        point lo{0.f, 0.f, 0.f};
+        point hi{1.f, 1.f, depth};
+        bvh_node nodes[1];
+        uint32_t indices[1];
+        bvh tree{nodes, bvh::build(&lo, &hi, 1, nodes, indices), indices};
+
+        point origin{-1.f, 0.f, 0.5f * depth};
+        line ray = origin & point{2.f, 0.f, 0.5f * depth};
+
+        size_t reported = 0;
+        tree.intersect(ray, [&](uint32_t, line const&) { ++reported; });
+        CHECK_EQ(reported, size_t{1});
+
+        float t = tree.raycast(
+            origin, ray, [](uint32_t, point const&, line const&) {
+                return 1.f;
+            });
+        CHECK_EQ(t, 1.f);
+    }
+}
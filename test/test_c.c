@@ -0,0 +1,380 @@
+// Checks the batched routines of the C interface against their single-element
+// counterparts. Compiled as C11 and linked against klein_c, so this also
+// checks that every entry point is exported.
+
+#include <klein.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// Exercises both the eight-wide blocks and the scalar tail
+#define COUNT 11
+
+static int failures = 0;
+
+static void check_vec(__m128 a, __m128 b, char const* what, size_t i)
+{
+    float fa[4];
+    float fb[4];
+    _mm_storeu_ps(fa, a);
+    _mm_storeu_ps(fb, b);
+    for (int k = 0; k != 4; ++k)
+    {
+        float tolerance = 1e-4f * (1.f + fabsf(fb[k]));
+        if (!(fabsf(fa[k] - fb[k]) <= tolerance))
+        {
+            printf("%s[%zu] lane %d: %f != %f\n", what, i, k, fa[k], fb[k]);
+            ++failures;
+        }
+    }
+}
+
+static void check_point(kln_point a, kln_point b, char const* what, size_t i)
+{
+    check_vec(a.p3, b.p3, what, i);
+}
+
+static void check_plane(kln_plane a, kln_plane b, char const* what, size_t i)
+{
+    check_vec(a.p0, b.p0, what, i);
+}
+
+static void check_line(kln_line a, kln_line b, char const* what, size_t i)
+{
+    check_vec(a.p1, b.p1, what, i);
+    check_vec(a.p2, b.p2, what, i);
+}
+
+static void check_motor(kln_motor a, kln_motor b, char const* what, size_t i)
+{
+    check_vec(a.p1, b.p1, what, i);
+    check_vec(a.p2, b.p2, what, i);
+}
+
+// Apply a column-major matrix to the point (x, y, z, 1) stored in p, whose
+// lanes hold (w, x, y, z). The result has the same layout as a point.
+static __m128 transform(__m128 const* cols, kln_point p)
+{
+    float in[4];
+    _mm_storeu_ps(in, p.p3);
+    __m128 r = cols[3];
+    r        = _mm_add_ps(r, _mm_mul_ps(cols[0], _mm_set1_ps(in[1])));
+    r        = _mm_add_ps(r, _mm_mul_ps(cols[1], _mm_set1_ps(in[2])));
+    r        = _mm_add_ps(r, _mm_mul_ps(cols[2], _mm_set1_ps(in[3])));
+    // Rotate (x, y, z, w) into (w, x, y, z)
+    return _mm_shuffle_ps(r, r, _MM_SHUFFLE(2, 1, 0, 3));
+}
+
+// Compare the x, y and z lanes of two points, and w if check_w is set
+static void check_xyz(__m128 a,
+                      kln_point b,
+                      int check_w,
+                      char const* what,
+                      size_t i)
+{
+    __m128 mask = _mm_castsi128_ps(_mm_set_epi32(-1, -1, -1, check_w ? -1 : 0));
+    check_vec(_mm_and_ps(a, mask), _mm_and_ps(b.p3, mask), what, i);
+}
+
+static kln_point points[COUNT];
+static kln_plane planes[COUNT];
+static kln_line lines[COUNT];
+static kln_motor motors[COUNT];
+static kln_rotor rotors[COUNT];
+static uint32_t indices[COUNT];
+
+static void init(void)
+{
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        float f = (float)i;
+        kln_point_init(&points[i], f - 3.f, 0.5f * f, 2.f - f);
+        kln_plane_init(&planes[i], 1.f, f - 2.f, 0.5f, f);
+        kln_line_init(&lines[i], f, 2.f, -1.f, 1.f, -0.3f * f, 0.5f);
+
+        kln_line b;
+        kln_line_init(&b, 0.2f * f, -1.f, 0.5f, 0.1f * f, 0.4f, -0.2f);
+        motors[i] = line_exp(&b);
+
+        kln_line_init(&b, 0.f, 0.f, 0.f, 0.3f, -0.1f * f, 0.2f);
+        rotors[i].p1 = line_exp(&b).p1;
+
+        indices[i] = (uint32_t)((i * 7) % COUNT);
+    }
+}
+
+static void test_sandwiches(void)
+{
+    kln_motor m = motors[3];
+    kln_rotor r = rotors[5];
+    kln_point out_points[COUNT];
+    kln_plane out_planes[COUNT];
+    kln_line out_lines[COUNT];
+
+    kln_motor_points(&m, points, out_points, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_point(out_points[i],
+                    kln_motor_point(&m, &points[i]),
+                    "kln_motor_points",
+                    i);
+    }
+
+    kln_motor_lines(&m, lines, out_lines, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_line(out_lines[i],
+                   kln_motor_line(&m, &lines[i]),
+                   "kln_motor_lines",
+                   i);
+    }
+
+    kln_motor_planes(&m, planes, out_planes, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_plane(out_planes[i],
+                    kln_motor_plane(&m, &planes[i]),
+                    "kln_motor_planes",
+                    i);
+    }
+
+    // A direction transforms as the rotational part of the motor
+    kln_direction directions[COUNT];
+    kln_motor rotation = m;
+    rotation.p2        = _mm_setzero_ps();
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        directions[i].p3 = _mm_move_ss(points[i].p3, _mm_setzero_ps());
+    }
+    kln_motor_directions(&m, directions, directions, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        kln_point p;
+        p.p3 = _mm_move_ss(points[i].p3, _mm_setzero_ps());
+        check_vec(directions[i].p3,
+                  kln_motor_point(&rotation, &p).p3,
+                  "kln_motor_directions",
+                  i);
+    }
+
+    kln_rotate_points(&r, points, out_points, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_point(out_points[i],
+                    kln_rotate_point(&r, &points[i]),
+                    "kln_rotate_points",
+                    i);
+    }
+
+    kln_rotate_lines(&r, lines, out_lines, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_line(out_lines[i],
+                   kln_rotate_line(&r, &lines[i]),
+                   "kln_rotate_lines",
+                   i);
+    }
+
+    kln_rotate_planes(&r, planes, out_planes, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_plane(out_planes[i],
+                    kln_rotate_plane(&r, &planes[i]),
+                    "kln_rotate_planes",
+                    i);
+    }
+
+    // In place
+    memcpy(out_points, points, sizeof(points));
+    kln_motor_points(&m, out_points, out_points, COUNT);
+    memcpy(out_lines, lines, sizeof(lines));
+    kln_rotate_lines(&r, out_lines, out_lines, COUNT);
+    memcpy(out_planes, planes, sizeof(planes));
+    kln_motor_planes(&m, out_planes, out_planes, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_point(out_points[i],
+                    kln_motor_point(&m, &points[i]),
+                    "kln_motor_points (in place)",
+                    i);
+        check_line(out_lines[i],
+                   kln_rotate_line(&r, &lines[i]),
+                   "kln_rotate_lines (in place)",
+                   i);
+        check_plane(out_planes[i],
+                    kln_motor_plane(&m, &planes[i]),
+                    "kln_motor_planes (in place)",
+                    i);
+    }
+}
+
+static void test_per_element(void)
+{
+    kln_point out_points[COUNT];
+    kln_plane out_planes[COUNT];
+    kln_line out_lines[COUNT];
+
+    kln_motor_points_each(motors, points, out_points, COUNT);
+    kln_motor_lines_each(motors, lines, out_lines, COUNT);
+    kln_motor_planes_each(motors, planes, out_planes, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_point(out_points[i],
+                    kln_motor_point(&motors[i], &points[i]),
+                    "kln_motor_points_each",
+                    i);
+        check_line(out_lines[i],
+                   kln_motor_line(&motors[i], &lines[i]),
+                   "kln_motor_lines_each",
+                   i);
+        check_plane(out_planes[i],
+                    kln_motor_plane(&motors[i], &planes[i]),
+                    "kln_motor_planes_each",
+                    i);
+    }
+
+    memcpy(out_points, points, sizeof(points));
+    kln_motor_points_indexed(motors, indices, out_points, out_points, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_point(out_points[i],
+                    kln_motor_point(&motors[indices[i]], &points[i]),
+                    "kln_motor_points_indexed",
+                    i);
+    }
+}
+
+static void test_composition(void)
+{
+    kln_motor expected[COUNT];
+    kln_motor out[COUNT];
+    kln_motor other[COUNT];
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        other[i]    = motors[COUNT - 1 - i];
+        expected[i] = kln_compose_motors(&motors[i], &other[i]);
+    }
+
+    kln_compose_motors_each(motors, other, out, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_motor(out[i], expected[i], "kln_compose_motors_each", i);
+    }
+
+    // Output aliasing either input
+    memcpy(out, motors, sizeof(motors));
+    kln_compose_motors_each(out, other, out, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_motor(
+            out[i], expected[i], "kln_compose_motors_each (out = motors1)", i);
+    }
+    memcpy(out, other, sizeof(other));
+    kln_compose_motors_each(motors, out, out, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_motor(
+            out[i], expected[i], "kln_compose_motors_each (out = motors2)", i);
+    }
+
+    // All three arrays the same
+    memcpy(out, motors, sizeof(motors));
+    kln_compose_motors_each(out, out, out, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_motor(out[i],
+                    kln_compose_motors(&motors[i], &motors[i]),
+                    "kln_compose_motors_each (all aliased)",
+                    i);
+    }
+
+    kln_motor m = motors[6];
+    kln_compose_motors_with(&m, motors, out, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_motor(out[i],
+                    kln_compose_motors(&motors[i], &m),
+                    "kln_compose_motors_with",
+                    i);
+    }
+    memcpy(out, motors, sizeof(motors));
+    kln_compose_motors_with(&m, out, out, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_motor(out[i],
+                    kln_compose_motors(&motors[i], &m),
+                    "kln_compose_motors_with (in place)",
+                    i);
+    }
+}
+
+static void test_exp_log(void)
+{
+    kln_line logs[COUNT];
+    kln_motor exps[COUNT];
+    kln_motor_logs(motors, logs, COUNT);
+    kln_line_exps(lines, exps, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        check_line(logs[i], motor_log(&motors[i]), "kln_motor_logs", i);
+        check_motor(exps[i], line_exp(&lines[i]), "kln_line_exps", i);
+    }
+}
+
+static void test_matrices(void)
+{
+    kln_mat3x4 m34[COUNT];
+    kln_mat4x4 m44[COUNT];
+
+    kln_rotors_to_mat3x4(rotors, m34, COUNT);
+    kln_rotors_to_mat4x4(rotors, m44, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        kln_point p = kln_rotate_point(&rotors[i], &points[i]);
+        check_xyz(transform(m34[i].cols, points[i]),
+                  p,
+                  0,
+                  "kln_rotors_to_mat3x4",
+                  i);
+        check_xyz(transform(m44[i].cols, points[i]),
+                  p,
+                  1,
+                  "kln_rotors_to_mat4x4",
+                  i);
+    }
+
+    kln_motors_to_mat3x4(motors, m34, COUNT);
+    kln_motors_to_mat4x4(motors, m44, COUNT);
+    for (size_t i = 0; i != COUNT; ++i)
+    {
+        kln_point p = kln_motor_point(&motors[i], &points[i]);
+        check_xyz(transform(m34[i].cols, points[i]),
+                  p,
+                  0,
+                  "kln_motors_to_mat3x4",
+                  i);
+        check_xyz(transform(m44[i].cols, points[i]),
+                  p,
+                  1,
+                  "kln_motors_to_mat4x4",
+                  i);
+    }
+}
+
+int main(void)
+{
+    init();
+    test_sandwiches();
+    test_per_element();
+    test_composition();
+    test_exp_log();
+    test_matrices();
+    if (failures != 0)
+    {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
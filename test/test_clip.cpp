@@ -0,0 +1,154 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+#include <vector>
+
+using namespace kln;
+
+namespace
+{
+motor key_motor(size_t track, size_t key)
+{
+    float f = static_cast<float>(track) * 0.1f + static_cast<float>(key);
+    return translator{f, 1.f, 0.5f * f, -1.f}
+           * rotor{0.4f * f + 0.1f, 1.f, -f, 0.5f};
+}
+
+// Tracks with between one and three keys at staggered times
+struct test_tracks
+{
+    explicit test_tracks(size_t count)
+    {
+        times.resize(count * 3);
+        keys.resize(count * 3);
+        for (size_t i = 0; i != count; ++i)
+        {
+            uint32_t n = static_cast<uint32_t>(i % 3) + 1;
+            for (uint32_t j = 0; j != n; ++j)
+            {
+                times[i * 3 + j] = 0.5f * static_cast<float>(j + i % 2);
+                keys[i * 3 + j]  = key_motor(i, j);
+            }
+            tracks.push_back({&times[i * 3], &keys[i * 3], n});
+        }
+    }
+
+    std::vector<float> times;
+    std::vector<motor> keys;
+    std::vector<clip_track> tracks;
+};
+
+// 16-byte aligned storage for a serialized clip
+struct alignas(16) block
+{
+    unsigned char bytes[16];
+};
+
+std::vector<block> write_clip(test_tracks const& t,
+                               clip_encoding encoding,
+                               size_t& size)
+{
+    uint32_t count = static_cast<uint32_t>(t.tracks.size());
+    size           = clip::size(t.tracks.data(), count, encoding);
+    std::vector<block> buffer(size / sizeof(block));
+    clip::write(buffer.data(), t.tracks.data(), count, encoding);
+    return buffer;
+}
+} // namespace
+
+TEST_CASE("clip-sample")
+{
+    test_tracks t{3};
+    size_t size;
+    std::vector<block> buffer = write_clip(t, clip_encoding::motor, size);
+
+    clip c{buffer.data(), size};
+    REQUIRE(c.valid());
+    CHECK_EQ(c.track_count(), 3u);
+    CHECK_EQ(c.duration(), 1.f);
+    CHECK_EQ(c.key_count(2), 3u);
+    CHECK_EQ(c.times(1)[1], 1.f);
+
+    motor out[3];
+
+    SUBCASE("at keys")
+    {
+        c.sample(1.f, out);
+        check_action(out[0], t.keys[0], 1e-4f);
+        check_action(out[1], t.keys[4], 1e-4f);
+        check_action(out[2], t.keys[8], 1e-4f);
+    }
+
+    SUBCASE("between keys")
+    {
+        c.sample(0.8f, out);
+        check_action(out[0], t.keys[0], 1e-4f);
+        check_action(out[1], sclerp(t.keys[3], t.keys[4], 0.6f), 1e-4f);
+        check_action(out[2], sclerp(t.keys[7], t.keys[8], 0.6f), 1e-4f);
+    }
+
+    SUBCASE("clamped")
+    {
+        c.sample(-1.f, out);
+        check_action(out[1], t.keys[3], 1e-4f);
+        check_action(out[2], t.keys[6], 1e-4f);
+        c.sample(10.f, out);
+        check_action(out[1], t.keys[4], 1e-4f);
+        check_action(out[2], t.keys[8], 1e-4f);
+    }
+}
+
+TEST_CASE("clip-packed")
+{
+    // More tracks than the sampler processes in one chunk
+    test_tracks t{70};
+    size_t size;
+    std::vector<block> buffer = write_clip(t, clip_encoding::packed, size);
+
+    clip c{buffer.data(), size};
+    REQUIRE(c.valid());
+    CHECK_EQ(c.encoding(), clip_encoding::packed);
+
+    std::vector<motor> out(70);
+    c.sample(0.3f, out.data());
+    for (size_t i = 0; i != 70; ++i)
+    {
+        float const* times = t.tracks[i].times;
+        motor const* keys  = t.tracks[i].keys;
+        motor expected     = keys[0];
+        if (t.tracks[i].key_count > 1 && times[0] < 0.3f)
+        {
+            expected = sclerp(keys[0], keys[1], (0.3f - times[0]) / 0.5f);
+        }
+        check_action(out[i], expected, 1e-3f);
+    }
+}
+
+TEST_CASE("clip-invalid")
+{
+    test_tracks t{2};
+    size_t size;
+    std::vector<block> buffer = write_clip(t, clip_encoding::motor, size);
+
+    CHECK_FALSE(clip{}.valid());
+    CHECK_FALSE((clip{buffer.data(), size - 16}.valid()));
+    char* bytes = reinterpret_cast<char*>(buffer.data());
+    CHECK_FALSE((clip{bytes + 4, size}.valid()));
+
+    clip_header* h = reinterpret_cast<clip_header*>(buffer.data());
+    h->version     = 2;
+    CHECK_FALSE((clip{buffer.data(), size}.valid()));
+    h->version  = 1;
+    h->encoding = 7;
+    CHECK_FALSE((clip{buffer.data(), size}.valid()));
+    h->encoding = 0;
+    REQUIRE((clip{buffer.data(), size}.valid()));
+
+    clip_track_info* tracks
+        = reinterpret_cast<clip_track_info*>(bytes + h->tracks_offset);
+    tracks[1].key_count = 100;
+    CHECK_FALSE((clip{buffer.data(), size}.valid()));
+}
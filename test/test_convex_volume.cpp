@@ -0,0 +1,89 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+namespace
+{
+// A 90 degree frustum looking down -z with unnormalized planes
+convex_volume test_frustum()
+{
+    plane planes[6] = {{0.f, 0.f, -2.f, -2.f},
+                       {0.f, 0.f, 1.f, 10.f},
+                       {3.f, 0.f, -3.f, 0.f},
+                       {-1.f, 0.f, -1.f, 0.f},
+                       {0.f, 1.f, -1.f, 0.f},
+                       {0.f, -1.f, -1.f, 0.f}};
+    return convex_volume{planes, 6};
+}
+} // namespace
+
+TEST_CASE("convex-volume-single")
+{
+    convex_volume v = test_frustum();
+    CHECK_EQ(v.size(), size_t{6});
+    CHECK_EQ(v[0].z(), doctest::Approx(-1.f));
+    CHECK_EQ(v[0].d(), doctest::Approx(-1.f));
+
+    CHECK(v.contains(point{0.f, 0.f, -5.f}));
+    CHECK(v.contains(point{-1.f, 0.f, -1.f}));
+    CHECK_FALSE(v.contains(point{0.f, 0.f, -0.5f}));
+    CHECK_FALSE(v.contains(point{0.f, 0.f, -11.f}));
+    CHECK_FALSE(v.contains(point{3.f, 0.f, -2.f}));
+
+    CHECK(v.intersects(point{0.f, 0.f, -0.5f}, 0.6f));
+    CHECK_FALSE(v.intersects(point{0.f, 0.f, -0.5f}, 0.4f));
+    CHECK(v.intersects(point{3.f, 0.f, -2.f}, 1.f));
+    CHECK_FALSE(v.intersects(point{3.f, 0.f, -2.f}, 0.5f));
+
+    CHECK(v.intersects(point{2.f, -1.f, -3.f}, point{4.f, 1.f, -2.f}));
+    CHECK_FALSE(v.intersects(point{2.5f, -1.f, -2.f}, point{4.f, 1.f, -1.f}));
+
+    // The unbounded volume contains everything
+    CHECK(convex_volume{}.contains(point{1e6f, 0.f, 0.f}));
+}
+
+TEST_CASE("convex-volume-batch")
+{
+    // Enough entities to span two output words with a partial block
+    size_t const count = 45;
+    point points[count];
+    point lo[count];
+    point hi[count];
+    float radii[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f   = static_cast<float>(i);
+        points[i] = point{0.5f * f - 10.f, 0.1f * f, -0.3f * f};
+        lo[i]     = point{points[i].x() - 0.5f, points[i].y(), -0.4f * f};
+        hi[i]     = point{points[i].x() + 1.f, 1.f, points[i].z()};
+        radii[i]  = 0.05f * f;
+    }
+
+    convex_volume v = test_frustum();
+    uint32_t inside[2];
+    uint32_t spheres[2];
+    uint32_t boxes[2];
+    v.contains(points, inside, count);
+    v.intersects(points, radii, spheres, count);
+    v.intersects(lo, hi, boxes, count);
+
+    size_t inside_count = 0;
+    size_t sphere_count = 0;
+    for (size_t i = 0; i != count; ++i)
+    {
+        CHECK_EQ(bit(inside, i), v.contains(points[i]));
+        CHECK_EQ(bit(spheres, i), v.intersects(points[i], radii[i]));
+        CHECK_EQ(bit(boxes, i), v.intersects(lo[i], hi[i]));
+        inside_count += bit(inside, i) ? 1 : 0;
+        sphere_count += bit(spheres, i) ? 1 : 0;
+    }
+    // Make sure both outcomes are exercised
+    CHECK_GT(inside_count, size_t{0});
+    CHECK_LT(inside_count, sphere_count);
+    CHECK_LT(sphere_count, count);
+    CHECK_EQ(inside[1] >> (count - 32), 0u);
+}
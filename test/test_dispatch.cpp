@@ -0,0 +1,113 @@
+#include <doctest/doctest.h>
+
+#include <klein/dispatch.hpp>
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+TEST_CASE("dispatch-detect")
+{
+    dispatch::isa level = dispatch::detect();
+    CHECK_EQ(dispatch::active().level, level);
+    CHECK_NE(dispatch::table(dispatch::isa::sse3), nullptr);
+    CHECK_EQ(dispatch::table(level)->level, level);
+}
+
+TEST_CASE("dispatch-kernels")
+{
+    rotor r{1.3f, 0.2f, -1.f, 0.7f};
+    translator t{2.f, 1.f, -3.f, 0.5f};
+    motor m = r * t;
+
+    constexpr size_t count = 7;
+    point points[count];
+    plane planes[count];
+    line lines[count];
+    motor motors[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f   = static_cast<float>(i);
+        points[i] = point{f, 1.f - f, 2.f * f};
+        planes[i] = plane{1.f, f, -f, 3.f};
+        lines[i]  = line{f, 2.f, -1.f, 1.f, -f, 0.5f};
+        motors[i]
+            = rotor{0.1f * f, 1.f, f, -1.f} * translator{f, 0.f, 1.f, 1.f};
+    }
+
+    for (int l = 0; l <= static_cast<int>(dispatch::isa::avx2); ++l)
+    {
+        dispatch::isa level = static_cast<dispatch::isa>(l);
+        if (!dispatch::bind(level))
+        {
+            continue;
+        }
+        CAPTURE(l);
+
+        point p_out[count];
+        plane pl_out[count];
+        line l_out[count];
+        motor m_out[count];
+        mat4x4 mat_out[count];
+
+        dispatch::apply(m, points, p_out, count);
+        dispatch::apply(m, planes, pl_out, count);
+        dispatch::apply(m, lines, l_out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            point p = m(points[i]);
+            CHECK_EQ(p_out[i].x(), doctest::Approx(p.x()));
+            CHECK_EQ(p_out[i].y(), doctest::Approx(p.y()));
+            CHECK_EQ(p_out[i].z(), doctest::Approx(p.z()));
+            plane pl = m(planes[i]);
+            CHECK_EQ(pl_out[i].d(), doctest::Approx(pl.d()));
+            CHECK_EQ(pl_out[i].x(), doctest::Approx(pl.x()));
+            line li = m(lines[i]);
+            CHECK_EQ(l_out[i].e01(), doctest::Approx(li.e01()));
+            CHECK_EQ(l_out[i].e12(), doctest::Approx(li.e12()));
+        }
+
+        dispatch::apply(r, points, p_out, count);
+        dispatch::apply(r, planes, pl_out, count);
+        dispatch::apply(r, lines, l_out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            point p = r(points[i]);
+            CHECK_EQ(p_out[i].x(), doctest::Approx(p.x()));
+            CHECK_EQ(p_out[i].z(), doctest::Approx(p.z()));
+            plane pl = r(planes[i]);
+            CHECK_EQ(pl_out[i].y(), doctest::Approx(pl.y()));
+            line li = r(lines[i]);
+            CHECK_EQ(l_out[i].e02(), doctest::Approx(li.e02()));
+            CHECK_EQ(l_out[i].e31(), doctest::Approx(li.e31()));
+        }
+
+        dispatch::multiply(motors, motors, m_out, count);
+        dispatch::to_mat4x4(motors, mat_out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            motor mm = motors[i] * motors[i];
+            CHECK_EQ(m_out[i].scalar(), doctest::Approx(mm.scalar()));
+            CHECK_EQ(m_out[i].e23(), doctest::Approx(mm.e23()));
+            CHECK_EQ(m_out[i].e03(), doctest::Approx(mm.e03()));
+            CHECK_EQ(m_out[i].e0123(), doctest::Approx(mm.e0123()));
+
+            mat4x4 mat = motors[i].as_mat4x4();
+            for (size_t j = 0; j != 16; ++j)
+            {
+                CHECK_EQ(mat_out[i].data[j], doctest::Approx(mat.data[j]));
+            }
+        }
+
+        // In-place composition
+        motor in_place[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            in_place[i] = motors[i];
+        }
+        dispatch::multiply(in_place, motors, in_place, count);
+        CHECK_EQ(in_place[3].e01(),
+                 doctest::Approx((motors[3] * motors[3]).e01()));
+    }
+
+    dispatch::bind(dispatch::detect());
+}
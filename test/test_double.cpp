@@ -0,0 +1,196 @@
+#include <doctest/doctest.h>
+
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+namespace
+{
+void check_motor(dmotor a, motor b)
+{
+    CHECK_EQ(a.scalar(), doctest::Approx(b.scalar()));
+    CHECK_EQ(a.e23(), doctest::Approx(b.e23()));
+    CHECK_EQ(a.e31(), doctest::Approx(b.e31()));
+    CHECK_EQ(a.e12(), doctest::Approx(b.e12()));
+    CHECK_EQ(a.e01(), doctest::Approx(b.e01()));
+    CHECK_EQ(a.e02(), doctest::Approx(b.e02()));
+    CHECK_EQ(a.e03(), doctest::Approx(b.e03()));
+    CHECK_EQ(a.e0123(), doctest::Approx(b.e0123()));
+}
+
+motor sample_motor(float phase)
+{
+    return rotor{0.7f + phase, 1.f, -2.f, 0.5f}
+           * translator{3.f - phase, 0.f, 1.f, 2.f};
+}
+} // namespace
+
+TEST_CASE("double-conversion")
+{
+    point p{1.f, -2.f, 3.5f};
+    dpoint dp{p};
+    CHECK_EQ(dp.x(), 1.0);
+    CHECK_EQ(dp.y(), -2.0);
+    CHECK_EQ(dp.z(), 3.5);
+    CHECK_EQ(dp.w(), 1.0);
+    point back = dp.as_float();
+    CHECK_EQ(back.x(), 1.f);
+    CHECK_EQ(back.z(), 3.5f);
+
+    motor m = sample_motor(0.f);
+    check_motor(dmotor{m}, m);
+    CHECK_EQ(dmotor{m}.as_float(), m);
+
+    line l{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+    dline dl{l};
+    CHECK_EQ(dl.e01(), 1.0);
+    CHECK_EQ(dl.e02(), 2.0);
+    CHECK_EQ(dl.e03(), 3.0);
+    CHECK_EQ(dl.e23(), 4.0);
+    CHECK_EQ(dl.e31(), 5.0);
+    CHECK_EQ(dl.e12(), 6.0);
+    CHECK(dl == dline(1.0, 2.0, 3.0, 4.0, 5.0, 6.0));
+
+    dplane pl{plane{1.f, 2.f, 3.f, 4.f}};
+    CHECK_EQ(pl.x(), 1.0);
+    CHECK_EQ(pl.d(), 4.0);
+}
+
+TEST_CASE("double-gp-parity")
+{
+    motor a = sample_motor(0.f);
+    motor b = sample_motor(0.4f);
+    check_motor(dmotor{a} * dmotor{b}, a * b);
+    check_motor(dmotor{a} / dmotor{b}, a / b);
+
+    rotor r{1.2f, 0.f, 1.f, 1.f};
+    translator t{2.f, 1.f, 0.f, 0.f};
+    check_motor(drotor{r} * dtranslator{t}, r * t);
+    check_motor(dtranslator{t} * drotor{r}, t * r);
+    check_motor(drotor{r} * dmotor{a}, r * a);
+    check_motor(dmotor{a} * drotor{r}, a * r);
+    check_motor(dtranslator{t} * dmotor{a}, t * a);
+    check_motor(dmotor{a} * dtranslator{t}, a * t);
+
+    plane p1{1.f, 2.f, 3.f, 4.f};
+    plane p2{-1.f, 0.5f, 2.f, 1.f};
+    check_motor(dplane{p1} * dplane{p2}, p1 * p2);
+
+    line l1{1.f, 0.f, 2.f, 0.f, 1.f, 3.f};
+    line l2{0.f, 2.f, -1.f, 1.f, 1.f, 0.f};
+    check_motor(dline{l1} * dline{l2}, l1 * l2);
+}
+
+TEST_CASE("double-sandwich-parity")
+{
+    motor m = sample_motor(0.2f);
+    dmotor dm{m};
+
+    point p{1.f, 2.f, -3.f};
+    point p_f  = m(p);
+    dpoint p_d = dm(dpoint{p});
+    CHECK_EQ(p_d.x(), doctest::Approx(p_f.x()));
+    CHECK_EQ(p_d.y(), doctest::Approx(p_f.y()));
+    CHECK_EQ(p_d.z(), doctest::Approx(p_f.z()));
+    CHECK_EQ(p_d.w(), doctest::Approx(p_f.w()));
+
+    plane pl{1.f, -1.f, 2.f, 3.f};
+    plane pl_f  = m(pl);
+    dplane pl_d = dm(dplane{pl});
+    CHECK_EQ(pl_d.x(), doctest::Approx(pl_f.x()));
+    CHECK_EQ(pl_d.y(), doctest::Approx(pl_f.y()));
+    CHECK_EQ(pl_d.z(), doctest::Approx(pl_f.z()));
+    CHECK_EQ(pl_d.d(), doctest::Approx(pl_f.d()));
+
+    line l{1.f, 2.f, 3.f, -1.f, 0.5f, 2.f};
+    line l_f  = m(l);
+    dline l_d = dm(dline{l});
+    CHECK_EQ(l_d.e01(), doctest::Approx(l_f.e01()));
+    CHECK_EQ(l_d.e02(), doctest::Approx(l_f.e02()));
+    CHECK_EQ(l_d.e03(), doctest::Approx(l_f.e03()));
+    CHECK_EQ(l_d.e23(), doctest::Approx(l_f.e23()));
+    CHECK_EQ(l_d.e31(), doctest::Approx(l_f.e31()));
+    CHECK_EQ(l_d.e12(), doctest::Approx(l_f.e12()));
+
+    rotor r{0.9f, 1.f, 1.f, 0.f};
+    point pr_f  = r(p);
+    dpoint pr_d = drotor{r}(dpoint{p});
+    CHECK_EQ(pr_d.x(), doctest::Approx(pr_f.x()));
+    CHECK_EQ(pr_d.y(), doctest::Approx(pr_f.y()));
+    CHECK_EQ(pr_d.z(), doctest::Approx(pr_f.z()));
+
+    translator t{2.f, 0.f, 0.f, 1.f};
+    dpoint pt_d = dtranslator{t}(dpoint{p});
+    CHECK_EQ(pt_d.z(), doctest::Approx(-1.0));
+    dplane plt_d = dtranslator{t}(dplane{pl});
+    CHECK_EQ(plt_d.d(), doctest::Approx(t(pl).d()));
+    dline lt_d = dtranslator{t}(dline{l});
+    CHECK_EQ(lt_d.e01(), doctest::Approx(t(l).e01()));
+    CHECK_EQ(lt_d.e02(), doctest::Approx(t(l).e02()));
+
+    SUBCASE("array")
+    {
+        dpoint pts[3] = {{1.0, 2.0, 3.0}, {-1.0, 0.0, 2.0}, {4.0, 4.0, 4.0}};
+        dpoint expected[3];
+        for (size_t i = 0; i != 3; ++i)
+        {
+            expected[i] = dm(pts[i]);
+        }
+        dm(pts, pts, 3);
+        for (size_t i = 0; i != 3; ++i)
+        {
+            CHECK(pts[i].approx_eq(expected[i], 1e-12));
+        }
+    }
+}
+
+TEST_CASE("double-large-world")
+{
+    // A millimeter offset a thousand kilometers from the origin survives a
+    // round trip through a displaced rotation in double precision.
+    double far = 1e6;
+    dmotor m   = dtranslator{far, 1.0, 0.0, 0.0} * drotor{1.1, 0.0, 0.0, 1.0};
+    dpoint p{0.001, 0.0, 0.0};
+
+    dpoint q = m(p);
+    CHECK_EQ(q.x() - far, doctest::Approx(0.001 * std::cos(1.1)));
+    dpoint r = (~m)(q);
+    CHECK(std::abs(r.x() - 0.001) < 1e-9);
+    CHECK(std::abs(r.y()) < 1e-9);
+
+    // The same chain in single precision cannot resolve the offset
+    point qf = m.as_float()(p.as_float());
+    CHECK_NE(qf.x() - static_cast<float>(far),
+             doctest::Approx(0.001 * std::cos(1.1)));
+}
+
+TEST_CASE("double-exp-log")
+{
+    dmotor m{motor{sample_motor(0.3f)}};
+    m.normalize();
+    dmotor m2 = exp(log(m));
+    CHECK(m2.approx_eq(m, 1e-12));
+
+    line axis{1.f, 0.f, 0.f, 0.f, 0.f, 1.f};
+    check_motor(dmotor{0.8, 2.0, dline{axis}}, motor{0.8f, 2.f, axis});
+
+    dmotor half = sqrt(m);
+    CHECK((half * half).approx_eq(m, 1e-12));
+}
+
+TEST_CASE("double-matrix")
+{
+    dmotor m{motor{sample_motor(0.1f)}};
+    m.normalize();
+    dmat4x4 mat = m.as_mat4x4();
+    dpoint p{1.0, -2.0, 0.5};
+
+    double in[4] = {1.0, -2.0, 0.5, 1.0};
+    double out[4];
+    detail::storeu_pd(out, mat(detail::loadu_pd(in)));
+    dpoint expected = m(p);
+    CHECK_EQ(out[0], doctest::Approx(expected.x()));
+    CHECK_EQ(out[1], doctest::Approx(expected.y()));
+    CHECK_EQ(out[2], doctest::Approx(expected.z()));
+    CHECK_EQ(out[3], doctest::Approx(1.0));
+}
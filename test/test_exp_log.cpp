@@ -1,7 +1,11 @@
 #include <doctest/doctest.h>
 
+#include "helpers.hpp"
+
 #include <klein/klein.hpp>
 
+#include <algorithm>
+
 using namespace kln;
 
 TEST_CASE("rotor-exp-log")
@@ -135,3 +139,147 @@ TEST_CASE("ideal-motor-step")
     CHECK_EQ(result.e03(), doctest::Approx(m1.e03()));
     CHECK_EQ(result.e0123(), doctest::Approx(m1.e0123()));
 }
+
+TEST_CASE("motor-exp-log-array")
+{
+    // Eleven entries to exercise both a full batch and a partial one
+    motor motors[11];
+    for (size_t i = 0; i != 11; ++i)
+    {
+        float f = static_cast<float>(i);
+        motors[i] = rotor{0.4f * f - 1.5f, 1.f, f - 4.f, 0.5f}
+                    * translator{f, -1.f, 0.3f * f, 2.f};
+    }
+    motors[3] = motor{translator{2.f, 0.f, 1.f, -1.f}};
+
+    line lines[11];
+    motor out[11];
+    log(motors, lines, 11);
+    exp(lines, out, 11);
+
+    for (size_t i = 0; i != 11; ++i)
+    {
+        line l = log(motors[i]);
+        CHECK_EQ(lines[i].e01(), doctest::Approx(l.e01()));
+        CHECK_EQ(lines[i].e02(), doctest::Approx(l.e02()));
+        CHECK_EQ(lines[i].e03(), doctest::Approx(l.e03()));
+        CHECK_EQ(lines[i].e23(), doctest::Approx(l.e23()));
+        CHECK_EQ(lines[i].e31(), doctest::Approx(l.e31()));
+        CHECK_EQ(lines[i].e12(), doctest::Approx(l.e12()));
+
+        CHECK_EQ(out[i].scalar(), doctest::Approx(motors[i].scalar()));
+        CHECK_EQ(out[i].e23(), doctest::Approx(motors[i].e23()));
+        CHECK_EQ(out[i].e31(), doctest::Approx(motors[i].e31()));
+        CHECK_EQ(out[i].e12(), doctest::Approx(motors[i].e12()));
+        CHECK_EQ(out[i].e01(), doctest::Approx(motors[i].e01()));
+        CHECK_EQ(out[i].e02(), doctest::Approx(motors[i].e02()));
+        CHECK_EQ(out[i].e03(), doctest::Approx(motors[i].e03()));
+        CHECK_EQ(out[i].e0123(), doctest::Approx(motors[i].e0123()));
+    }
+}
+
+namespace
+{
+void check_rotor(rotor a, rotor b)
+{
+    CHECK_EQ(a.scalar(), doctest::Approx(b.scalar()));
+    CHECK_EQ(a.e23(), doctest::Approx(b.e23()));
+    CHECK_EQ(a.e31(), doctest::Approx(b.e31()));
+    CHECK_EQ(a.e12(), doctest::Approx(b.e12()));
+}
+} // namespace
+
+TEST_CASE("motor-sclerp")
+{
+    motor a = rotor{kln::pi * 0.5f, 0, 0, 1.f}
+              * translator{1.f, 0.f, 0.f, 1.f};
+    motor b = rotor{kln::pi * 0.5f, 0.3f, -3.f, 1.f}
+              * translator{12.f, -2.f, 0.4f, 1.f};
+
+    check_motor(sclerp(a, b, 0.f), a);
+    check_motor(sclerp(a, b, 1.f), b);
+    // The opposite sign of b encodes the same motion
+    check_motor(sclerp(a, -b, 1.f), b);
+
+    // Two half steps of the relative motion recover the full motion
+    motor half = sclerp(a, b, 0.5f) * ~a;
+    check_motor(half * half * a, b);
+    check_motor(sclerp(a, a, 0.3f), a);
+}
+
+TEST_CASE("rotor-slerp-nlerp")
+{
+    rotor a{0.2f, 1.f, 2.f, -1.f};
+    rotor b{1.4f, 1.f, 2.f, -1.f};
+
+    check_rotor(slerp(a, b, 0.f), a);
+    check_rotor(slerp(a, b, 1.f), b);
+    check_rotor(slerp(a, b, 0.5f), rotor{0.8f, 1.f, 2.f, -1.f});
+    check_rotor(slerp(a, -b, 0.25f), rotor{0.5f, 1.f, 2.f, -1.f});
+    check_rotor(slerp(a, a, 0.5f), a);
+
+    check_rotor(nlerp(a, b, 0.f), a);
+    check_rotor(nlerp(a, -b, 1.f), b);
+    // Symmetric about the midpoint, nlerp and slerp agree
+    check_rotor(nlerp(a, b, 0.5f), slerp(a, b, 0.5f));
+}
+
+TEST_CASE("motor-blend-array")
+{
+    motor a[11];
+    motor b[11];
+    motor c[11];
+    float t[11];
+    for (size_t i = 0; i != 11; ++i)
+    {
+        float f = static_cast<float>(i);
+        a[i] = rotor{0.1f * f, 1.f, -f, 2.f} * translator{f, 1.f, 0.f, 2.f};
+        b[i] = rotor{0.2f * f + 1.f, 1.f, 2.f, f}
+               * translator{1.f, -1.f, f, 0.f};
+        c[i] = rotor{-0.5f, 0.f, 1.f, f} * translator{2.f, f, 1.f, 1.f};
+        t[i] = f / 10.f;
+    }
+    // Opposite hemisphere
+    b[4] = -b[4];
+
+    motor out[11];
+    blend(a, b, t, out, 11);
+    for (size_t i = 0; i != 11; ++i)
+    {
+        check_motor(out[i], nlerp(a[i], b[i], t[i]));
+    }
+
+    // In-place over b
+    motor b2[11];
+    std::copy(b, b + 11, b2);
+    blend(a, b2, t, b2, 11);
+    for (size_t i = 0; i != 11; ++i)
+    {
+        check_motor(b2[i], out[i]);
+    }
+
+    motor const* layers[3] = {a, b, c};
+    float weights[3]       = {0.5f, 0.3f, 0.2f};
+    blend(layers, weights, 3, out, 11);
+    for (size_t i = 0; i != 11; ++i)
+    {
+        motor joint[3] = {a[i], b[i], c[i]};
+        check_motor(out[i], blend(joint, weights, 3));
+    }
+
+    float solo[3] = {1.f, 0.f, 0.f};
+    blend(layers, solo, 3, out, 11);
+    for (size_t i = 0; i != 11; ++i)
+    {
+        check_motor(out[i], a[i]);
+    }
+
+    // An empty blend is the identity
+    motor identity{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f};
+    check_motor(blend(a, weights, 0), identity);
+    blend(layers, weights, 0, out, 11);
+    for (size_t i = 0; i != 11; ++i)
+    {
+        check_motor(out[i], identity);
+    }
+}
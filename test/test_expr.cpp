@@ -0,0 +1,92 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+TEST_CASE("expr-product")
+{
+    rotor r{0.7f, 1.f, -2.f, 0.5f};
+    translator t{3.f, 0.f, 1.f, 2.f};
+    motor m1 = r * t;
+    motor m2 = translator{1.f, 1.f, 0.f, 0.f} * rotor{1.3f, 0.f, 0.f, 1.f};
+    motor m3 = rotor{-0.4f, 1.f, 1.f, 0.f} * translator{2.f, 0.f, 0.f, 1.f};
+
+    point p{1.f, -2.f, 3.f};
+    line l{1.f, 2.f, 3.f, -1.f, 0.5f, 2.f};
+
+    // Nested conjugation for points and mixed chains, composition for lines
+    // through two motors. Both must agree with the eager result.
+    check_point((lazy(m3) * m2 * m1)(p), (m3 * m2 * m1)(p));
+    check_point((lazy(t) * r)(p), (t * r)(p));
+    check_line((lazy(m3) * m2 * m1)(l), (m3 * m2 * m1)(l));
+    check_line((lazy(t) * r)(l), (t * r)(l));
+    check_line((lazy(m2) * r)(l), (m2 * r)(l));
+
+    // Conversion evaluates the product
+    motor m = lazy(m3) * m2 * m1;
+    CHECK(m.approx_eq(m3 * m2 * m1, 1e-6f));
+    rotor rr = lazy(r) * r;
+    CHECK(rr.approx_eq(r * r, 1e-6f));
+
+    SUBCASE("array")
+    {
+        point pts[5] = {{1.f, 2.f, 3.f},
+                        {-1.f, 0.f, 2.f},
+                        {4.f, 4.f, 4.f},
+                        {0.f, 0.f, 0.f},
+                        {2.f, -3.f, 1.f}};
+        point expected[5];
+        for (int i = 0; i != 5; ++i)
+        {
+            expected[i] = (m3 * m2 * m1)(pts[i]);
+        }
+        (lazy(m3) * m2 * m1)(pts, pts, 5);
+        for (int i = 0; i != 5; ++i)
+        {
+            check_point(pts[i], expected[i]);
+        }
+    }
+}
+
+TEST_CASE("expr-project")
+{
+    plane a{1.f, 2.f, 3.f, 4.f};
+    plane b{-1.f, 2.f, 0.5f, 1.f};
+    point p{3.f, -1.f, 2.f};
+
+    check_point(project(p, lazy(a) ^ b), project(p, a ^ b));
+    check_point(kln::project(p, lazy(a) ^ lazy(b)), project(p, a ^ b));
+
+    // The projected point lies on both planes
+    point q = project(p, lazy(a) ^ b);
+    q.normalize();
+    for (plane pl : {a, b})
+    {
+        float d = pl.x() * q.x() + pl.y() * q.y() + pl.z() * q.z() + pl.d();
+        CHECK_EQ(d, doctest::Approx(0.f).epsilon(1e-5f));
+    }
+
+    // Other projections fall back to evaluating the expression
+    check_point(project(p, lazy(a)), project(p, a));
+    check_point(project(p, lazy(point{1.f, 0.f, 0.f}) & point{0.f, 1.f, 0.f}),
+                project(p, point{1.f, 0.f, 0.f} & point{0.f, 1.f, 0.f}));
+}
+
+TEST_CASE("expr-meet-join")
+{
+    plane a{1.f, 2.f, 3.f, 4.f};
+    plane b{-1.f, 2.f, 0.5f, 1.f};
+    plane c{0.f, 1.f, -1.f, 2.f};
+    line l = lazy(a) ^ b;
+    check_line(l, a ^ b);
+    point p = (lazy(a) ^ b) ^ c;
+    check_point(p, (a ^ b) ^ c);
+
+    point p1{1.f, 0.f, 0.f};
+    point p2{0.f, 1.f, 0.f};
+    line j = lazy(p1) & p2;
+    check_line(j, p1 & p2);
+}
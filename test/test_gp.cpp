@@ -307,4 +307,85 @@ TEST_CASE("multivector-gp")
         CHECK_EQ(m2.e03(), doctest::Approx(0.f));
         CHECK_EQ(m2.e0123(), doctest::Approx(0.f));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("motor-batch-multiply")
+{
+    // An odd count exercises both the paired and remainder iterations of
+    // the AVX2 path
+    constexpr size_t count = 5;
+    motor a[count];
+    motor b[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f = static_cast<float>(i);
+        a[i]    = motor{2 + f, 3, 4 - f, 5, 6, 7 + f, 8, 9};
+        b[i]    = motor{6, 7 - f, 8, 9 + f, 10, 11, 12 - f, 13};
+    }
+
+    SUBCASE("elementwise")
+    {
+        motor out[count];
+        multiply(a, b, out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            motor expected = a[i] * b[i];
+            CHECK_EQ(out[i].scalar(), doctest::Approx(expected.scalar()));
+            CHECK_EQ(out[i].e23(), doctest::Approx(expected.e23()));
+            CHECK_EQ(out[i].e31(), doctest::Approx(expected.e31()));
+            CHECK_EQ(out[i].e12(), doctest::Approx(expected.e12()));
+            CHECK_EQ(out[i].e01(), doctest::Approx(expected.e01()));
+            CHECK_EQ(out[i].e02(), doctest::Approx(expected.e02()));
+            CHECK_EQ(out[i].e03(), doctest::Approx(expected.e03()));
+            CHECK_EQ(out[i].e0123(), doctest::Approx(expected.e0123()));
+        }
+    }
+
+    SUBCASE("broadcast")
+    {
+        motor out[count];
+        multiply(a[1], b, out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            motor expected = a[1] * b[i];
+            CHECK_EQ(out[i].scalar(), doctest::Approx(expected.scalar()));
+            CHECK_EQ(out[i].e12(), doctest::Approx(expected.e12()));
+            CHECK_EQ(out[i].e03(), doctest::Approx(expected.e03()));
+            CHECK_EQ(out[i].e0123(), doctest::Approx(expected.e0123()));
+        }
+    }
+
+    SUBCASE("in-place")
+    {
+        motor out[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            out[i] = b[i];
+        }
+        multiply(a, out, out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            motor expected = a[i] * b[i];
+            CHECK_EQ(out[i].e23(), doctest::Approx(expected.e23()));
+            CHECK_EQ(out[i].e01(), doctest::Approx(expected.e01()));
+        }
+    }
+
+    SUBCASE("prefix")
+    {
+        motor out[count];
+        prefix_product(a, out, count);
+        motor expected = a[0];
+        for (size_t i = 0; i != count; ++i)
+        {
+            if (i != 0)
+            {
+                expected = expected * a[i];
+            }
+            CHECK_EQ(out[i].scalar(), doctest::Approx(expected.scalar()));
+            CHECK_EQ(out[i].e31(), doctest::Approx(expected.e31()));
+            CHECK_EQ(out[i].e02(), doctest::Approx(expected.e02()));
+            CHECK_EQ(out[i].e0123(), doctest::Approx(expected.e0123()));
+        }
+    }
+}
@@ -33,6 +33,21 @@ TEST_CASE("measure-point-to-plane")
     CHECK_EQ(std::abs((p1 ^ p2).e0123()), root_two);
 }
 
+TEST_CASE("plane-normalize")
+{
+    // Plane 2x + 2y + z = 6 at distance 2 from the origin
+    plane p{2.f, 2.f, 1.f, -6.f};
+    p.normalize();
+    CHECK_EQ(p.norm(), doctest::Approx(1.f));
+    CHECK_EQ(p.d(), doctest::Approx(-2.f));
+
+    // The plane itself is unchanged, so distances can be read directly
+    point q{3.f, 0.f, 0.f};
+    CHECK_EQ((p ^ q).e0123(), doctest::Approx(0.f));
+    CHECK_EQ((p ^ point{0.f, 0.f, 0.f}).e0123(), doctest::Approx(-2.f));
+    CHECK_EQ(p.normalized().d(), doctest::Approx(p.d()));
+}
+
 TEST_CASE("measure-point-to-line")
 {
     line l{0, 1, 0, 1, 0, 0};
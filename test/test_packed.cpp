@@ -0,0 +1,120 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+namespace
+{
+motor test_motor(size_t i)
+{
+    float f = static_cast<float>(i);
+    return translator{0.7f * f - 3.f, 1.f, -f, 0.5f}
+           * rotor{0.9f * f - 2.5f, f - 3.f, 1.f, 0.25f * f};
+}
+} // namespace
+
+TEST_CASE("packed-motor-round-trip")
+{
+    motor in[12];
+    for (size_t i = 0; i != 12; ++i)
+    {
+        in[i] = test_motor(i);
+    }
+    // Exercise every dropped component index and sign
+    in[8]  = motor{rotor{0.1f, 1.f, 0.f, 0.f}};
+    in[9]  = motor{rotor{kln::pi - 0.1f, 0.f, -1.f, 0.f}};
+    in[10] = motor{rotor{kln::pi - 0.1f, 0.f, 0.f, 1.f}};
+    in[11] = -in[11];
+
+    packed_range range{in, 12};
+    packed_motor packed[12];
+    pack(range, in, packed, 12);
+
+    motor out[12];
+    unpack(range, packed, out, 12);
+
+    for (size_t i = 0; i != 12; ++i)
+    {
+        check_action(out[i], in[i], 1e-3f);
+
+        // The rotor is recovered up to sign
+        float dot = out[i].scalar() * in[i].scalar()
+                    + out[i].e23() * in[i].e23() + out[i].e31() * in[i].e31()
+                    + out[i].e12() * in[i].e12();
+        float sign = dot < 0.f ? -1.f : 1.f;
+        CHECK_EQ(sign * out[i].scalar(),
+                 doctest::Approx(in[i].scalar()).epsilon(1e-3));
+        CHECK_EQ(sign * out[i].e23(),
+                 doctest::Approx(in[i].e23()).epsilon(1e-3));
+        CHECK_EQ(sign * out[i].e31(),
+                 doctest::Approx(in[i].e31()).epsilon(1e-3));
+        CHECK_EQ(sign * out[i].e12(),
+                 doctest::Approx(in[i].e12()).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("packed-motor-range")
+{
+    motor m = translator{4.f, 1.f, 0.f, 0.f} * rotor{1.f, 0.f, 0.f, 1.f};
+
+    SUBCASE("clamped")
+    {
+        packed_range range{-1.f, -1.f, -1.f, 1.f, 1.f, 1.f};
+        packed_motor packed;
+        pack(range, &m, &packed, 1);
+        motor out;
+        unpack(range, &packed, &out, 1);
+
+        point origin{0.f, 0.f, 0.f};
+        point p = out(origin);
+        CHECK_EQ(p.x(), doctest::Approx(1.f));
+        // Zero lies half a step between two quantized values
+        CHECK_EQ(p.y(), doctest::Approx(0.f).epsilon(1e-4));
+        CHECK_EQ(p.z(), doctest::Approx(0.f).epsilon(1e-4));
+    }
+
+    SUBCASE("empty")
+    {
+        rotor r{1.f, 0.f, 1.f, 0.f};
+        motor in{r};
+        packed_range range;
+        packed_motor packed;
+        pack(range, &in, &packed, 1);
+        motor out;
+        unpack(range, &packed, &out, 1);
+        check_action(out, in, 1e-3f);
+        CHECK_EQ(out.e01(), doctest::Approx(0.f));
+        CHECK_EQ(out.e02(), doctest::Approx(0.f));
+        CHECK_EQ(out.e03(), doctest::Approx(0.f));
+    }
+}
+
+TEST_CASE("packed-motor-nlerp")
+{
+    motor a[5];
+    motor b[5];
+    for (size_t i = 0; i != 5; ++i)
+    {
+        a[i] = test_motor(i);
+        b[i] = test_motor(i + 1);
+    }
+    motor both[10];
+    for (size_t i = 0; i != 5; ++i)
+    {
+        both[i]     = a[i];
+        both[i + 5] = b[i];
+    }
+    packed_range range{both, 10};
+    packed_motor packed[10];
+    pack(range, both, packed, 10);
+
+    motor out[5];
+    unpack_nlerp(range, packed, packed + 5, 0.3f, out, 5);
+    for (size_t i = 0; i != 5; ++i)
+    {
+        check_action(out[i], nlerp(a[i], b[i], 0.3f), 1e-3f);
+    }
+}
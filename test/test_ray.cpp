@@ -0,0 +1,224 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+#include <cmath>
+#include <limits>
+
+using namespace kln;
+
+namespace
+{
+// A grid of vertical rays from z = 5 down to z = -5
+struct vertical_rays
+{
+    static constexpr size_t count = 36;
+
+    vertical_rays()
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            float x    = static_cast<float>(i % 6) - 0.7f;
+            float y    = static_cast<float>(i / 6) - 0.9f;
+            origins[i] = point{x, y, 5.f};
+            rays[i]    = origins[i] & point{x, y, -5.f};
+        }
+    }
+
+    point origins[count];
+    line rays[count];
+};
+
+constexpr size_t vertical_rays::count;
+} // namespace
+
+TEST_CASE("ray-plane")
+{
+    size_t const count = 11;
+    point origins[count];
+    line rays[count];
+    for (size_t i = 0; i != count; ++i)
+    {
+        float f    = static_cast<float>(i);
+        origins[i] = point{f, 0.5f * f, 5.f};
+        // Every third ray points away from the plane
+        float z = i % 3 == 2 ? 10.f : -5.f;
+        rays[i] = origins[i] & point{0.3f * f, 1.f, z};
+    }
+    // Parallel to the plane
+    rays[4] = origins[4] & point{1.f, 2.f, 5.f};
+
+    plane p{0.f, 0.f, 1.f, 0.f};
+    uint32_t mask;
+    float t[count];
+    point points[count];
+    ray_hits out{&mask, t, points};
+
+    SUBCASE("rays")
+    {
+        intersect(rays, origins, p, out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            bool hit = i % 3 != 2 && i != 4;
+            REQUIRE_EQ(bit(&mask, i), hit);
+            if (hit)
+            {
+                float f = static_cast<float>(i);
+                CHECK_EQ(t[i], doctest::Approx(0.5f));
+                CHECK_EQ(points[i].x(), doctest::Approx(0.65f * f));
+                CHECK_EQ(points[i].y(), doctest::Approx(0.25f * f + 0.5f));
+                CHECK_EQ(points[i].z(), doctest::Approx(0.f));
+            }
+            else
+            {
+                CHECK_EQ(t[i], std::numeric_limits<float>::infinity());
+            }
+        }
+    }
+
+    SUBCASE("lines")
+    {
+        intersect(rays, nullptr, p, out, count);
+        for (size_t i = 0; i != count; ++i)
+        {
+            REQUIRE_EQ(bit(&mask, i), i != 4);
+            if (i != 4)
+            {
+                point expected = (p ^ rays[i]).normalized();
+                CHECK_EQ(points[i].x(), doctest::Approx(expected.x()));
+                CHECK_EQ(points[i].y(), doctest::Approx(expected.y()));
+                CHECK_EQ(points[i].z(), doctest::Approx(0.f));
+            }
+        }
+        // For a normalized line, parameters differ by the distance between
+        // the hit points
+        line normalized = rays[5].normalized();
+        plane planes[2] = {p, plane{0.f, 0.f, 1.f, 1.f}};
+        float tt[2];
+        for (size_t i = 0; i != 2; ++i)
+        {
+            ray_hits hits{nullptr, tt + i, nullptr};
+            intersect(&normalized, nullptr, planes[i], hits, 1);
+        }
+        point h0 = (planes[0] ^ normalized).normalized();
+        point h1 = (planes[1] ^ normalized).normalized();
+        float dx = h1.x() - h0.x();
+        float dy = h1.y() - h0.y();
+        float dz = h1.z() - h0.z();
+        CHECK_EQ(std::abs(tt[1] - tt[0]),
+                 doctest::Approx(std::sqrt(dx * dx + dy * dy + dz * dz)));
+    }
+}
+
+TEST_CASE("ray-triangle")
+{
+    vertical_rays r;
+    point a{0.f, 0.f, 0.f};
+    point b{4.f, 0.f, 0.f};
+    point c{0.f, 4.f, 0.f};
+
+    uint32_t mask[2];
+    float t[vertical_rays::count];
+    point points[vertical_rays::count];
+    intersect(r.rays,
+              r.origins,
+              a,
+              b,
+              c,
+              ray_hits{mask, t, points},
+              vertical_rays::count);
+
+    size_t hits = 0;
+    for (size_t i = 0; i != vertical_rays::count; ++i)
+    {
+        float x     = r.origins[i].x();
+        float y     = r.origins[i].y();
+        bool inside = x > 0.f && y > 0.f && x + y < 4.f;
+        REQUIRE_EQ(bit(mask, i), inside);
+        if (inside)
+        {
+            ++hits;
+            CHECK_EQ(t[i], doctest::Approx(0.5f));
+            CHECK_EQ(points[i].x(), doctest::Approx(x));
+            CHECK_EQ(points[i].y(), doctest::Approx(y));
+            CHECK_EQ(points[i].z(), doctest::Approx(0.f));
+        }
+    }
+    CHECK_EQ(hits, size_t{10});
+
+    // The winding of the triangle does not matter
+    uint32_t flipped[2];
+    intersect(r.rays,
+              r.origins,
+              a,
+              c,
+              b,
+              ray_hits{flipped, nullptr, nullptr},
+              vertical_rays::count);
+    CHECK_EQ(flipped[0], mask[0]);
+    CHECK_EQ(flipped[1], mask[1]);
+}
+
+TEST_CASE("ray-closest")
+{
+    vertical_rays r;
+    // A large triangle at z = 0, a small one above it at z = 2 and one
+    // behind the ray origins at z = 6
+    point triangles[9] = {{-1.f, -1.f, 0.f},
+                          {9.f, -1.f, 0.f},
+                          {-1.f, 9.f, 0.f},
+                          {0.f, 0.f, 2.f},
+                          {0.f, 2.f, 2.f},
+                          {2.f, 0.f, 2.f},
+                          {-1.f, -1.f, 6.f},
+                          {9.f, -1.f, 6.f},
+                          {-1.f, 9.f, 6.f}};
+
+    float t[vertical_rays::count];
+    point points[vertical_rays::count];
+    uint32_t index[vertical_rays::count];
+    ray_hits out{nullptr, t, points};
+
+    SUBCASE("rays")
+    {
+        intersect_closest(
+            r.rays, r.origins, triangles, 3, out, index, vertical_rays::count);
+        for (size_t i = 0; i != vertical_rays::count; ++i)
+        {
+            float x = r.origins[i].x();
+            float y = r.origins[i].y();
+            if (x > 0.f && y > 0.f && x + y < 2.f)
+            {
+                CHECK_EQ(index[i], 1u);
+                CHECK_EQ(t[i], doctest::Approx(0.3f));
+                CHECK_EQ(points[i].z(), doctest::Approx(2.f));
+            }
+            else if (x + y < 8.f)
+            {
+                CHECK_EQ(index[i], 0u);
+                CHECK_EQ(t[i], doctest::Approx(0.5f));
+                CHECK_EQ(points[i].z(), doctest::Approx(0.f));
+            }
+            else
+            {
+                CHECK_EQ(index[i], 0xffffffffu);
+                CHECK_EQ(t[i], std::numeric_limits<float>::infinity());
+            }
+        }
+    }
+
+    SUBCASE("lines")
+    {
+        // Without origins, the triangle behind the origins is closest
+        intersect_closest(
+            r.rays, nullptr, triangles, 3, out, index, vertical_rays::count);
+        for (size_t i = 0; i != vertical_rays::count; ++i)
+        {
+            float x = r.origins[i].x();
+            float y = r.origins[i].y();
+            CHECK_EQ(index[i], x + y < 8.f ? 2u : 0xffffffffu);
+        }
+    }
+}
@@ -0,0 +1,196 @@
+#include <doctest/doctest.h>
+
+#include "helpers.hpp"
+
+#include <klein/klein.hpp>
+
+using namespace kln;
+
+namespace
+{
+// Root 0 with children 1 and 2, and joint 3 a child of joint 2
+uint16_t const parent_offsets[4] = {0, 1, 2, 1};
+
+motor local_motor(size_t i, float phase)
+{
+    float f = static_cast<float>(i) + phase;
+    return rotor{0.3f * f, 1.f, f, -1.f} * translator{1.f + f, 0.f, 1.f, 0.f};
+}
+} // namespace
+
+TEST_CASE("skeleton-evaluate")
+{
+    motor local[4];
+    for (size_t i = 0; i != 4; ++i)
+    {
+        local[i] = local_motor(i, 0.f);
+    }
+    motor root = translator{2.f, 0.f, 0.f, 1.f} * rotor{0.5f, 0.f, 1.f, 0.f};
+
+    skeleton skel{parent_offsets, nullptr, 4};
+    CHECK(skel.valid());
+
+    motor world[4];
+    pose p{skel, local, world};
+    p.evaluate(root);
+
+    check_motor(world[0], root * local[0]);
+    check_motor(world[1], root * local[0] * local[1]);
+    check_motor(world[2], root * local[0] * local[2]);
+    check_motor(world[3], root * local[0] * local[2] * local[3]);
+
+    // The world position of a joint is its world motor applied to the origin
+    point origin{0.f, 0.f, 0.f};
+    point p3 = world[3](origin);
+    point expected = root(local[0](local[2](local[3](origin))));
+    CHECK_EQ(p3.x(), doctest::Approx(expected.x()));
+    CHECK_EQ(p3.y(), doctest::Approx(expected.y()));
+    CHECK_EQ(p3.z(), doctest::Approx(expected.z()));
+
+    SUBCASE("in-place")
+    {
+        pose q{skel, local, local};
+        q.evaluate(root);
+        for (size_t i = 0; i != 4; ++i)
+        {
+            check_motor(local[i], world[i]);
+        }
+    }
+
+    SUBCASE("invalid")
+    {
+        uint16_t bad[2] = {0, 2};
+        CHECK_FALSE((skeleton{bad, nullptr, 2}.valid()));
+    }
+}
+
+TEST_CASE("skeleton-skinning")
+{
+    // Build the inverse bind pose from a reference pose so that skinning
+    // that same pose yields identity transforms.
+    motor bind_local[4];
+    motor bind_world[4];
+    motor inv_bind[4];
+    for (size_t i = 0; i != 4; ++i)
+    {
+        bind_local[i] = local_motor(i, 0.f);
+    }
+    skeleton{parent_offsets, nullptr, 4}.evaluate(
+        motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f}, bind_local, bind_world);
+    for (size_t i = 0; i != 4; ++i)
+    {
+        inv_bind[i] = ~bind_world[i];
+    }
+    skeleton skel{parent_offsets, inv_bind, 4};
+
+    motor skin[4];
+    pose{skel, bind_local, bind_world}.skinning(skin);
+    for (size_t i = 0; i != 4; ++i)
+    {
+        check_motor(skin[i], motor{1.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f});
+    }
+
+    // Two instances laid out back to back
+    motor local[8];
+    motor world[8];
+    motor roots[2] = {motor{translator{1.f, 0.f, 1.f, 0.f}},
+                      motor{rotor{1.f, 1.f, 0.f, 0.f}}};
+    for (size_t i = 0; i != 4; ++i)
+    {
+        local[i]     = local_motor(i, 0.5f);
+        local[i + 4] = local_motor(i, -0.25f);
+    }
+    evaluate(skel, roots, local, world, 2);
+
+    mat3x4 m34[8];
+    skinning(skel, world, m34, 2);
+    mat4x4 m44[4];
+    pose{skel, local + 4, world + 4}.skinning(m44);
+
+    for (size_t i = 0; i != 8; ++i)
+    {
+        size_t base = i < 4 ? 0 : 4;
+        motor w     = i < 4 ? roots[0] : roots[1];
+        // Walk up to the root explicitly
+        motor chain = local[i];
+        for (size_t j = i - base; parent_offsets[j] != 0;)
+        {
+            j -= parent_offsets[j];
+            chain = local[base + j] * chain;
+        }
+        check_motor(world[i], w * chain);
+
+        mat3x4 m = (world[i] * inv_bind[i - base]).as_mat3x4();
+        for (size_t k = 0; k != 12; ++k)
+        {
+            CHECK_EQ(m34[i].data[k], doctest::Approx(m.data[k]));
+        }
+        if (i >= 4)
+        {
+            mat4x4 m4 = (world[i] * inv_bind[i - base]).as_mat4x4();
+            for (size_t k = 0; k != 16; ++k)
+            {
+                CHECK_EQ(m44[i - 4].data[k], doctest::Approx(m4.data[k]));
+            }
+        }
+    }
+}
+
+TEST_CASE("skeleton-skin-vertices")
+{
+    motor joints[3] = {
+        rotor{0.4f, 1.f, 0.f, 1.f} * translator{1.f, 0.f, 1.f, 0.f},
+        rotor{-1.1f, 0.f, 1.f, 2.f} * translator{2.f, 1.f, 0.f, 1.f},
+        motor{translator{3.f, 0.f, 0.f, 1.f}},
+    };
+    // The same transform as joint 0 with the opposite sign
+    joints[2] = -joints[0];
+
+    uint16_t indices[12] = {0, 1, 0, 0, 1, 0, 0, 0, 0, 2, 0, 0};
+    float weights[12] = {0.7f, 0.3f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.5f, 0.5f,
+                         0.f, 0.f};
+    point positions[3] = {{1.f, 2.f, 3.f}, {-1.f, 0.f, 2.f}, {0.f, 4.f, 1.f}};
+    direction normals[3]
+        = {{0.f, 0.f, 1.f}, {1.f, 1.f, 0.f}, {0.f, 1.f, 0.f}};
+    point out_positions[3];
+    direction out_normals[3];
+    skin(joints, indices, weights, positions, normals, out_positions,
+         out_normals, 3);
+
+    motor expected[3] = {
+        nlerp(joints[0], joints[1], 0.3f),
+        joints[1],
+        joints[0],
+    };
+    for (size_t i = 0; i != 3; ++i)
+    {
+        point p     = expected[i](positions[i]);
+        direction n = expected[i](normals[i]);
+        CHECK_EQ(out_positions[i].x(), doctest::Approx(p.x()));
+        CHECK_EQ(out_positions[i].y(), doctest::Approx(p.y()));
+        CHECK_EQ(out_positions[i].z(), doctest::Approx(p.z()));
+        CHECK_EQ(out_positions[i].w(), doctest::Approx(1.f));
+        CHECK_EQ(out_normals[i].x(), doctest::Approx(n.x()));
+        CHECK_EQ(out_normals[i].y(), doctest::Approx(n.y()));
+        CHECK_EQ(out_normals[i].z(), doctest::Approx(n.z()));
+    }
+
+    // Normals are skipped when either normal buffer is null
+    point skipped[3];
+    skin(joints, indices, weights, positions, normals, skipped, nullptr, 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        CHECK_EQ(skipped[i].x(), doctest::Approx(out_positions[i].x()));
+        CHECK_EQ(skipped[i].y(), doctest::Approx(out_positions[i].y()));
+        CHECK_EQ(skipped[i].z(), doctest::Approx(out_positions[i].z()));
+    }
+
+    // In place, positions only
+    skin(joints, indices, weights, positions, nullptr, positions, nullptr, 3);
+    for (size_t i = 0; i != 3; ++i)
+    {
+        CHECK_EQ(positions[i].x(), doctest::Approx(out_positions[i].x()));
+        CHECK_EQ(positions[i].y(), doctest::Approx(out_positions[i].y()));
+        CHECK_EQ(positions[i].z(), doctest::Approx(out_positions[i].z()));
+    }
+}
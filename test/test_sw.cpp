@@ -232,6 +232,94 @@ TEST_CASE("motor-line-variadic")
     }
 }
 
+TEST_CASE("motor-variadic-remainder")
+{
+    // An odd count exercises both the wide and the remainder code paths
+    motor m{2.f, 4.f, 3.f, -1.f, -5.f, -2.f, 2.f, -3.f};
+    constexpr size_t count = 5;
+
+    SUBCASE("points")
+    {
+        point ps[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            ps[i] = point{-1.f + i, 1.f - 2.f * i, 2.f + 0.5f * i};
+        }
+        point ps2[count];
+        m(ps, ps2, count);
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            point p = m(ps[i]);
+            CHECK_EQ(ps2[i].x(), doctest::Approx(p.x()));
+            CHECK_EQ(ps2[i].y(), doctest::Approx(p.y()));
+            CHECK_EQ(ps2[i].z(), doctest::Approx(p.z()));
+            CHECK_EQ(ps2[i].w(), doctest::Approx(p.w()));
+        }
+    }
+
+    SUBCASE("planes")
+    {
+        plane ps[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            ps[i] = plane{3.f - i, 2.f, 1.f + i, -1.f + 2.f * i};
+        }
+        plane ps2[count];
+        m(ps, ps2, count);
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            plane p = m(ps[i]);
+            CHECK_EQ(ps2[i].x(), doctest::Approx(p.x()));
+            CHECK_EQ(ps2[i].y(), doctest::Approx(p.y()));
+            CHECK_EQ(ps2[i].z(), doctest::Approx(p.z()));
+            CHECK_EQ(ps2[i].d(), doctest::Approx(p.d()));
+        }
+    }
+
+    SUBCASE("lines")
+    {
+        line ls[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            ls[i] = line{-1.f + i, 2.f, -3.f * i, -6.f, 5.f - i, 4.f};
+        }
+        line ls2[count];
+        m(ls, ls2, count);
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            line l = m(ls[i]);
+            CHECK_EQ(ls2[i].e01(), doctest::Approx(l.e01()));
+            CHECK_EQ(ls2[i].e02(), doctest::Approx(l.e02()));
+            CHECK_EQ(ls2[i].e03(), doctest::Approx(l.e03()));
+            CHECK_EQ(ls2[i].e12(), doctest::Approx(l.e12()));
+            CHECK_EQ(ls2[i].e31(), doctest::Approx(l.e31()));
+            CHECK_EQ(ls2[i].e23(), doctest::Approx(l.e23()));
+        }
+    }
+
+    SUBCASE("in-place")
+    {
+        point ps[count];
+        point expected[count];
+        for (size_t i = 0; i != count; ++i)
+        {
+            ps[i]       = point{1.f * i, -2.f, 3.f};
+            expected[i] = m(ps[i]);
+        }
+        m(ps, ps, count);
+
+        for (size_t i = 0; i != count; ++i)
+        {
+            CHECK_EQ(ps[i].x(), doctest::Approx(expected[i].x()));
+            CHECK_EQ(ps[i].y(), doctest::Approx(expected[i].y()));
+            CHECK_EQ(ps[i].z(), doctest::Approx(expected[i].z()));
+        }
+    }
+}
+
 TEST_CASE("motor-origin")
 {
     rotor r{kln::pi * 0.5f, 0, 0, 1.f};
@@ -274,6 +362,86 @@ TEST_CASE("motor-to-matrix-3x4")
     CHECK_EQ(buf[3], 1.f);
 }
 
+TEST_CASE("motor-to-matrix-array")
+{
+    // Seven elements to cover both the four-wide body and the remainder
+    motor motors[7];
+    rotor rotors[7];
+    translator translators[7];
+    for (int i = 0; i != 7; ++i)
+    {
+        float f        = static_cast<float>(i);
+        rotors[i]      = rotor{0.3f + f, 1.f, -f, 2.f};
+        translators[i] = translator{f - 2.f, 1.f, 2.f, -f};
+        motors[i]      = rotors[i] * translators[i];
+    }
+    // Non-normalized motors are still well-defined in 4x4 form
+    motor scaled[7];
+    for (int i = 0; i != 7; ++i)
+    {
+        scaled[i] = motors[i] * (1.f + static_cast<float>(i));
+    }
+
+    auto check = [](mat4x4 const& a, mat4x4 const& b) {
+        for (int j = 0; j != 16; ++j)
+        {
+            CHECK_EQ(a.data[j], doctest::Approx(b.data[j]));
+        }
+    };
+
+    mat3x4 m34[7];
+    mat4x4 m44[7];
+
+    SUBCASE("motor")
+    {
+        to_mat3x4(motors, m34, 7);
+        to_mat4x4(scaled, m44, 7);
+        for (int i = 0; i != 7; ++i)
+        {
+            mat3x4 expected = motors[i].as_mat3x4();
+            for (int j = 0; j != 16; ++j)
+            {
+                CHECK_EQ(m34[i].data[j], doctest::Approx(expected.data[j]));
+            }
+            check(m44[i], scaled[i].as_mat4x4());
+        }
+    }
+
+    SUBCASE("motor-stream")
+    {
+        stream_mat4x4(scaled, m44, 7);
+        for (int i = 0; i != 7; ++i)
+        {
+            check(m44[i], scaled[i].as_mat4x4());
+        }
+    }
+
+    SUBCASE("rotor")
+    {
+        stream_mat4x4(rotors, m44, 7);
+        for (int i = 0; i != 7; ++i)
+        {
+            check(m44[i], rotors[i].as_mat4x4());
+        }
+    }
+
+    SUBCASE("translator")
+    {
+        to_mat4x4(translators, m44, 7);
+        for (int i = 0; i != 7; ++i)
+        {
+            point expected = translators[i](point{1.f, -2.f, 3.f});
+            float buf[4];
+            _mm_storeu_ps(buf, m44[i](_mm_set_ps(1.f, 3.f, -2.f, 1.f)));
+            CHECK_EQ(buf[0], doctest::Approx(expected.x()));
+            CHECK_EQ(buf[1], doctest::Approx(expected.y()));
+            CHECK_EQ(buf[2], doctest::Approx(expected.z()));
+            CHECK_EQ(buf[3], 1.f);
+            check(m44[i], translators[i].as_mat4x4());
+        }
+    }
+}
+
 TEST_CASE("normalize-motor")
 {
     motor m{1.f, 4.f, 3.f, 2.f, 5.f, 6.f, 7.f, 8.f};